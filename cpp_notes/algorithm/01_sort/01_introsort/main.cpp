@@ -0,0 +1,169 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 内省排序 (introsort) 要点
+// =====================================================
+// 1. 枢轴: 小区间三数取中，大区间 ninther（三组三数取中再取中）
+// 2. 递归深度超过 2*log2(n) 时转堆排序，最坏 O(n log n)
+// 3. 长度 <= 16 的区间留给最后一趟插入排序
+// 4. 只递归较短一侧，较长一侧用循环处理，栈深度 O(log n)
+// =====================================================
+
+using data_t = mystl::vector<std::uint64_t>;
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// ---- 各种输入分布 ----
+data_t make_random(size_t n)
+{
+    std::mt19937_64 rng(42);
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(rng());
+    return v;
+}
+
+data_t make_sorted(size_t n)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(i);
+    return v;
+}
+
+data_t make_reversed(size_t n)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(n - i);
+    return v;
+}
+
+// 先升后降的 "管风琴" 形状
+data_t make_organ_pipe(size_t n)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n / 2; ++i) v.push_back(i);
+    for (size_t i = n / 2; i < n; ++i) v.push_back(n - i);
+    return v;
+}
+
+// 只有 16 种不同取值
+data_t make_few_unique(size_t n)
+{
+    std::mt19937_64 rng(7);
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(rng() % 16);
+    return v;
+}
+
+template <typename Sorter>
+double bench(const data_t& input, Sorter sorter, int repeat = 3)
+{
+    data_t work;
+    double ms = best_of_ms(repeat,
+        [&] { work = input; },
+        [&] { sorter(work.begin(), work.end()); });
+    if (!std::is_sorted(work.begin(), work.end())) {
+        std::cerr << "结果未排序!" << std::endl;
+        std::exit(1);
+    }
+    return ms;
+}
+
+// =====================================================
+// 测试01: 正确性 - 与 std::sort 结果对比
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::mt19937 rng(1);
+    for (size_t n : {0, 1, 2, 3, 15, 16, 17, 100, 129, 1000, 10000}) {
+        std::vector<int> ref(n);
+        for (auto& x : ref) x = static_cast<int>(rng() % 50);
+        mystl::vector<int> v;
+        for (int x : ref) v.push_back(x);
+
+        std::sort(ref.begin(), ref.end(), std::greater<>());
+        mystl::sort(v.begin(), v.end(), std::greater<>());
+        bool ok = std::equal(ref.begin(), ref.end(), v.begin());
+        std::cout << "n = " << std::setw(5) << n << (ok ? "  OK" : "  FAILED") << std::endl;
+    }
+}
+
+// =====================================================
+// 测试02: 各种分布下与 std::sort / quick_sort 对比
+// =====================================================
+void test02_distributions(size_t n)
+{
+    printSeparator("测试02: 各种输入分布 (n = " + std::to_string(n) + ")");
+
+    struct Case { const char* name; data_t data; };
+    Case cases[] = {
+        {"random",      make_random(n)},
+        {"sorted",      make_sorted(n)},
+        {"reversed",    make_reversed(n)},
+        {"organ_pipe",  make_organ_pipe(n)},
+        {"few_unique",  make_few_unique(n)},
+    };
+
+    auto std_sort   = [](auto f, auto l) { std::sort(f, l); };
+    auto my_sort    = [](auto f, auto l) { mystl::sort(f, l); };
+    auto quick_sort = [](auto f, auto l) { mystl::quick_sort(f, l); };
+
+    std::cout << std::left << std::setw(12) << "input"
+              << std::right << std::setw(14) << "std::sort"
+              << std::setw(14) << "mystl::sort"
+              << std::setw(14) << "quick_sort" << "   (ms)" << std::endl;
+
+    for (auto& c : cases) {
+        std::cout << std::left << std::setw(12) << c.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << bench(c.data, std_sort)
+                  << std::setw(14) << bench(c.data, my_sort);
+        // quick_sort 在有序输入上是 O(n^2) 且递归深度 O(n)，只在随机输入上对比
+        if (std::string(c.name) == "random")
+            std::cout << std::setw(14) << bench(c.data, quick_sort);
+        else
+            std::cout << std::setw(14) << "-";
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_correctness();
+    test02_distributions(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 1000000):
+
+========== 测试02: 各种输入分布 (n = 1000000) ==========
+
+input            std::sort   mystl::sort    quick_sort   (ms)
+random               85.64         92.99        100.48
+sorted               13.48          9.52             -
+reversed              7.85          8.15             -
+organ_pipe          103.66         32.23             -
+few_unique           36.78         41.23             -
+*/
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// LSD 基数排序要点
+// =====================================================
+// 1. 一趟遍历同时统计每个字节的 256 桶直方图
+// 2. 从最低字节到最高字节做稳定的计数分发，每趟 O(n)，与数据分布无关
+// 3. 所有 key 在某字节上相同时跳过这一趟（例如高位全 0 的小整数）
+// 4. 有符号整数翻转符号位；浮点数负数取反、正数翻转符号位，得到保序的无符号 key
+// 5. 分发时预取直方图指向的目标位置，掩盖随机写的缓存缺失
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+struct Record
+{
+    std::uint64_t id;
+    std::int32_t score;
+    std::uint32_t payload;
+};
+
+template <typename Tp, typename Gen>
+mystl::vector<Tp> make_data(size_t n, Gen gen)
+{
+    mystl::vector<Tp> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(gen());
+    return v;
+}
+
+template <typename Tp, typename Sorter, typename Check>
+double bench(const mystl::vector<Tp>& input, Sorter sorter, Check check, int repeat = 3)
+{
+    mystl::vector<Tp> work;
+    double ms = best_of_ms(repeat,
+        [&] { work = input; },
+        [&] { sorter(work.begin(), work.end()); });
+    if (!check(work)) {
+        std::cerr << "结果未排序!" << std::endl;
+        std::exit(1);
+    }
+    return ms;
+}
+
+template <typename Tp, typename Check>
+void bench_row(const char* name, const mystl::vector<Tp>& data, Check check)
+{
+    double t_std   = bench(data, [](auto f, auto l) { std::sort(f, l); }, check);
+    double t_my    = bench(data, [](auto f, auto l) { mystl::sort(f, l); }, check);
+    double t_radix = bench(data, [](auto f, auto l) { mystl::radix_sort(f, l); }, check);
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << t_std << std::setw(14) << t_my << std::setw(12) << t_radix
+              << std::setw(10) << t_my / t_radix << "x" << std::endl;
+}
+
+// =====================================================
+// 测试01: 正确性 - 有符号 / 浮点 / 稳定性
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::mt19937_64 rng(1);
+    bool ok = true;
+
+    for (size_t n : {0, 1, 255, 256, 1000, 100000}) {
+        std::vector<std::int32_t> ref(n);
+        for (auto& x : ref) x = static_cast<std::int32_t>(rng());
+        mystl::vector<std::int32_t> v;
+        for (auto x : ref) v.push_back(x);
+        std::sort(ref.begin(), ref.end());
+        mystl::radix_sort(v.begin(), v.end());
+        ok = ok && std::equal(ref.begin(), ref.end(), v.begin());
+    }
+    std::cout << "int32  : " << (ok ? "OK" : "FAILED") << std::endl;
+
+    std::vector<double> d = {3.5, -0.0, 0.0, -1e300, 1e-300, -2.25, 7.0, -7.0};
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 1000; ++i) d.push_back(dist(rng));
+    std::vector<double> dref = d;
+    std::sort(dref.begin(), dref.end());
+    mystl::radix_sort(d.begin(), d.end());
+    std::cout << "double : " << (d == dref ? "OK" : "FAILED") << std::endl;
+
+    // 按 score 排序，score 相同时应保持 id 的原始顺序
+    mystl::vector<Record> recs;
+    for (std::uint64_t i = 0; i < 5000; ++i)
+        recs.push_back({i, static_cast<std::int32_t>(rng() % 100) - 50, 0});
+    mystl::radix_sort(recs.begin(), recs.end(), [](const Record& r) { return r.score; });
+    bool stable = std::is_sorted(recs.begin(), recs.end(), [](const Record& a, const Record& b) {
+        return a.score < b.score || (a.score == b.score && a.id < b.id);
+    });
+    std::cout << "record : " << (stable ? "OK (stable)" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: 与比较排序对比
+// =====================================================
+void test02_speed(size_t n)
+{
+    printSeparator("测试02: 与比较排序对比 (n = " + std::to_string(n) + ")");
+
+    std::mt19937_64 rng(42);
+    auto is_sorted = [](const auto& v) { return std::is_sorted(v.begin(), v.end()); };
+
+    std::cout << std::left << std::setw(16) << "input" << std::right
+              << std::setw(12) << "std::sort" << std::setw(14) << "mystl::sort"
+              << std::setw(12) << "radix_sort" << std::setw(11) << "speedup" << "   (ms)" << std::endl;
+
+    bench_row("uint64 random", make_data<std::uint64_t>(n, [&] { return rng(); }), is_sorted);
+    bench_row("uint64 < 2^20", make_data<std::uint64_t>(n, [&] { return rng() & 0xfffff; }), is_sorted);
+    bench_row("int32 random", make_data<std::int32_t>(n, [&] { return static_cast<std::int32_t>(rng()); }), is_sorted);
+    std::normal_distribution<double> normal(0.0, 1000.0);
+    bench_row("double normal", make_data<double>(n, [&] { return normal(rng); }), is_sorted);
+
+    // 按整数字段排序记录
+    auto recs = make_data<Record>(n, [&] { return Record{rng(), static_cast<std::int32_t>(rng()), 0}; });
+    auto by_id = [](const Record& a, const Record& b) { return a.id < b.id; };
+    auto check = [&](const mystl::vector<Record>& v) { return std::is_sorted(v.begin(), v.end(), by_id); };
+    double t_std   = bench(recs, [&](auto f, auto l) { std::sort(f, l, by_id); }, check);
+    double t_my    = bench(recs, [&](auto f, auto l) { mystl::sort(f, l, by_id); }, check);
+    double t_radix = bench(recs, [](auto f, auto l) {
+        mystl::radix_sort(f, l, [](const Record& r) { return r.id; });
+    }, check);
+    std::cout << std::left << std::setw(16) << "record by id" << std::right
+              << std::setw(12) << t_std << std::setw(14) << t_my << std::setw(12) << t_radix
+              << std::setw(10) << t_my / t_radix << "x" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    test01_correctness();
+    test02_speed(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 10000000):
+
+========== 测试02: 与比较排序对比 (n = 10000000) ==========
+
+input              std::sort   mystl::sort  radix_sort    speedup   (ms)
+uint64 random        1241.87       1302.98      512.04      2.54x
+uint64 < 2^20        1205.97       1314.83      227.72      5.77x
+int32 random         1217.17       1290.90      186.41      6.93x
+double normal        1298.97       1413.43      423.03      3.34x
+record by id         1148.23       1224.96      702.41      1.74x
+
+uint64 < 2^20 只需要 3 趟（高 5 个字节全为 0 被跳过）。
+关闭预取时 uint64 random 约 750ms，预取带来约 1.5 倍提升。
+*/
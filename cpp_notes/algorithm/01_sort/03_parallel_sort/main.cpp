@@ -0,0 +1,125 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "mystl/algorithm.h"
+#include "mystl/thread_pool.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 并行归并排序要点
+// =====================================================
+// 1. 递归二分，两半作为 fork-join 任务交给工作窃取线程池
+// 2. 长度不超过 cutoff 的叶子直接用串行 mystl::sort
+// 3. 归并也并行：把输出切成若干块，每块用 co-rank 二分
+//    找到两段输入对应的起止位置，各块互不依赖
+// 4. 结果在原数组和缓冲区之间交替存放，每层只移动一次
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+struct Record
+{
+    std::uint64_t key;
+    std::uint64_t payload[3];
+};
+
+// =====================================================
+// 测试01: 正确性
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::mt19937_64 rng(1);
+    mystl::thread_pool pool(4);
+    for (size_t n : {0, 1, 100, 5000, 100000, 1000003}) {
+        mystl::vector<std::uint64_t> v;
+        for (size_t i = 0; i < n; ++i) v.push_back(rng() % 1000);
+        // 用很小的 cutoff 强制多层递归和并行归并
+        mystl::parallel_sort(pool, v.begin(), v.end(), std::less<>(), 64);
+        std::cout << "n = " << std::setw(8) << n
+                  << (std::is_sorted(v.begin(), v.end()) ? "  OK" : "  FAILED") << std::endl;
+    }
+}
+
+// =====================================================
+// 测试02: 线程数扩展性
+// =====================================================
+template <typename Tp, typename Compare>
+void scaling(const char* name, const mystl::vector<Tp>& input, Compare comp)
+{
+    mystl::vector<Tp> work;
+    double base = best_of_ms(3, [&] { work = input; }, [&] { mystl::sort(work.begin(), work.end(), comp); });
+    std::cout << name << "  mystl::sort: " << std::fixed << std::setprecision(1) << base << " ms" << std::endl;
+
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        mystl::thread_pool pool(threads);
+        double ms = best_of_ms(3, [&] { work = input; }, [&] {
+            mystl::parallel_sort(pool, work.begin(), work.end(), comp);
+        });
+        if (!std::is_sorted(work.begin(), work.end(), comp)) {
+            std::cerr << "结果未排序!" << std::endl;
+            std::exit(1);
+        }
+        std::cout << "  threads = " << std::setw(2) << threads << ": " << std::setw(8) << ms
+                  << " ms  speedup " << std::setprecision(2) << base / ms << "x" << std::setprecision(1) << std::endl;
+    }
+}
+
+void test02_scaling(size_t n)
+{
+    printSeparator("测试02: 扩展性 (n = " + std::to_string(n) + ", 硬件线程 = "
+                   + std::to_string(std::thread::hardware_concurrency()) + ")");
+
+    std::mt19937_64 rng(42);
+    mystl::vector<std::uint64_t> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) keys.push_back(rng());
+    scaling("uint64 ", keys, std::less<>());
+
+    mystl::vector<Record> recs;
+    recs.reserve(n);
+    for (size_t i = 0; i < n; ++i) recs.push_back({rng(), {i, i, i}});
+    scaling("record ", recs, [](const Record& a, const Record& b) { return a.key < b.key; });
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    test01_correctness();
+    test02_scaling(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 10000000, 只有 1 个硬件线程的容器):
+
+========== 测试02: 扩展性 (n = 10000000, 硬件线程 = 1) ==========
+
+uint64   mystl::sort: 1388.5 ms
+  threads =  1:   1421.5 ms  speedup 0.98x
+  threads =  2:   1379.1 ms  speedup 1.01x
+  threads =  4:   1276.4 ms  speedup 1.09x
+  threads =  8:   1412.4 ms  speedup 0.98x
+  threads = 16:   1345.4 ms  speedup 1.03x
+record   mystl::sort: 1295.4 ms
+  threads =  1:   1251.5 ms  speedup 1.04x
+  threads =  2:   1668.0 ms  speedup 0.78x
+  threads =  4:   1944.1 ms  speedup 0.67x
+  threads =  8:   1959.1 ms  speedup 0.66x
+  threads = 16:   1869.6 ms  speedup 0.69x
+
+单核机器上多线程只能体现调度和归并的额外开销（record 每层多搬 32 字节），
+多核机器上请重新运行以得到真实的扩展曲线。
+*/
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// TimSort 要点
+// =====================================================
+// 1. 从左到右识别自然有序段 (run)，严格递减的段原地翻转
+// 2. 短于 min_run 的段用二分插入排序补齐
+// 3. run 入栈后按不变式 len[i-2] > len[i-1] + len[i], len[i-1] > len[i] 合并，
+//    保证合并是平衡的
+// 4. 合并前先用 gallop 跳过已经就位的前缀/后缀，只把较短的一段移到缓冲区
+// 5. 一方连续胜出 min_gallop 次后切到 galloping 模式，成批输出
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+struct Event
+{
+    std::uint32_t key;
+    std::uint32_t seq; // 原始顺序，用来检查稳定性
+};
+
+// 作为对照的朴素自顶向下归并排序
+template <typename Tp, typename Compare>
+void merge_sort_aux(Tp* a, Tp* buf, std::ptrdiff_t n, Compare comp)
+{
+    if (n < 2) return;
+    std::ptrdiff_t mid = n / 2;
+    merge_sort_aux(a, buf, mid, comp);
+    merge_sort_aux(a + mid, buf, n - mid, comp);
+    std::ptrdiff_t i = 0, j = mid, k = 0;
+    while (i < mid && j < n) buf[k++] = comp(a[j], a[i]) ? a[j++] : a[i++];
+    while (i < mid) buf[k++] = a[i++];
+    while (j < n) buf[k++] = a[j++];
+    std::copy(buf, buf + n, a);
+}
+
+template <typename Tp, typename Compare>
+void merge_sort(Tp* first, Tp* last, Compare comp)
+{
+    std::unique_ptr<Tp[]> buf(new Tp[last - first]);
+    merge_sort_aux(first, buf.get(), last - first, comp);
+}
+
+// ---- 输入分布 ----
+using data_t = mystl::vector<std::uint64_t>;
+
+data_t make_random(size_t n, std::mt19937_64& rng)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(rng());
+    return v;
+}
+
+// 基本有序：每 1000 个元素里有一个 "掉队者" 被换到随机位置
+data_t make_nearly_sorted(size_t n, std::mt19937_64& rng)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(i);
+    for (size_t i = 0; i < n / 1000; ++i) std::swap(v[rng() % n], v[rng() % n]);
+    return v;
+}
+
+// 由若干个有序段拼接而成
+data_t make_runs(size_t n, std::mt19937_64& rng)
+{
+    data_t v = make_random(n, rng);
+    const size_t run = 10000;
+    for (size_t i = 0; i < n; i += run)
+        std::sort(v.begin() + i, v.begin() + std::min(n, i + run));
+    return v;
+}
+
+data_t make_reversed(size_t n)
+{
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.push_back(n - i);
+    return v;
+}
+
+// =====================================================
+// 测试01: 正确性与稳定性 - 与 std::stable_sort 逐元素对比
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性与稳定性");
+
+    std::mt19937 rng(1);
+    auto by_key = [](const Event& a, const Event& b) { return a.key < b.key; };
+    bool ok = true;
+    for (int round = 0; round < 200; ++round) {
+        size_t n = rng() % 5000;
+        std::uint32_t range = 1 + rng() % (round % 2 ? 10 : 100000); // 大量重复值会触发 galloping
+        std::vector<Event> ref(n);
+        for (size_t i = 0; i < n; ++i) ref[i] = {static_cast<std::uint32_t>(rng() % range), static_cast<std::uint32_t>(i)};
+        // 一半的轮次做成部分有序
+        if (round % 4 < 2) std::sort(ref.begin(), ref.begin() + n / 2, by_key);
+
+        mystl::vector<Event> v;
+        for (const auto& e : ref) v.push_back(e);
+        std::stable_sort(ref.begin(), ref.end(), by_key);
+        mystl::stable_sort(v.begin(), v.end(), by_key, v.get_allocator());
+        for (size_t i = 0; i < n; ++i)
+            ok = ok && ref[i].key == v[i].key && ref[i].seq == v[i].seq;
+    }
+    std::cout << "200 轮随机对比: " << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: 不同输入下的耗时
+// =====================================================
+void test02_speed(size_t n)
+{
+    printSeparator("测试02: 耗时 (n = " + std::to_string(n) + ")");
+
+    std::mt19937_64 rng(42);
+    struct Case { const char* name; data_t data; };
+    Case cases[] = {
+        {"random",        make_random(n, rng)},
+        {"nearly_sorted", make_nearly_sorted(n, rng)},
+        {"runs_10k",      make_runs(n, rng)},
+        {"reversed",      make_reversed(n)},
+    };
+
+    std::cout << std::left << std::setw(15) << "input" << std::right
+              << std::setw(12) << "merge_sort" << std::setw(18) << "std::stable_sort"
+              << std::setw(20) << "mystl::stable_sort" << "   (ms)" << std::endl;
+
+    for (auto& c : cases) {
+        data_t work;
+        auto run = [&](auto sorter) {
+            double ms = best_of_ms(3, [&] { work = c.data; }, [&] { sorter(work.begin(), work.end()); });
+            if (!std::is_sorted(work.begin(), work.end())) {
+                std::cerr << "结果未排序!" << std::endl;
+                std::exit(1);
+            }
+            return ms;
+        };
+        double t_merge  = run([](auto f, auto l) { merge_sort(f, l, std::less<>()); });
+        double t_std    = run([](auto f, auto l) { std::stable_sort(f, l); });
+        double t_mystl  = run([](auto f, auto l) { mystl::stable_sort(f, l); });
+        std::cout << std::left << std::setw(15) << c.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << t_merge << std::setw(18) << t_std << std::setw(20) << t_mystl << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_correctness();
+    test02_speed(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 1000000):
+
+========== 测试02: 耗时 (n = 1000000) ==========
+
+input            merge_sort  std::stable_sort  mystl::stable_sort   (ms)
+random               127.19            112.51              134.36
+nearly_sorted         32.48             19.99                6.43
+runs_10k              76.06             59.39               50.07
+reversed              41.05             25.54                1.32
+
+随机输入比朴素归并慢约 5%，基本有序 / 逆序输入接近一次线性扫描。
+*/
@@ -0,0 +1,172 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// pdqsort 要点
+// =====================================================
+// 1. 块划分: 左右各扫描 64 个元素，只记录 "放错边" 元素的偏移量
+//    (offsets[num] = i; num += !comp(x, pivot))，扫描过程没有依赖数据的分支
+// 2. 划分时一次交换都没有发生 -> 尝试有限步数的插入排序，有序输入 O(n)
+// 3. 枢轴等于左邻区间最大值 -> 反向划分，一次排除所有相等元素，重复值多时 O(n)
+// 4. 划分极不平衡 -> 交换几个固定位置打破模式；次数用完转堆排序
+// =====================================================
+
+using data_t = mystl::vector<std::uint64_t>;
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+data_t make_data(size_t n, const std::string& kind)
+{
+    std::mt19937_64 rng(42);
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (kind == "random") v.push_back(rng());
+        else if (kind == "sorted") v.push_back(i);
+        else if (kind == "reversed") v.push_back(n - i);
+        else if (kind == "organ_pipe") v.push_back(i < n / 2 ? i : n - i);
+        else if (kind == "few_unique") v.push_back(rng() % 16);
+        else if (kind == "sorted_tail") v.push_back(i < n - n / 100 ? i : rng()); // 有序 + 末尾 1% 随机
+        else v.push_back(i % 1000);                                                  // sawtooth
+    }
+    return v;
+}
+
+template <typename Sorter>
+double bench(const data_t& input, Sorter sorter, int repeat = 3)
+{
+    data_t work;
+    double ms = best_of_ms(repeat, [&] { work = input; }, [&] { sorter(work.begin(), work.end()); });
+    if (!std::is_sorted(work.begin(), work.end())) {
+        std::cerr << "结果未排序!" << std::endl;
+        std::exit(1);
+    }
+    return ms;
+}
+
+// =====================================================
+// 测试01: 正确性 - pdq_sort 与 partition
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::mt19937 rng(1);
+    bool sort_ok = true, part_ok = true, struct_ok = true;
+    for (int round = 0; round < 300; ++round) {
+        size_t n = rng() % 3000;
+        int range = 1 + static_cast<int>(rng() % (round % 3 ? 100000 : 8));
+        std::vector<int> ref(n);
+        for (auto& x : ref) x = static_cast<int>(rng() % range);
+
+        // 算术类型 + std::less，走无分支划分
+        std::vector<int> a = ref;
+        mystl::pdq_sort(a.begin(), a.end());
+        std::vector<int> b = ref;
+        std::sort(b.begin(), b.end());
+        sort_ok = sort_ok && a == b;
+
+        // 自定义比较器，走普通划分
+        std::vector<std::string> s;
+        for (int x : ref) s.push_back(std::to_string(x));
+        std::vector<std::string> t = s;
+        mystl::pdq_sort(s.begin(), s.end(), [](const std::string& l, const std::string& r) { return l < r; });
+        std::sort(t.begin(), t.end());
+        struct_ok = struct_ok && s == t;
+
+        // 单独使用 partition
+        std::vector<int> p = ref;
+        int threshold = range / 2;
+        auto mid = mystl::partition(p.begin(), p.end(), [threshold](int x) { return x < threshold; });
+        part_ok = part_ok
+            && std::all_of(p.begin(), mid, [threshold](int x) { return x < threshold; })
+            && std::none_of(mid, p.end(), [threshold](int x) { return x < threshold; })
+            && std::is_permutation(p.begin(), p.end(), ref.begin());
+    }
+    std::cout << "pdq_sort (int)    : " << (sort_ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "pdq_sort (string) : " << (struct_ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "partition         : " << (part_ok ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: 各种输入分布
+// =====================================================
+void test02_distributions(size_t n)
+{
+    printSeparator("测试02: 各种输入分布 (n = " + std::to_string(n) + ")");
+
+    std::cout << std::left << std::setw(13) << "input" << std::right
+              << std::setw(12) << "std::sort" << std::setw(14) << "mystl::sort"
+              << std::setw(12) << "pdq_sort" << "   (ms)" << std::endl;
+
+    for (const char* kind : {"random", "sorted", "reversed", "organ_pipe", "few_unique", "sorted_tail", "sawtooth"}) {
+        data_t data = make_data(n, kind);
+        std::cout << std::left << std::setw(13) << kind << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << bench(data, [](auto f, auto l) { std::sort(f, l); })
+                  << std::setw(14) << bench(data, [](auto f, auto l) { mystl::sort(f, l); })
+                  << std::setw(12) << bench(data, [](auto f, auto l) { mystl::pdq_sort(f, l); })
+                  << std::endl;
+    }
+}
+
+// =====================================================
+// 测试03: partition 单独对比
+// =====================================================
+void test03_partition(size_t n)
+{
+    printSeparator("测试03: partition (n = " + std::to_string(n) + ", 约一半元素满足谓词)");
+
+    data_t data = make_data(n, "random");
+    const std::uint64_t half = static_cast<std::uint64_t>(-1) / 2;
+    auto pred = [half](std::uint64_t x) { return x < half; };
+
+    data_t work;
+    double t_std = best_of_ms(5, [&] { work = data; }, [&] { do_not_optimize(std::partition(work.begin(), work.end(), pred)); });
+    double t_my  = best_of_ms(5, [&] { work = data; }, [&] { do_not_optimize(mystl::partition(work.begin(), work.end(), pred)); });
+    std::cout << std::fixed << std::setprecision(2)
+              << "std::partition   : " << t_std << " ms\n"
+              << "mystl::partition : " << t_my << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_correctness();
+    test02_distributions(n);
+    test03_partition(n * 10);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 1000000):
+
+========== 测试02: 各种输入分布 (n = 1000000) ==========
+
+input           std::sort   mystl::sort    pdq_sort   (ms)
+random              84.58         99.60       37.68
+sorted              18.37         16.11        1.22
+reversed             8.65          9.57        1.77
+organ_pipe         105.30         27.43       37.57
+few_unique          31.13         34.97        6.96
+sorted_tail         15.93         11.30        3.90
+sawtooth            30.24         30.67       13.03
+
+========== 测试03: partition (n = 10000000, 约一半元素满足谓词) ==========
+
+std::partition   : 57.43 ms
+mystl::partition : 12.69 ms
+*/
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// SIMD 排序网络要点
+// =====================================================
+// 1. 双调排序网络: 比较交换的位置与数据无关，可以用向量 min / max 一次处理 4 ~ 8 对
+// 2. 跨寄存器的比较交换就是两个寄存器的 min / max；寄存器内用 permute + blend
+// 3. 长度补齐到 2 的幂，填充类型最大值（浮点用 +inf），排序后只拷回前 n 个
+// 4. 运行时检测 CPU：有 AVX2 用 256 位寄存器，否则用 SSE2 (x86-64 必有)
+// 5. sort / pdq_sort 对 "指针 + 4/8 字节整数或浮点 + std::less/greater" 自动用它排叶子区间
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+template <typename Tp>
+mystl::vector<Tp> make_random(size_t n, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    mystl::vector<Tp> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (std::is_floating_point<Tp>::value) v.push_back(static_cast<Tp>(static_cast<std::int64_t>(rng() % 2000000) - 1000000) / 7);
+        else v.push_back(static_cast<Tp>(rng()));
+    }
+    return v;
+}
+
+// =====================================================
+// 测试01: 正确性 - 各类型、各长度、升序 / 降序
+// =====================================================
+template <typename Tp>
+bool check_type(std::mt19937_64& rng)
+{
+    for (size_t n = 0; n <= 300; ++n) {
+        mystl::vector<Tp> a = make_random<Tp>(n, rng());
+        if (n % 3 == 0) for (auto& x : a) x = static_cast<Tp>(rng() % 8); // 大量重复值
+        std::vector<Tp> ref(a.begin(), a.end());
+
+        mystl::vector<Tp> b = a;
+        std::sort(ref.begin(), ref.end());
+        mystl::small_sort(b.begin(), b.end());
+        if (!std::equal(ref.begin(), ref.end(), b.begin())) return false;
+        b = a;
+        mystl::sort(b.begin(), b.end());
+        if (!std::equal(ref.begin(), ref.end(), b.begin())) return false;
+
+        std::sort(ref.begin(), ref.end(), std::greater<>());
+        b = a;
+        mystl::small_sort(b.begin(), b.end(), std::greater<>());
+        if (!std::equal(ref.begin(), ref.end(), b.begin())) return false;
+        b = a;
+        mystl::pdq_sort(b.begin(), b.end(), std::greater<Tp>());
+        if (!std::equal(ref.begin(), ref.end(), b.begin())) return false;
+    }
+    return true;
+}
+
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::cout << "AVX2: " << (mystl::detail::cpu_has_avx2() ? "yes" : "no") << std::endl;
+    std::mt19937_64 rng(1);
+    std::cout << "int32  : " << (check_type<std::int32_t>(rng) ? "OK" : "FAILED") << std::endl;
+    std::cout << "uint32 : " << (check_type<std::uint32_t>(rng) ? "OK" : "FAILED") << std::endl;
+    std::cout << "float  : " << (check_type<float>(rng) ? "OK" : "FAILED") << std::endl;
+    std::cout << "int64  : " << (check_type<std::int64_t>(rng) ? "OK" : "FAILED") << std::endl;
+    std::cout << "double : " << (check_type<double>(rng) ? "OK" : "FAILED") << std::endl;
+
+    // NaN 不满足严格弱序，但结果至少要是输入的一个排列
+    mystl::vector<double> v = make_random<double>(20, 5);
+    v[3] = v[11] = std::numeric_limits<double>::quiet_NaN();
+    mystl::sort(v.begin(), v.end());
+    size_t nan_count = std::count_if(v.begin(), v.end(), [](double x) { return x != x; });
+    std::cout << "NaN    : " << (nan_count == 2 ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: 小数组 - 插入排序 vs SSE2 / AVX2 排序网络 vs std::sort
+// =====================================================
+// 把 total 个元素切成长度为 n 的小数组逐个排序，报告每个小数组的平均耗时
+template <typename Tp, typename Sorter>
+double bench_small(const mystl::vector<Tp>& input, size_t n, Sorter sorter)
+{
+    mystl::vector<Tp> work;
+    double ms = best_of_ms(5, [&] { work = input; }, [&] {
+        for (size_t i = 0; i + n <= work.size(); i += n) sorter(work.data() + i, work.data() + i + n);
+    });
+    for (size_t i = 0; i + n <= work.size(); i += n) {
+        if (!std::is_sorted(work.data() + i, work.data() + i + n)) {
+            std::cerr << "结果未排序!" << std::endl;
+            std::exit(1);
+        }
+    }
+    return ms * 1e6 / static_cast<double>(input.size() / n);
+}
+
+template <typename Tp>
+void bench_type(const char* name, size_t total)
+{
+    using ops = mystl::detail::simd_sort_ops<Tp>;
+    std::cout << name << std::endl;
+    std::cout << std::right << std::setw(6) << "n" << std::setw(12) << "insertion" << std::setw(10) << "sse2"
+              << std::setw(10) << "avx2" << std::setw(12) << "std::sort" << std::setw(14) << "small_sort" << "   (ns / 数组)" << std::endl;
+
+    for (size_t n : {4, 8, 16, 32, 64, 128}) {
+        mystl::vector<Tp> data = make_random<Tp>(total / n * n, n);
+        std::cout << std::setw(6) << n << std::fixed << std::setprecision(1)
+                  << std::setw(12) << bench_small(data, n, [](Tp* f, Tp* l) { mystl::insertion_sort(f, l); });
+        if (n <= mystl::detail::simd_sort_capacity<Tp>()) {
+            std::cout << std::setw(10) << bench_small(data, n, [](Tp* f, Tp* l) {
+                mystl::detail::simd_sse2::small_sort<typename ops::sse2>(f, static_cast<size_t>(l - f), false); });
+            if (mystl::detail::cpu_has_avx2())
+                std::cout << std::setw(10) << bench_small(data, n, [](Tp* f, Tp* l) {
+                    mystl::detail::simd_avx2::small_sort<typename ops::avx2>(f, static_cast<size_t>(l - f), false); });
+            else
+                std::cout << std::setw(10) << "-";
+        } else {
+            std::cout << std::setw(10) << "-" << std::setw(10) << "-";
+        }
+        std::cout << std::setw(12) << bench_small(data, n, [](Tp* f, Tp* l) { std::sort(f, l); })
+                  << std::setw(14) << bench_small(data, n, [](Tp* f, Tp* l) { mystl::small_sort(f, l); })
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+void test02_small_arrays(size_t total)
+{
+    printSeparator("测试02: 小数组排序 (共 " + std::to_string(total) + " 个元素)");
+
+    bench_type<std::int32_t>("int32", total);
+    bench_type<std::uint32_t>("uint32", total);
+    bench_type<float>("float", total);
+    bench_type<std::int64_t>("int64", total);
+    bench_type<double>("double", total);
+}
+
+// =====================================================
+// 测试03: 作为 sort / pdq_sort 的叶子
+// =====================================================
+// 自定义 lambda 比较器不会触发 SIMD 叶子，用来对照
+template <typename Tp>
+void bench_leaf(const char* name, size_t n)
+{
+    mystl::vector<Tp> data = make_random<Tp>(n, 99);
+    mystl::vector<Tp> work;
+    auto run = [&](auto sorter) {
+        return best_of_ms(3, [&] { work = data; }, [&] { sorter(work.data(), work.data() + work.size()); });
+    };
+    auto lambda_less = [](const Tp& a, const Tp& b) { return a < b; };
+
+    std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << run([](Tp* f, Tp* l) { std::sort(f, l); })
+              << std::setw(14) << run([&](Tp* f, Tp* l) { mystl::sort(f, l, lambda_less); })
+              << std::setw(12) << run([](Tp* f, Tp* l) { mystl::sort(f, l); })
+              << std::setw(14) << run([&](Tp* f, Tp* l) { mystl::pdq_sort(f, l, lambda_less); })
+              << std::setw(12) << run([](Tp* f, Tp* l) { mystl::pdq_sort(f, l); })
+              << std::endl;
+}
+
+void test03_leaves(size_t n)
+{
+    printSeparator("测试03: 排序网络作为叶子 (n = " + std::to_string(n) + ")");
+
+    std::cout << std::left << std::setw(8) << "type" << std::right << std::setw(12) << "std::sort"
+              << std::setw(14) << "sort(lambda)" << std::setw(12) << "sort"
+              << std::setw(14) << "pdq(lambda)" << std::setw(12) << "pdq_sort" << "   (ms)" << std::endl;
+    bench_leaf<std::int32_t>("int32", n);
+    bench_leaf<float>("float", n);
+    bench_leaf<std::int64_t>("int64", n);
+    bench_leaf<double>("double", n);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_correctness();
+    test02_small_arrays(n);
+    test03_leaves(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 1000000, 支持 AVX2 的 x86-64):
+
+========== 测试02: 小数组排序 (共 1000000 个元素) ==========
+
+int32
+     n   insertion      sse2      avx2   std::sort    small_sort   (ns / 数组)
+     4        39.1      17.3      30.3        31.0          20.9
+     8        95.8      45.3      21.1        94.7          23.4
+    16       235.2     118.1      54.7       222.9          61.0
+    32       681.7     341.0     125.0       845.2         119.6
+    64      1741.4     756.1     245.0      1797.7         190.9
+   128      4109.3    1339.3     717.2      5224.3         718.3
+
+uint32
+     n   insertion      sse2      avx2   std::sort    small_sort   (ns / 数组)
+     4        37.8      25.3      33.1        38.8          25.9
+     8       100.7      55.3      19.1       107.9          27.4
+    16       247.2     127.6      57.1       271.1          60.5
+    32       614.5     327.1     126.9       898.6         123.6
+    64      1488.6     706.7     257.0      2162.6         273.2
+   128      4280.0    2579.7     773.0      5204.7         761.2
+
+float
+     n   insertion      sse2      avx2   std::sort    small_sort   (ns / 数组)
+     4        40.4      21.4      59.9        40.5          28.0
+     8       108.1      55.6      37.8       102.7          42.5
+    16       217.7     103.9      86.9       283.0         116.4
+    32       682.7     346.5     200.2       934.9         212.9
+    64      1701.4     829.5     396.6      2392.8         440.8
+   128      4863.0    2311.8     966.2      5259.6        1051.3
+
+int64
+     n   insertion      sse2      avx2   std::sort    small_sort   (ns / 数组)
+     4        39.2      29.5      20.3        41.7          21.4
+     8       100.0      94.4      55.8       114.2          58.2
+    16       270.1     240.7     135.0       269.2         137.8
+    32       630.2     799.7     325.9       954.3         308.3
+    64      1555.7    2137.8     697.1      2264.3         724.5
+   128      4586.5         -         -      5623.6        4604.7
+
+double
+     n   insertion      sse2      avx2   std::sort    small_sort   (ns / 数组)
+     4        41.4      24.8      20.4        42.9          28.8
+     8       113.9      71.7      60.6       112.6          66.0
+    16       272.8     189.5     150.2       284.2         154.0
+    32       644.5     482.9     333.1       975.2         360.8
+    64      1756.7    1787.9     746.3      2325.7         720.7
+   128      4673.3         -         -      5537.9        4743.6
+
+
+========== 测试03: 排序网络作为叶子 (n = 1000000) ==========
+
+type       std::sort  sort(lambda)        sort   pdq(lambda)    pdq_sort   (ms)
+int32         110.73        112.06       94.87        108.39       34.59
+float         115.45        126.62      102.30        120.00       42.10
+int64         108.77        112.91      107.76        114.58       47.17
+double        123.82        131.30      113.73        126.63       55.78
+*/
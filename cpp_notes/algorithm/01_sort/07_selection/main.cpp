@@ -0,0 +1,173 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 选择算法要点
+// =====================================================
+// 1. nth_element: 与 introsort 相同的枢轴和划分，但只进入包含 nth 的一侧，期望 O(n)
+//    划分次数超过 2*log2(n) 转中位数的中位数 (BFPRT)，最坏 O(n)
+// 2. partial_sort: k 小用大小为 k 的堆 O(n log k)；k 大改为 nth_element + sort
+// 3. partial_sort_copy: 输入只读一遍，可以是输入迭代器
+// 4. top_k: 流式累加器，只保存 k 个元素，数据不需要先放进容器
+// =====================================================
+
+using data_t = mystl::vector<std::uint64_t>;
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+data_t make_data(size_t n, const std::string& kind)
+{
+    std::mt19937_64 rng(42);
+    data_t v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (kind == "random") v.push_back(rng());
+        else if (kind == "sorted") v.push_back(i);
+        else if (kind == "organ_pipe") v.push_back(i < n / 2 ? i : n - i);
+        else v.push_back(rng() % 16); // few_unique
+    }
+    return v;
+}
+
+// =====================================================
+// 测试01: 正确性
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    std::mt19937 rng(1);
+    bool nth_ok = true, partial_ok = true, copy_ok = true, topk_ok = true;
+    for (int round = 0; round < 500; ++round) {
+        size_t n = rng() % 3000;
+        int range = 1 + static_cast<int>(rng() % (round % 2 ? 10 : 100000));
+        std::vector<int> a(n);
+        for (auto& x : a) x = static_cast<int>(rng() % range);
+        std::vector<int> ref = a;
+        std::sort(ref.begin(), ref.end(), std::greater<>());
+        size_t k = n ? rng() % (n + 1) : 0;
+
+        if (k < n) {
+            std::vector<int> b = a;
+            mystl::nth_element(b.begin(), b.begin() + k, b.end(), std::greater<>());
+            int kth = b[k];
+            nth_ok = nth_ok && kth == ref[k]
+                && std::all_of(b.begin(), b.begin() + k, [kth](int x) { return x >= kth; })
+                && std::all_of(b.begin() + k, b.end(), [kth](int x) { return x <= kth; });
+        }
+
+        std::vector<int> c = a;
+        mystl::partial_sort(c.begin(), c.begin() + k, c.end(), std::greater<>());
+        partial_ok = partial_ok && std::equal(c.begin(), c.begin() + k, ref.begin())
+            && std::is_permutation(c.begin(), c.end(), a.begin());
+
+        std::vector<int> out(k);
+        auto end = mystl::partial_sort_copy(a.begin(), a.end(), out.begin(), out.end(), std::greater<>());
+        copy_ok = copy_ok && end == out.end() && std::equal(out.begin(), out.end(), ref.begin());
+
+        mystl::top_k<int, std::greater<>> top(k);
+        top.push(a.begin(), a.end());
+        mystl::vector<int> best = top.sorted();
+        topk_ok = topk_ok && best.size() == k && std::equal(best.begin(), best.end(), ref.begin());
+    }
+    std::cout << "nth_element       : " << (nth_ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "partial_sort      : " << (partial_ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "partial_sort_copy : " << (copy_ok ? "OK" : "FAILED") << std::endl;
+    std::cout << "top_k             : " << (topk_ok ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: nth_element (取中位数)
+// =====================================================
+void test02_nth_element(size_t n)
+{
+    printSeparator("测试02: nth_element 取中位数 (n = " + std::to_string(n) + ")");
+
+    std::cout << std::left << std::setw(12) << "input" << std::right << std::setw(12) << "mystl::sort"
+              << std::setw(18) << "std::nth_element" << std::setw(20) << "mystl::nth_element" << "   (ms)" << std::endl;
+    for (const char* kind : {"random", "sorted", "organ_pipe", "few_unique"}) {
+        data_t data = make_data(n, kind);
+        data_t work;
+        auto mid = [&] { return work.begin() + work.size() / 2; };
+        double t_sort = best_of_ms(3, [&] { work = data; }, [&] { mystl::sort(work.begin(), work.end()); });
+        double t_std = best_of_ms(3, [&] { work = data; }, [&] { std::nth_element(work.begin(), mid(), work.end()); });
+        double t_my = best_of_ms(3, [&] { work = data; }, [&] { mystl::nth_element(work.begin(), mid(), work.end()); });
+        std::cout << std::left << std::setw(12) << kind << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << t_sort << std::setw(18) << t_std << std::setw(20) << t_my << std::endl;
+    }
+}
+
+// =====================================================
+// 测试03: 取最大的 k 个 (有序输出)
+// =====================================================
+void test03_top_k(size_t n)
+{
+    printSeparator("测试03: 取最大的 k 个并排序 (n = " + std::to_string(n) + ", 随机输入)");
+
+    data_t data = make_data(n, "random");
+    std::cout << std::right << std::setw(9) << "k" << std::setw(12) << "mystl::sort" << std::setw(18) << "std::partial_sort"
+              << std::setw(20) << "mystl::partial_sort" << std::setw(10) << "top_k" << "   (ms)" << std::endl;
+
+    for (size_t k : {size_t(10), size_t(1000), n / 100, n / 10, n / 2}) {
+        data_t work;
+        auto greater = std::greater<std::uint64_t>();
+        double t_sort = best_of_ms(3, [&] { work = data; }, [&] { mystl::sort(work.begin(), work.end(), greater); });
+        double t_std = best_of_ms(3, [&] { work = data; }, [&] {
+            std::partial_sort(work.begin(), work.begin() + k, work.end(), greater); });
+        double t_my = best_of_ms(3, [&] { work = data; }, [&] {
+            mystl::partial_sort(work.begin(), work.begin() + k, work.end(), greater); });
+        // top_k 直接从随机数发生器读数据，不需要先存下全部 n 个元素
+        double t_top = best_of_ms(3, [&] {
+            std::mt19937_64 rng(42);
+            mystl::top_k<std::uint64_t, std::greater<>> top(k);
+            for (size_t i = 0; i < n; ++i) top.push(rng());
+            do_not_optimize(std::move(top).sorted());
+        });
+        std::cout << std::setw(9) << k << std::fixed << std::setprecision(2) << std::setw(12) << t_sort
+                  << std::setw(18) << t_std << std::setw(20) << t_my << std::setw(10) << t_top << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_correctness();
+    test02_nth_element(n * 10);
+    test03_top_k(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 1000000):
+
+========== 测试02: nth_element 取中位数 (n = 10000000) ==========
+
+input        mystl::sort  std::nth_element  mystl::nth_element   (ms)
+random           2157.64            207.09              191.03
+sorted            293.54             48.26               33.93
+organ_pipe        592.01            614.02               54.08
+few_unique        759.55            182.24              189.61
+
+========== 测试03: 取最大的 k 个并排序 (n = 1000000, 随机输入) ==========
+
+        k mystl::sort std::partial_sort mystl::partial_sort     top_k   (ms)
+       10      163.32              0.46                0.43     11.57
+     1000      159.49              1.15                1.07     11.62
+    10000      165.09             10.97               14.95     25.75
+   100000      176.85             98.63              106.66    132.47
+   500000      207.80            326.24              111.02    293.37
+*/
@@ -34,3 +34,36 @@ size_t kmp_search(const std::string& str, const std::string& patt)
     }
     return static_cast<size_t>(-1);
 }
+
+// 流式 KMP：输入分块到达时 (网络包、文件块)，只要在两次 feed 之间保存已经匹配的长度 j，
+// 跨块的匹配也能找到；记录的位置从流的开头算起，不需要把各块拼接起来
+class kmp_stream
+{
+public:
+    explicit kmp_stream(const std::string& patt) : patt_(patt), lps_(build_lps(patt)) {}
+
+    // 处理一块输入，把本块中完成的匹配的起点追加到 out
+    void feed(const char* data, size_t n, std::vector<size_t>& out)
+    {
+        if (patt_.empty()) { offset_ += n; return; }
+        size_t i = 0;
+        while (i < n) {
+            if (data[i] == patt_[j_]) {
+                ++i; ++j_;
+                if (j_ == patt_.size()) {
+                    out.push_back(offset_ + i - j_);
+                    j_ = lps_[j_ - 1];
+                }
+            }
+            else if (j_ > 0) { j_ = lps_[j_ - 1]; }
+            else { ++i; }
+        }
+        offset_ += n;
+    }
+
+private:
+    std::string patt_;
+    std::vector<int> lps_;
+    size_t j_ = 0;       // 已经匹配的模式前缀长度
+    size_t offset_ = 0;  // 之前各块的总长度
+};
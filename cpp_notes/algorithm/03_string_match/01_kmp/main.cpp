@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include <cstdio>
+#include <cstring>
 #include <type_traits>
 #include <string>
 
@@ -22,8 +23,20 @@ void test01()
 	std::cout <<  "pos2: " << pos2 << std::endl;
 }
 
+void test02_stream()
+{
+	// "world" 被拆在两块之间，按块分别调用 kmp_search 会漏掉
+	const char* chunks[] = {"Hello wo", "rld, hello wor", "ld"};
+	kmp_stream stream("world");
+	std::vector<size_t> matches;
+	for (const char* c : chunks)
+		stream.feed(c, std::strlen(c), matches);
+	for (size_t pos : matches)
+		std::cout << "stream match at " << pos << std::endl;
+}
 
 int main() {
-    std::cout << "hello world" << std::endl;
+    test01();
+    test02_stream();
     return 0;
 }
\ No newline at end of file
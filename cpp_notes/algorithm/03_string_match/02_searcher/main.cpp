@@ -0,0 +1,213 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/basic_string.h"
+#include "test_class/Timer.h"
+#include "test_class/LogData.h"
+
+// =====================================================
+// 预编译搜索器要点
+// =====================================================
+// 1. mystl::kmp_search / basic_string::find 每次调用都重新计算失配表 (还要 new 一次)，
+//    同一批模式在大量短行上反复查找时，预处理的开销和查找本身相当
+// 2. 搜索器在构造时计算一次表，表放在共享的只读块里，拷贝只加引用计数，可以跨线程共用:
+//    - kmp_searcher: 文本不回退，前向迭代器即可，最坏 O(n + m)
+//    - boyer_moore_horspool_searcher: 按窗口末尾字符跳转，字母表大时平均跳过接近 m 个字符
+//    - two_way_searcher: 临界分解，O(1) 额外空间，最坏 O(n + m)，不怕周期性的模式
+// 3. mystl::searcher 按模式选择: 单字符用 memchr，字节串且不同字符 >= 4 用 BMH，否则 Two-Way
+// 4. 用法: mystl::search(first, last, s) 或 str.find(s)
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 一组在日志中很少出现的签名
+std::vector<std::string> make_patterns(size_t count)
+{
+    std::mt19937_64 rng(11);
+    static const char* words[] = {"timeout", "refused", "panic", "deadlock", "overflow", "oom-killer", "segfault",
+                                  "retrying", "circuit-open", "throttled", "corrupt", "checksum"};
+    std::vector<std::string> pats;
+    for (size_t i = 0; i < count; ++i) {
+        std::string p = words[i % 12];
+        p += "-" + std::to_string(rng() % 1000);
+        pats.push_back(p);
+    }
+    return pats;
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// 对每一行、每个模式调用一次 search，返回命中次数
+template <typename Search>
+size_t scan_lines(const std::string& log, const std::vector<size_t>& starts, size_t patterns, Search search)
+{
+    size_t hits = 0;
+    const char* base = log.data();
+    for (size_t l = 0; l + 1 < starts.size(); ++l) {
+        const char* b = base + starts[l];
+        const char* e = base + starts[l + 1];
+        for (size_t p = 0; p < patterns; ++p) hits += search(p, b, e) != e;
+    }
+    return hits;
+}
+
+// =====================================================
+// 测试01: 多个模式逐行查找 (预处理是否复用)
+// =====================================================
+void test01_lines(const std::string& log, const std::vector<size_t>& starts)
+{
+    const size_t np = 200;
+    printSeparator("测试01: " + std::to_string(np) + " 个模式 x " + std::to_string(starts.size() - 1) + " 行日志");
+
+    std::vector<std::string> pats = make_patterns(np);
+    std::vector<mystl::kmp_searcher<char>> kmp;
+    std::vector<mystl::boyer_moore_horspool_searcher<char>> bmh;
+    std::vector<mystl::two_way_searcher<char>> tw;
+    std::vector<mystl::searcher<char>> def;
+    Timer build;
+    for (const std::string& p : pats) def.emplace_back(p.begin(), p.end());
+    double build_ms = build.elapsed_ms();
+    for (const std::string& p : pats) {
+        kmp.emplace_back(p.begin(), p.end());
+        bmh.emplace_back(p.begin(), p.end());
+        tw.emplace_back(p.begin(), p.end());
+    }
+
+    size_t h0 = 0, h1 = 0, h2 = 0, h3 = 0, h4 = 0;
+    double base = best_of_ms(3, [&] {
+        h0 = scan_lines(log, starts, np, [&](size_t p, const char* b, const char* e) {
+            return mystl::kmp_search(b, e, pats[p].c_str(), pats[p].c_str() + pats[p].size());
+        });
+    });
+    double t1 = best_of_ms(3, [&] {
+        h1 = scan_lines(log, starts, np, [&](size_t p, const char* b, const char* e) { return mystl::search(b, e, kmp[p]); });
+    });
+    double t2 = best_of_ms(3, [&] {
+        h2 = scan_lines(log, starts, np, [&](size_t p, const char* b, const char* e) { return mystl::search(b, e, bmh[p]); });
+    });
+    double t3 = best_of_ms(3, [&] {
+        h3 = scan_lines(log, starts, np, [&](size_t p, const char* b, const char* e) { return mystl::search(b, e, tw[p]); });
+    });
+    double t4 = best_of_ms(3, [&] {
+        h4 = scan_lines(log, starts, np, [&](size_t p, const char* b, const char* e) { return mystl::search(b, e, def[p]); });
+    });
+    if (h0 != h1 || h0 != h2 || h0 != h3 || h0 != h4) std::cout << "hit counts differ" << std::endl;
+
+    print_row("mystl::kmp_search (table per call)", base, 0);
+    print_row("kmp_searcher", t1, base);
+    print_row("boyer_moore_horspool_searcher", t2, base);
+    print_row("two_way_searcher", t3, base);
+    print_row("mystl::searcher (auto)", t4, base);
+    std::cout << "hits = " << h0 << ", building " << np << " searchers: " << build_ms << " ms" << std::endl;
+}
+
+// =====================================================
+// 测试02: 整块文本，不同模式长度
+// =====================================================
+void test02_lengths(const std::string& log)
+{
+    printSeparator("测试02: 在 " + std::to_string(log.size() >> 20) + " MB 日志中查找最后一行之后才出现的模式");
+
+    const char* b = log.data();
+    const char* e = b + log.size();
+    std::cout << std::left << std::setw(8) << "m" << std::right << std::setw(12) << "kmp_search" << std::setw(12) << "kmp"
+              << std::setw(12) << "bmh" << std::setw(12) << "two_way" << std::setw(12) << "auto" << "   (ms)" << std::endl;
+    for (size_t m : {2, 4, 8, 16, 32, 64}) {
+        std::string p = std::string("zq-timeout-connection-refused-by-upstream-peer-while-reading-body").substr(0, m);
+        mystl::kmp_searcher<char> k(p.begin(), p.end());
+        mystl::boyer_moore_horspool_searcher<char> h(p.begin(), p.end());
+        mystl::two_way_searcher<char> t(p.begin(), p.end());
+        mystl::searcher<char> a(p.begin(), p.end());
+        const char* r = nullptr;
+        double t0 = best_of_ms(3, [&] { r = mystl::kmp_search(b, e, p.c_str(), p.c_str() + m); do_not_optimize(r); });
+        double t1 = best_of_ms(3, [&] { r = mystl::search(b, e, k); do_not_optimize(r); });
+        double t2 = best_of_ms(3, [&] { r = mystl::search(b, e, h); do_not_optimize(r); });
+        double t3 = best_of_ms(3, [&] { r = mystl::search(b, e, t); do_not_optimize(r); });
+        double t4 = best_of_ms(3, [&] { r = mystl::search(b, e, a); do_not_optimize(r); });
+        std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(8) << m << std::right << std::setw(12) << t0
+                  << std::setw(12) << t1 << std::setw(12) << t2 << std::setw(12) << t3 << std::setw(12) << t4 << std::endl;
+    }
+}
+
+// =====================================================
+// 测试03: 周期性模式 (BMH 的最坏情况)
+// =====================================================
+void test03_periodic()
+{
+    printSeparator("测试03: 在 16 MB 的 'aaa...' 中查找 'b' + 'a' x 63");
+
+    std::string text(size_t(16) << 20, 'a');
+    std::string p = "b" + std::string(63, 'a');
+    const char* b = text.data();
+    const char* e = b + text.size();
+    mystl::boyer_moore_horspool_searcher<char> h(p.begin(), p.end());
+    mystl::two_way_searcher<char> t(p.begin(), p.end());
+    mystl::searcher<char> a(p.begin(), p.end());
+    const char* r = nullptr;
+    double t2 = best_of_ms(3, [&] { r = mystl::search(b, e, h); do_not_optimize(r); });
+    double t3 = best_of_ms(3, [&] { r = mystl::search(b, e, t); do_not_optimize(r); });
+    double t4 = best_of_ms(3, [&] { r = mystl::search(b, e, a); do_not_optimize(r); });
+    print_row("boyer_moore_horspool_searcher", t2, 0);
+    print_row("two_way_searcher", t3, t2);
+    print_row("mystl::searcher (auto -> two_way)", t4, t2);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000;
+
+    std::vector<size_t> starts;
+    std::string log = make_log_lines(lines, starts);
+
+    test01_lines(log, starts);
+
+    std::vector<size_t> big_starts;
+    std::string big = make_log_lines(lines * 8, big_starts);
+    test02_lengths(big);
+    test03_periodic();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机; 测试03 中 auto 与 two_way_searcher 是同一份实现，差别来自内联和代码布局):
+
+========== 测试01: 200 个模式 x 50000 行日志 ==========
+
+mystl::kmp_search (table per call)         3373.39 ms
+kmp_searcher                               2265.06 ms   (1.49x)
+boyer_moore_horspool_searcher               795.56 ms   (4.24x)
+two_way_searcher                           2423.71 ms   (1.39x)
+mystl::searcher (auto)                      814.23 ms   (4.14x)
+hits = 0, building 200 searchers: 0.23 ms
+
+========== 测试02: 在 43 MB 日志中查找最后一行之后才出现的模式 ==========
+
+m         kmp_search         kmp         bmh     two_way        auto   (ms)
+2             105.54       72.75      103.89       73.31       72.52
+4             102.97       73.47       59.39       87.55       59.56
+8              98.87       73.59       29.09       86.72       28.79
+16             96.16       73.97       17.70       86.57       17.86
+32            101.41       72.85       11.38       87.17       11.38
+64             99.21       69.72       10.21       85.64        9.80
+
+========== 测试03: 在 16 MB 的 'aaa...' 中查找 'b' + 'a' x 63 ==========
+
+boyer_moore_horspool_searcher                74.55 ms
+two_way_searcher                             21.96 ms   (3.40x)
+mystl::searcher (auto -> two_way)            12.71 ms   (5.86x)
+*/
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "mystl/algorithm.h"
+#include "mystl/basic_string.h"
+#include "test_class/Timer.h"
+#include "test_class/LogData.h"
+
+// =====================================================
+// SIMD 子串查找要点
+// =====================================================
+// 1. KMP 保证 O(n + m)，但每个字节都要走一次比较和分支，跑不满内存带宽
+// 2. 首尾字符过滤: 把 p[0] 和 p[m - 1] 广播到寄存器，一次比较 32 (AVX2) / 16 (SSE2) 个起点，
+//    h[i] == p[0] 且 h[i + m - 1] == p[m - 1] 的起点才是候选，再用 memcmp 比较中间部分。
+//    日志文本里两个字节同时匹配的起点很少，大部分时间只有两次加载、两次比较和一次 movemask
+// 3. rfind 从尾部按块往前，find_first_of 对集合里的每个字节比较一次再按位或 (集合 <= 16 个字节)
+// 4. 运行时检测 AVX2，否则用 SSE2；非 x86 或文本不足一个寄存器时用 memchr + memcmp 的标量版本
+// 5. 代价: 最坏情况 (如在 "aaa...a" 中找 "aa...ab") 每个起点都是候选，退化为 O(n * m)，见测试03
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 模拟服务日志，最后一行是要找的那一行 (其中的 '!' 不在其他行里出现)
+const char* const k_needle_line = "!segfault in worker-17: stack overflow at 0x7f3a9c0012e8 in handler /api/v1/orders, core dumped (signal 11)\n";
+
+mystl::string make_needle_log(size_t bytes)
+{
+    mystl::string log = make_log<mystl::string>(bytes);
+    log.append(k_needle_line);
+    return log;
+}
+
+// 长度为 m 的模式: m == 1 取 '!'，否则从 "overflow" 开始取 m 个字符 ("ov" 只在最后一行出现，首字节 'o' 在日志里很常见)
+std::string make_pattern(size_t m)
+{
+    return m == 1 ? std::string("!") : std::string(std::strstr(k_needle_line, "overflow"), m);
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: find，模式长度 1 ~ 64
+// =====================================================
+void test01_find(const mystl::string& log)
+{
+    printSeparator("测试01: 在 " + std::to_string(log.size() >> 20) + " MB 日志中 find 最后一行的模式 (ms)");
+
+    const char* b = log.c_str();
+    const size_t n = log.size();
+    const std::string_view view(b, n);
+    std::cout << std::left << std::setw(6) << "m" << std::right << std::setw(12) << "kmp" << std::setw(12) << "std::sv"
+              << std::setw(12) << "scalar" << std::setw(12) << "sse2" << std::setw(12) << "avx2" << std::setw(12)
+              << "find" << std::setw(10) << "kmp/find" << std::endl;
+    for (size_t m : {1, 2, 4, 8, 16, 32, 64}) {
+        const std::string p = make_pattern(m);
+        const mystl::string mp(p.c_str(), m);
+        const size_t expect = view.find(p);
+        size_t r0 = 0, r1 = 0, r2 = 0, r3 = 0, r4 = 0, r5 = 0;
+        // 原来的 basic_string::find 就是逐字节 KMP，与 mystl::kmp_search 相同
+        double t0 = best_of_ms(1, [&] { r0 = static_cast<size_t>(mystl::kmp_search(b, b + n, p.c_str(), p.c_str() + m) - b); });
+        double t1 = best_of_ms(3, [&] { r1 = view.find(p); });
+        double t2 = best_of_ms(3, [&] { r2 = mystl::detail::scalar_find(b, n, p.c_str(), m); });
+        double t3 = best_of_ms(3, [&] { r3 = mystl::detail::simd_sse2::find_kernel<mystl::detail::simd_sse2::search_ops>(b, n, p.c_str(), m); });
+        double t4 = best_of_ms(3, [&] { r4 = mystl::detail::simd_avx2::find_kernel<mystl::detail::simd_avx2::search_ops>(b, n, p.c_str(), m); });
+        double t5 = best_of_ms(3, [&] { r5 = log.find(mp); });
+        if (r0 != expect || r1 != expect || r2 != expect || r3 != expect || r4 != expect || r5 != expect) {
+            std::cout << "result mismatch for m = " << m << std::endl;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(6) << m << std::right << std::setw(12) << t0
+                  << std::setw(12) << t1 << std::setw(12) << t2 << std::setw(12) << t3 << std::setw(12) << t4
+                  << std::setw(12) << t5 << std::setw(9) << t0 / t5 << "x" << std::endl;
+    }
+}
+
+// =====================================================
+// 测试02: rfind / find_first_of / contains
+// =====================================================
+void test02_others(const mystl::string& log)
+{
+    printSeparator("测试02: rfind / find_first_of / contains");
+
+    const char* b = log.c_str();
+    const size_t n = log.size();
+    const std::string_view view(b, n);
+
+    // rfind 从尾部往前找第一行的开头，整块扫描一遍
+    const std::string head(b, 24);
+    const mystl::string mhead(head.c_str(), head.size());
+    size_t r0 = 0, r1 = 0, r2 = 0;
+    double t0 = best_of_ms(3, [&] { r0 = view.rfind(head); });
+    double t1 = best_of_ms(3, [&] { r1 = mystl::detail::scalar_rfind(b, n, head.c_str(), head.size()); });
+    double t2 = best_of_ms(3, [&] { r2 = log.rfind(mhead); });
+    if (r0 != 0 || r1 != 0 || r2 != 0) std::cout << "rfind mismatch" << std::endl;
+    print_row("rfind (m = 24)  std::string_view", t0, 0);
+    print_row("rfind (m = 24)  scalar", t1, t0);
+    print_row("rfind (m = 24)  mystl::string", t2, t0);
+
+    // find_first_of: 集合中只有 '!' 在最后一行出现
+    for (const char* set : {"!", "!#$%", "!#$&*;<>?@^`{|}~", "!#$&*;<>?@^`{|}~\"'+\\CHJKLMPQSTVX"}) {
+        const size_t k = std::char_traits<char>::length(set);
+        size_t f0 = 0, f1 = 0, f2 = 0;
+        double u0 = best_of_ms(3, [&] { f0 = view.find_first_of(set, 0, k); });
+        double u1 = best_of_ms(3, [&] { f1 = mystl::detail::scalar_find_first_of(b, n, set, k); });
+        double u2 = best_of_ms(3, [&] { f2 = log.find_first_of(set, 0, k); });
+        if (f1 != f0 || f2 != f0) std::cout << "find_first_of mismatch" << std::endl;
+        const std::string label = "find_first_of (k = " + std::to_string(k) + ")";
+        print_row(label + "  std::string_view", u0, 0);
+        print_row(label + "  scalar bitmap", u1, u0);
+        print_row(label + "  mystl::string", u2, u0);
+    }
+
+    bool c = false;
+    double t3 = best_of_ms(3, [&] { c = log.contains("stack overflow"); });
+    print_row(std::string("contains(\"stack overflow\") = ") + (c ? "true" : "false"), t3, 0);
+}
+
+// =====================================================
+// 测试03: 最坏情况 (每个起点都是候选)
+// =====================================================
+void test03_worst()
+{
+    printSeparator("测试03: 在 16 MB 的 'aaa...' 中查找 'a' x 31 + 'b' x 2 + 'a'");
+
+    mystl::string text;
+    text.resize(size_t(16) << 20, 'a');
+    const std::string p = std::string(31, 'a') + "bba";
+    const mystl::string mp(p.c_str(), p.size());
+    const char* b = text.c_str();
+    size_t r0 = 0, r1 = 0;
+    double t0 = best_of_ms(1, [&] { do_not_optimize(mystl::kmp_search(b, b + text.size(), p.c_str(), p.c_str() + p.size())); });
+    double t1 = best_of_ms(1, [&] { r1 = text.find(mp); });
+    double t2 = best_of_ms(1, [&] { r0 = std::string_view(b, text.size()).find(p); });
+    if (r0 != r1) std::cout << "result mismatch" << std::endl;
+    print_row("mystl::kmp_search", t0, 0);
+    print_row("mystl::string::find (SIMD)", t1, t0);
+    print_row("std::string_view::find", t2, t0);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+
+    Timer gen;
+    mystl::string log = make_needle_log(mb << 20);
+    std::cout << "generated " << (log.size() >> 20) << " MB of log text in " << std::fixed << std::setprecision(0)
+              << gen.elapsed_ms() << " ms" << std::endl;
+
+    test01_find(log);
+    test02_others(log);
+    test03_worst();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机, AVX2; find 列是 mystl::string::find，m == 1 时转给 memchr;
+k = 32 超过 SIMD 集合上限，走标量位图):
+
+generated 1024 MB of log text in 8103 ms
+
+========== 测试01: 在 1024 MB 日志中 find 最后一行的模式 (ms) ==========
+
+m              kmp     std::sv      scalar        sse2        avx2        find  kmp/find
+1          2368.67      107.21      104.87      243.08      172.80      104.55    22.66x
+2          2644.85      255.09      260.77      218.12      175.58      174.39    15.17x
+4          2689.34      263.01      266.39      217.89      174.15      179.48    14.98x
+8          2458.54      259.39      266.55      227.75      167.82      166.39    14.78x
+16         2787.71      265.90      271.14      226.38      189.86      183.89    15.16x
+32         2026.66      286.21      262.99      301.26      240.12      230.19     8.80x
+64         2174.25      330.39      282.51      247.92      200.67      185.39    11.73x
+
+========== 测试02: rfind / find_first_of / contains ==========
+
+rfind (m = 24)  std::string_view           5410.64 ms
+rfind (m = 24)  scalar                     1846.59 ms   (2.93x)
+rfind (m = 24)  mystl::string               382.16 ms   (14.16x)
+find_first_of (k = 1)  std::string_view    4549.42 ms
+find_first_of (k = 1)  scalar bitmap       1351.33 ms   (3.37x)
+find_first_of (k = 1)  mystl::string        133.91 ms   (33.97x)
+find_first_of (k = 4)  std::string_view    3699.93 ms
+find_first_of (k = 4)  scalar bitmap       1215.63 ms   (3.04x)
+find_first_of (k = 4)  mystl::string        176.10 ms   (21.01x)
+find_first_of (k = 16)  std::string_view   3517.98 ms
+find_first_of (k = 16)  scalar bitmap      1281.05 ms   (2.75x)
+find_first_of (k = 16)  mystl::string       266.62 ms   (13.19x)
+find_first_of (k = 32)  std::string_view   3937.99 ms
+find_first_of (k = 32)  scalar bitmap      1635.21 ms   (2.41x)
+find_first_of (k = 32)  mystl::string      1319.50 ms   (2.98x)
+contains("stack overflow") = true           148.17 ms
+
+========== 测试03: 在 16 MB 的 'aaa...' 中查找 'a' x 31 + 'b' x 2 + 'a' ==========
+
+mystl::kmp_search                            39.74 ms
+mystl::string::find (SIMD)                   68.20 ms   (0.58x)
+std::string_view::find                      136.69 ms   (0.29x)
+*/
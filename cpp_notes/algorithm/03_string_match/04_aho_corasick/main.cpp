@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "test_class/Timer.h"
+#include "test_class/LogData.h"
+
+// =====================================================
+// Aho-Corasick 多模式匹配要点
+// =====================================================
+// 1. 对每个模式调用一次 kmp_search / 搜索器，k 个模式要扫描文本 k 遍；
+//    Aho-Corasick 把所有模式放进一棵带失配链接的字典树，扫描一遍就找出所有模式的所有出现
+// 2. 失配链接: 状态 s 表示文本当前最长的、是某个模式前缀的后缀；没有转移时沿失配链接退到更短的后缀，
+//    均摊下来每个字节 O(1)；output 链接指向失配链上最近的终止状态，报告匹配时只走真正的匹配
+// 3. 存储: 字节先映射为类别 (模式中没出现的字节都是类别 0)，状态放进双数组，
+//    转移 t = base[s] + c，check[t] == s 时有效；base / check / fail / output 在同一个 16 字节的格子里
+// 4. 构造: 模式排序后按字典序插入，新节点总是父节点的最后一个孩子，不需要查找；按层次放入双数组
+// 5. 两种报告方式: overlapping 报告所有 (可重叠) 的出现；leftmost_longest 报告不重叠的、
+//    起点最靠左且最长的匹配 (与正则 "a|ab|abc" 的最左最长语义相同)
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: 日志分类，每行对 2000 个签名
+// =====================================================
+void test01_classify(const std::string& log, const std::vector<size_t>& starts)
+{
+    const size_t np = 2000;
+    const size_t lines = starts.size() - 1;
+    printSeparator("测试01: " + std::to_string(lines) + " 行日志 x " + std::to_string(np) + " 个签名，统计 (行, 签名) 命中对数");
+
+    const std::vector<std::string> sigs = make_signatures(np, 11);
+    const char* base = log.data();
+
+    // 现在的做法: 每个签名调用一次 kmp_search
+    size_t h0 = 0;
+    double t0 = best_of_ms(1, [&] {
+        h0 = 0;
+        for (size_t l = 0; l < lines; ++l) {
+            const char* b = base + starts[l];
+            const char* e = base + starts[l + 1];
+            for (const std::string& s : sigs) h0 += mystl::kmp_search(b, e, s.c_str(), s.c_str() + s.size()) != e;
+        }
+    });
+
+    // 预编译的单模式搜索器，仍然是每个签名扫描一遍
+    std::vector<mystl::searcher<char>> searchers;
+    for (const std::string& s : sigs) searchers.emplace_back(s.begin(), s.end());
+    size_t h1 = 0;
+    double t1 = best_of_ms(1, [&] {
+        h1 = 0;
+        for (size_t l = 0; l < lines; ++l) {
+            const char* b = base + starts[l];
+            const char* e = base + starts[l + 1];
+            for (const auto& s : searchers) h1 += mystl::search(b, e, s) != e;
+        }
+    });
+
+    // 一遍扫描，last_line 去掉同一行内同一个签名的重复命中
+    Timer build;
+    const mystl::aho_corasick ac(sigs);
+    const double build_ms = build.elapsed_ms();
+    std::vector<size_t> last_line(np, size_t(-1));
+    size_t h2 = 0;
+    double t2 = best_of_ms(3, [&] {
+        h2 = 0;
+        std::fill(last_line.begin(), last_line.end(), size_t(-1));
+        for (size_t l = 0; l < lines; ++l) {
+            ac.for_each_match(base + starts[l], base + starts[l + 1], [&](const mystl::ac_match& m) {
+                if (last_line[m.pattern] != l) {
+                    last_line[m.pattern] = l;
+                    ++h2;
+                }
+            });
+        }
+    });
+    if (h0 != h1 || h0 != h2) std::cout << "hit counts differ: " << h0 << " " << h1 << " " << h2 << std::endl;
+
+    print_row("kmp_search x 2000 per line", t0, 0);
+    print_row("mystl::searcher x 2000 per line", t1, t0);
+    print_row("aho_corasick, one pass per line", t2, t0);
+    std::cout << "hits = " << h0 << ", building the automaton: " << build_ms << " ms" << std::endl;
+}
+
+// =====================================================
+// 测试02: 构造时间和内存
+// =====================================================
+void test02_build()
+{
+    printSeparator("测试02: 构造时间、状态数和内存");
+
+    std::cout << std::left << std::setw(12) << "patterns" << std::right << std::setw(12) << "build ms" << std::setw(12)
+              << "states" << std::setw(12) << "KB" << std::setw(16) << "bytes/state" << std::endl;
+    for (size_t np : {1000, 10000, 100000}) {
+        const std::vector<std::string> sigs = make_signatures(np, 17);
+        size_t states = 0, bytes = 0;
+        double ms = best_of_ms(3, [&] {
+            mystl::aho_corasick ac(sigs);
+            states = ac.state_count();
+            bytes = ac.memory_bytes();
+        });
+        std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(12) << np << std::right << std::setw(12) << ms
+                  << std::setw(12) << states << std::setw(12) << (bytes >> 10) << std::setw(16) << double(bytes) / states
+                  << std::endl;
+    }
+
+    // 字母表大、树浅而宽: 100k 个随机可打印字符串
+    std::mt19937_64 rng(23);
+    std::vector<std::string> random(100000);
+    for (std::string& s : random) {
+        const size_t len = 4 + rng() % 28;
+        for (size_t j = 0; j < len; ++j) s += char(32 + rng() % 95);
+    }
+    size_t states = 0, bytes = 0;
+    double ms = best_of_ms(3, [&] {
+        mystl::aho_corasick ac(random);
+        states = ac.state_count();
+        bytes = ac.memory_bytes();
+    });
+    std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(12) << "100000 rnd" << std::right << std::setw(12)
+              << ms << std::setw(12) << states << std::setw(12) << (bytes >> 10) << std::setw(16) << double(bytes) / states
+              << std::endl;
+}
+
+// =====================================================
+// 测试03: 整块文本，overlapping 与 leftmost_longest
+// =====================================================
+void test03_kinds(const std::string& log)
+{
+    printSeparator("测试03: 在 " + std::to_string(log.size() >> 20) + " MB 日志中查找 2000 个签名");
+
+    const std::vector<std::string> sigs = make_signatures(2000, 11);
+    const mystl::aho_corasick all(sigs);
+    const mystl::aho_corasick leftmost(sigs, mystl::match_kind::leftmost_longest);
+    const char* b = log.data();
+    const char* e = b + log.size();
+    size_t n0 = 0, n1 = 0;
+    double t0 = best_of_ms(3, [&] { n0 = 0; all.for_each_match(b, e, [&](const mystl::ac_match&) { ++n0; }); });
+    double t1 = best_of_ms(3, [&] { n1 = 0; leftmost.for_each_match(b, e, [&](const mystl::ac_match&) { ++n1; }); });
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(24) << "overlapping" << std::right << std::setw(10) << t0 << " ms  "
+              << std::setw(8) << log.size() / t0 / 1000 << " MB/s  matches = " << n0 << std::endl;
+    std::cout << std::left << std::setw(24) << "leftmost_longest" << std::right << std::setw(10) << t1 << " ms  "
+              << std::setw(8) << log.size() / t1 / 1000 << " MB/s  matches = " << n1 << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000;
+
+    std::vector<size_t> starts;
+    std::string log = make_log_lines(lines, starts);
+    test01_classify(log, starts);
+
+    test02_build();
+
+    std::vector<size_t> big_starts;
+    std::string big = make_log_lines(400000, big_starts);
+    test03_kinds(big);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机; 100000 rnd 是 4 ~ 31 个随机可打印字符的模式，95 个字节类别):
+
+
+========== 测试01: 5000 行日志 x 2000 个签名，统计 (行, 签名) 命中对数 ==========
+
+kmp_search x 2000 per line                     3418.79 ms
+mystl::searcher x 2000 per line                 644.83 ms   (5.30x)
+aho_corasick, one pass per line                   2.39 ms   (1430.45x)
+hits = 10409, building the automaton: 2.70 ms
+
+========== 测试02: 构造时间、状态数和内存 ==========
+
+patterns        build ms      states          KB     bytes/state
+1000                0.76       10984         268           25.02
+10000               8.86      100407        2399           24.47
+100000            156.19      906121       21634           24.45
+100000 rnd        484.40     1552752       36791           24.26
+
+========== 测试03: 在 43 MB 日志中查找 2000 个签名 ==========
+
+overlapping                 197.07 ms    231.27 MB/s  matches = 834832
+leftmost_longest            212.89 ms    214.08 MB/s  matches = 834832
+*/
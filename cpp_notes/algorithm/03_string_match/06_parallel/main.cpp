@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/thread_pool.h"
+#include "test_class/Timer.h"
+#include "test_class/LogData.h"
+
+// =====================================================
+// 并行查找要点
+// =====================================================
+// 1. 一段很大的文本 (mmap 的日志) 上 kmp_search / 搜索器都是单线程的；切成若干块交给线程池，
+//    每块独立查找，吞吐量可以一直涨到内存带宽的上限
+// 2. 跨块的匹配: 块 [b, e) 从 b - (m - 1) 开始查找 (m 为最长模式长度)，多读 m - 1 个元素；
+//    匹配只归它结束位置所在的块，只报告结束位置在 (b, e] 中的匹配，跨块的匹配不会丢也不会重复
+// 3. mystl::parallel_find_all(pool, first, last, s): 每块的结果各存一份，按块序拼接，
+//    与单线程逐个查找的结果和顺序完全相同；s 可以是单模式搜索器，也可以是 overlapping 的 aho_corasick
+// 4. 不需要顺序时: parallel_for_each_match 在各个线程上直接回调，parallel_count 只计数，不保存匹配
+// 5. 块至少 1 MB、至少是重叠部分的 16 倍，重复扫描的比例可以忽略；线程数由线程池决定
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+bool same(const mystl::vector<mystl::ac_match>& a, const mystl::vector<mystl::ac_match>& b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].pattern != b[i].pattern || a[i].begin != b[i].begin || a[i].end != b[i].end) return false;
+    }
+    return true;
+}
+
+void print_row(const std::string& name, double ms, size_t bytes, size_t matches, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << ms << " ms" << std::setw(10)
+              << double(bytes) / ms / 1000 << " MB/s" << std::setw(10) << matches << " matches";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: 正确性，块边界上的匹配
+// =====================================================
+void test01_correctness()
+{
+    printSeparator("测试01: 与单线程查找逐项比较");
+
+    // 只有 a / b 两种字符，匹配很密，每个块边界上都有跨块的匹配
+    std::mt19937 rng(5);
+    std::string text((3 << 20) + 17, 'a');
+    for (char& c : text) c = "ab"[rng() % 2];
+    const char* b = text.data();
+    const char* e = b + text.size();
+    const std::string p = "abbabaab";
+    const mystl::searcher<char> s(p.begin(), p.end());
+    const mystl::kmp_searcher<char> ks(p.begin(), p.end());
+    const mystl::aho_corasick ac({"a", "ab", "bab", "abbabaab", "bbbbbbbbbbbbbbbb"});
+
+    mystl::vector<mystl::ac_match> ref;
+    for (const char* it = b; (it = mystl::search(it, e, s)) != e; ++it)
+        ref.push_back(mystl::ac_match{0, size_t(it - b), size_t(it - b) + p.size()});
+    const mystl::vector<mystl::ac_match> ac_ref = ac.find_all(b, e);
+
+    for (size_t threads : {1, 3, 4, 16}) {
+        mystl::thread_pool pool(threads);
+        std::atomic<size_t> streamed{0};
+        mystl::parallel_for_each_match(pool, b, e, ac, [&](const mystl::ac_match&) { ++streamed; });
+        const bool ok = same(mystl::parallel_find_all(pool, b, e, s), ref) && same(mystl::parallel_find_all(pool, b, e, ks), ref) &&
+                        same(mystl::parallel_find_all(pool, b, e, ac), ac_ref) &&
+                        mystl::parallel_count(pool, b, e, s) == ref.size() && streamed == ac_ref.size();
+        std::cout << "threads = " << std::setw(2) << threads << "  matches = " << ref.size() << " / " << ac_ref.size()
+                  << (ok ? "  OK" : "  FAILED") << std::endl;
+    }
+}
+
+// =====================================================
+// 测试02: 单模式，线程数扩展性
+// =====================================================
+void test02_scaling(const std::string& log)
+{
+    printSeparator("测试02: 在 " + std::to_string(log.size() >> 20) + " MB 日志中统计 \"status=503\" (硬件线程 = " +
+                   std::to_string(std::thread::hardware_concurrency()) + ")");
+
+    const char* b = log.data();
+    const char* e = b + log.size();
+    const std::string p = "status=503";
+    const mystl::searcher<char> s(p.begin(), p.end());
+
+    // 现在的做法: 单线程循环 kmp_search
+    size_t n0 = 0;
+    const double t0 = best_of_ms(1, [&] {
+        n0 = 0;
+        for (const char* it = b; (it = mystl::kmp_search(it, e, p.c_str(), p.c_str() + p.size())) != e; ++it) ++n0;
+    });
+    print_row("kmp_search loop, 1 thread", t0, log.size(), n0, 0);
+
+    // 内存带宽的参考: 找一个日志中没有的字节，memchr 读一遍整个缓冲区
+    const char tilde[] = "~";
+    const mystl::searcher<char> roof(tilde, tilde + 1);
+
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        mystl::thread_pool pool(threads);
+        size_t n = 0, n_roof = 0;
+        const double t = best_of_ms(3, [&] { n = mystl::parallel_count(pool, b, e, s); });
+        const double t_roof = best_of_ms(3, [&] { n_roof = mystl::parallel_count(pool, b, e, roof); });
+        print_row("parallel_count, threads = " + std::to_string(threads), t, log.size(), n, t0);
+        print_row("  memchr pass (bandwidth roof)", t_roof, log.size(), n_roof, 0);
+        if (n != n0) std::cout << "count differs: " << n << " vs " << n0 << std::endl;
+    }
+}
+
+// =====================================================
+// 测试03: 2000 个签名，有序结果 / 无序回调 / 只计数
+// =====================================================
+void test03_multi(const std::string& log)
+{
+    printSeparator("测试03: 在 " + std::to_string(log.size() >> 20) + " MB 日志中查找 2000 个签名");
+
+    const char* b = log.data();
+    const char* e = b + log.size();
+    const mystl::aho_corasick ac(make_signatures(2000));
+
+    size_t n0 = 0;
+    const double t0 = best_of_ms(1, [&] { n0 = ac.find_all(b, e).size(); });
+    print_row("find_all, 1 thread", t0, log.size(), n0, 0);
+
+    for (size_t threads : {1, 4, 16}) {
+        mystl::thread_pool pool(threads);
+        size_t n1 = 0, n3 = 0;
+        std::atomic<size_t> n2{0};
+        const double t1 = best_of_ms(1, [&] { n1 = mystl::parallel_find_all(pool, b, e, ac).size(); });
+        const double t2 = best_of_ms(1, [&] {
+            n2 = 0;
+            mystl::parallel_for_each_match(pool, b, e, ac, [&](const mystl::ac_match&) { n2.fetch_add(1, std::memory_order_relaxed); });
+        });
+        const double t3 = best_of_ms(1, [&] { n3 = mystl::parallel_count(pool, b, e, ac); });
+        const std::string suffix = ", threads = " + std::to_string(threads);
+        print_row("parallel_find_all" + suffix, t1, log.size(), n1, t0);
+        print_row("parallel_for_each_match" + suffix, t2, log.size(), n2, t0);
+        print_row("parallel_count" + suffix, t3, log.size(), n3, t0);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+
+    test01_correctness();
+
+    const std::string log = make_log(mb << 20);
+    test02_scaling(log);
+    test03_multi(log);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 只有 1 个硬件线程的虚拟机; 1 GB 日志):
+
+
+========== 测试01: 与单线程查找逐项比较 ==========
+
+threads =  1  matches = 12240 / 2764145  OK
+threads =  3  matches = 12240 / 2764145  OK
+threads =  4  matches = 12240 / 2764145  OK
+threads = 16  matches = 12240 / 2764145  OK
+
+========== 测试02: 在 1024 MB 日志中统计 "status=503" (硬件线程 = 1) ==========
+
+kmp_search loop, 1 thread                  2639.81 ms    406.75 MB/s   1177994 matches
+parallel_count, threads = 1                 712.17 ms   1507.69 MB/s   1177994 matches   (3.71x)
+  memchr pass (bandwidth roof)              115.00 ms   9337.17 MB/s         0 matches
+parallel_count, threads = 2                 743.66 ms   1443.87 MB/s   1177994 matches   (3.55x)
+  memchr pass (bandwidth roof)              122.79 ms   8744.71 MB/s         0 matches
+parallel_count, threads = 4                 717.20 ms   1497.12 MB/s   1177994 matches   (3.68x)
+  memchr pass (bandwidth roof)              119.93 ms   8953.37 MB/s         0 matches
+parallel_count, threads = 8                 740.04 ms   1450.92 MB/s   1177994 matches   (3.57x)
+  memchr pass (bandwidth roof)              119.48 ms   8986.47 MB/s         0 matches
+parallel_count, threads = 16                742.89 ms   1445.36 MB/s   1177994 matches   (3.55x)
+  memchr pass (bandwidth roof)              126.35 ms   8497.98 MB/s         0 matches
+
+========== 测试03: 在 1024 MB 日志中查找 2000 个签名 ==========
+
+find_all, 1 thread                         7037.61 ms    152.57 MB/s   6289823 matches
+parallel_find_all, threads = 1             6140.01 ms    174.88 MB/s   6289823 matches   (1.15x)
+parallel_for_each_match, threads = 1       5543.90 ms    193.68 MB/s   6289823 matches   (1.27x)
+parallel_count, threads = 1                4650.08 ms    230.91 MB/s   6289823 matches   (1.51x)
+parallel_find_all, threads = 4             5345.03 ms    200.89 MB/s   6289823 matches   (1.32x)
+parallel_for_each_match, threads = 4       5387.74 ms    199.29 MB/s   6289823 matches   (1.31x)
+parallel_count, threads = 4                4249.91 ms    252.65 MB/s   6289823 matches   (1.66x)
+parallel_find_all, threads = 16            5347.18 ms    200.81 MB/s   6289823 matches   (1.32x)
+parallel_for_each_match, threads = 16      5177.18 ms    207.40 MB/s   6289823 matches   (1.36x)
+parallel_count, threads = 16               4653.02 ms    230.76 MB/s   6289823 matches   (1.51x)
+
+单核机器上各个线程数的时间基本相同，测试02 相对 kmp_search 的提升来自 mystl::searcher (BMH)，
+测试03 的差别主要是 find_all 的结果数组反复扩容；线程数增加时时间不变，说明分块、重叠扫描和拼接本身的开销很小。
+多核机器上请重新运行: parallel_count 的吞吐量随线程数上升，直到接近 memchr 那一行的带宽上限。
+*/
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "mystl/algorithm.h"
+#include "mystl/execution.h"
+#include "mystl/thread_pool.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 执行策略要点
+// =====================================================
+// 1. seq: 普通循环; unseq: 块内循环标记为无依赖 (GCC ivdep)，归约用 8 个独立累加器
+// 2. par: 随机访问区间按块切分交给工作窃取线程池，当前线程处理第 0 块
+// 3. par_unseq: par 的每一块内部再按 unseq 执行
+// 4. 浮点归约结果取决于合并顺序；par.deterministic() 按固定 grain 分块、按块序合并，
+//    结果只取决于输入，与线程数无关
+// 5. find_if 并行时用原子变量记录已找到的最小下标，更靠后的块提前退出
+// =====================================================
+
+namespace ex = mystl::execution;
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// =====================================================
+// 测试01: 正确性 - 各策略与顺序版本结果一致
+// =====================================================
+template <typename Policy>
+bool check_policy(const Policy& policy)
+{
+    std::mt19937 rng(7);
+    bool ok = true;
+    for (size_t n : {0, 1, 15, 1000, 100003, 1000000}) {
+        mystl::vector<int> v;
+        for (size_t i = 0; i < n; ++i) v.push_back(static_cast<int>(rng() % 1000));
+        long long sum = std::accumulate(v.begin(), v.end(), 0LL);
+        ok = ok && mystl::reduce(policy, v.begin(), v.end(), 0LL) == sum;
+        ok = ok && mystl::transform_reduce(policy, v.begin(), v.end(), v.begin(), 0LL)
+                       == std::inner_product(v.begin(), v.end(), v.begin(), 0LL);
+        ok = ok && mystl::count_if(policy, v.begin(), v.end(), [](int x) { return x < 10; })
+                       == std::count_if(v.begin(), v.end(), [](int x) { return x < 10; });
+
+        mystl::vector<int> out(n);
+        mystl::transform(policy, v.begin(), v.end(), out.begin(), [](int x) { return x * 2; });
+        mystl::for_each(policy, out.begin(), out.end(), [](int& x) { x += 1; });
+        for (size_t i = 0; i < n; ++i) ok = ok && out[i] == v[i] * 2 + 1;
+
+        for (int target : {-1, 0, 999}) {
+            auto pred = [target](int x) { return x == target; };
+            ok = ok && mystl::find_if(policy, v.begin(), v.end(), pred) == std::find_if(v.begin(), v.end(), pred);
+            ok = ok && mystl::any_of(policy, v.begin(), v.end(), pred) == std::any_of(v.begin(), v.end(), pred);
+        }
+    }
+    return ok;
+}
+
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    mystl::thread_pool pool(4);
+    std::cout << "seq                 : " << (check_policy(ex::seq) ? "OK" : "FAILED") << std::endl;
+    std::cout << "unseq               : " << (check_policy(ex::unseq) ? "OK" : "FAILED") << std::endl;
+    std::cout << "par (4 线程)        : " << (check_policy(ex::par.on(pool)) ? "OK" : "FAILED") << std::endl;
+    std::cout << "par_unseq (4 线程)  : " << (check_policy(ex::par_unseq.on(pool)) ? "OK" : "FAILED") << std::endl;
+    std::cout << "par deterministic   : " << (check_policy(ex::par.on(pool).deterministic()) ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02: 确定性归约 - 不同线程数下的浮点求和结果
+// =====================================================
+void test02_deterministic()
+{
+    printSeparator("测试02: 浮点求和与线程数");
+
+    mystl::vector<double> data;
+    for (int i = 0; i < 1000003; ++i) data.push_back(std::sin(i) * 1e6);
+
+    std::cout << std::setprecision(17);
+    for (size_t threads : {1, 2, 3, 8}) {
+        mystl::thread_pool pool(threads);
+        double a = mystl::reduce(ex::par.on(pool), data.begin(), data.end(), 0.0);
+        double b = mystl::reduce(ex::par.on(pool).deterministic(), data.begin(), data.end(), 0.0);
+        std::cout << "threads = " << threads << "  par: " << std::setw(24) << a
+                  << "  par.deterministic(): " << std::setw(24) << b << std::endl;
+    }
+}
+
+// =====================================================
+// 测试03: 吞吐量 - 各算法在四种策略下的耗时
+// =====================================================
+void test03_throughput(size_t n)
+{
+    printSeparator("测试03: 吞吐量 (n = " + std::to_string(n) + ", 硬件线程 = "
+                   + std::to_string(std::thread::hardware_concurrency()) + ")");
+
+    mystl::vector<float> a, b;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    for (size_t i = 0; i < n; ++i) {
+        a.push_back(dist(rng));
+        b.push_back(dist(rng));
+    }
+    mystl::vector<float> out(n);
+
+    // 对四种策略分别计时
+    auto row = [&](const char* name, auto&& run) {
+        std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << best_of_ms(5, [&] { run(ex::seq); })
+                  << std::setw(10) << best_of_ms(5, [&] { run(ex::unseq); })
+                  << std::setw(10) << best_of_ms(5, [&] { run(ex::par); })
+                  << std::setw(12) << best_of_ms(5, [&] { run(ex::par_unseq); })
+                  << std::endl;
+    };
+
+    std::cout << std::left << std::setw(18) << "algorithm" << std::right << std::setw(10) << "seq"
+              << std::setw(10) << "unseq" << std::setw(10) << "par" << std::setw(12) << "par_unseq" << "   (ms)" << std::endl;
+
+    row("for_each", [&](const auto& p) {
+        mystl::for_each(p, out.begin(), out.end(), [](float& x) { x = x * 0.5f + 1.0f; });
+    });
+    row("transform", [&](const auto& p) {
+        mystl::transform(p, a.begin(), a.end(), b.begin(), out.begin(), [](float x, float y) { return x * y + 1.0f; });
+    });
+    row("reduce", [&](const auto& p) {
+        do_not_optimize(mystl::reduce(p, a.begin(), a.end(), 0.0f));
+    });
+    row("transform_reduce", [&](const auto& p) {
+        do_not_optimize(mystl::transform_reduce(p, a.begin(), a.end(), b.begin(), 0.0f));
+    });
+    row("count_if", [&](const auto& p) {
+        do_not_optimize(mystl::count_if(p, a.begin(), a.end(), [](float x) { return x < 0.25f; }));
+    });
+    row("find_if (miss)", [&](const auto& p) {
+        do_not_optimize(mystl::find_if(p, a.begin(), a.end(), [](float x) { return x > 2.0f; }));
+    });
+    row("any_of (miss)", [&](const auto& p) {
+        do_not_optimize(mystl::any_of(p, a.begin(), a.end(), [](float x) { return x < 0.0f; }));
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    test01_correctness();
+    test02_deterministic();
+    test03_throughput(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, n = 10000000, 单核机器，par 与 seq 持平属预期):
+
+========== 测试02: 浮点求和与线程数 ==========
+
+threads = 1  par:       1479472.9027959928  par.deterministic():       1479472.9027960373
+threads = 2  par:       1479472.9027959495  par.deterministic():       1479472.9027960373
+threads = 3  par:       1479472.9027960135  par.deterministic():       1479472.9027960373
+threads = 8  par:       1479472.9027959779  par.deterministic():       1479472.9027960373
+
+========== 测试03: 吞吐量 (n = 10000000, 硬件线程 = 1) ==========
+
+algorithm                seq     unseq       par   par_unseq   (ms)
+for_each                2.28      1.93      1.78        1.76
+transform               7.86      7.88      8.82        8.50
+reduce                  8.32      1.50      7.94        1.51
+transform_reduce        8.90      5.27      8.75        5.59
+count_if                3.77      2.24      2.22        2.21
+find_if (miss)          5.77      1.74      5.67        1.94
+any_of (miss)           7.28      1.80      5.90        1.95
+*/
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mystl/algorithm.h"
+#include "mystl/execution.h"
+#include "mystl/thread_pool.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 前缀和 (scan) 要点
+// =====================================================
+// 1. inclusive_scan: out[i] = in[0] + ... + in[i]；exclusive_scan: out[i] = init + in[0] + ... + in[i-1]
+//    典型用途: CSR 的行偏移 (exclusive_scan 度数)、基数排序的桶起始位置、流压缩的写入位置
+// 2. 朴素循环每个元素都依赖上一个结果，编译器无法向量化
+// 3. SIMD (unseq): 寄存器内移位相加 log2(W) 次得到 W 个元素的前缀和，再加上广播的进位；
+//    循环间只有一次向量加法的依赖。AVX2 的字节移位不跨 128 位，需要额外把低半边的和加到高半边
+// 4. 并行 (par): 两遍扫描 —— 各块并行求和 -> 块和串行 exclusive scan 得到块起始值 -> 各块并行扫描。
+//    读两遍写一遍，比顺序版本多 50% 的访存，只有核数足够时才划算
+// 5. 数据远大于缓存时瓶颈在内存带宽，SIMD 的优势只在数据能放进缓存时明显
+// 6. 吞吐量按 读 + 写 = 2 * n * sizeof(T) 字节计算
+// =====================================================
+
+namespace ex = mystl::execution;
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// =====================================================
+// 测试01: 正确性 - 与 std::inclusive_scan / std::exclusive_scan 对比
+// =====================================================
+template <typename T, typename Policy>
+bool check_scan(const Policy& policy)
+{
+    std::mt19937 rng(11);
+    bool ok = true;
+    for (size_t n : {0, 1, 3, 7, 8, 9, 31, 100, 4097, 100003}) {
+        mystl::vector<T> v(n);
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(rng() % 100);
+        std::vector<T> inc(n), exc(n);
+        std::inclusive_scan(v.begin(), v.end(), inc.begin());
+        std::exclusive_scan(v.begin(), v.end(), exc.begin(), T(3));
+
+        mystl::vector<T> out(n);
+        ok = ok && mystl::inclusive_scan(policy, v.begin(), v.end(), out.begin()) == out.end();
+        for (size_t i = 0; i < n; ++i) ok = ok && out[i] == inc[i];
+        mystl::exclusive_scan(policy, v.begin(), v.end(), out.begin(), T(3));
+        for (size_t i = 0; i < n; ++i) ok = ok && out[i] == exc[i];
+        mystl::transform_exclusive_scan(policy, v.begin(), v.end(), out.begin(), T(3), std::plus<>(),
+                                        [](T x) { return static_cast<T>(x * 2); });
+        for (size_t i = 0; i < n; ++i) ok = ok && out[i] == static_cast<T>(exc[i] * 2 - 3);
+
+        // 原地
+        mystl::exclusive_scan(policy, v.begin(), v.end(), v.begin(), T(3));
+        for (size_t i = 0; i < n; ++i) ok = ok && v[i] == exc[i];
+    }
+    return ok;
+}
+
+template <typename Policy>
+bool check_all(const Policy& policy)
+{
+    return check_scan<int32_t>(policy) && check_scan<uint32_t>(policy) && check_scan<int64_t>(policy)
+        && check_scan<float>(policy) && check_scan<double>(policy) && check_scan<short>(policy);
+}
+
+void test01_correctness()
+{
+    printSeparator("测试01: 正确性");
+
+    mystl::thread_pool pool(4);
+    std::cout << "seq                     : " << (check_all(ex::seq) ? "OK" : "FAILED") << std::endl;
+    std::cout << "unseq                   : " << (check_all(ex::unseq) ? "OK" : "FAILED") << std::endl;
+    std::cout << "par (4 threads)         : " << (check_all(ex::par.on(pool).grain(1000)) ? "OK" : "FAILED") << std::endl;
+    std::cout << "par_unseq (4 threads)   : " << (check_all(ex::par_unseq.on(pool).grain(1000)) ? "OK" : "FAILED") << std::endl;
+}
+
+// =====================================================
+// 测试02 / 03: 吞吐量 (GB/s)，数据在缓存内 / 远大于缓存
+// =====================================================
+template <typename T>
+void naive_inclusive(const T* in, T* out, size_t n)
+{
+    T sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += in[i];
+        out[i] = sum;
+    }
+}
+
+template <typename T>
+void bench_row(const char* name, size_t n, bool exclusive)
+{
+    mystl::vector<T> in(n), out(n);
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < n; ++i) in[i] = static_cast<T>(rng() % 16);
+
+    const double bytes = 2.0 * n * sizeof(T);
+    auto gbps = [bytes](double ms) { return bytes / (ms * 1e6); };
+    auto run = [&](const auto& policy) {
+        return gbps(best_of_ms(5, [&] {
+            if (exclusive) mystl::exclusive_scan(policy, in.begin(), in.end(), out.begin(), T(0));
+            else mystl::inclusive_scan(policy, in.begin(), in.end(), out.begin());
+            do_not_optimize(out[n - 1]);
+        }));
+    };
+
+    double naive = gbps(best_of_ms(5, [&] {
+        naive_inclusive(in.data(), out.data(), n);
+        do_not_optimize(out[n - 1]);
+    }));
+    double std_scan = gbps(best_of_ms(5, [&] {
+        if (exclusive) std::exclusive_scan(in.begin(), in.end(), out.begin(), T(0));
+        else std::inclusive_scan(in.begin(), in.end(), out.begin());
+        do_not_optimize(out[n - 1]);
+    }));
+
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << naive << std::setw(8) << std_scan
+              << std::setw(8) << run(ex::seq) << std::setw(8) << run(ex::unseq)
+              << std::setw(8) << run(ex::par) << std::setw(11) << run(ex::par_unseq) << std::endl;
+}
+
+void test_throughput(const std::string& title, size_t n)
+{
+    printSeparator(title + " (n = " + std::to_string(n) + ", 硬件线程 = "
+                   + std::to_string(std::thread::hardware_concurrency()) + ")");
+
+    std::cout << std::left << std::setw(22) << "type" << std::right << std::setw(8) << "naive" << std::setw(8) << "std"
+              << std::setw(8) << "seq" << std::setw(8) << "unseq" << std::setw(8) << "par" << std::setw(11) << "par_unseq"
+              << "   (GB/s)" << std::endl;
+
+    bench_row<int32_t>("int32 inclusive", n, false);
+    bench_row<uint32_t>("uint32 exclusive (CSR)", n, true);
+    bench_row<int64_t>("int64 inclusive", n, false);
+    bench_row<float>("float inclusive", n, false);
+    bench_row<double>("double inclusive", n, false);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    test01_correctness();
+    test_throughput("测试02: 吞吐量 - 缓存内", 1 << 16);
+    test_throughput("测试03: 吞吐量 - 内存带宽", n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, AVX2, 单核机器，par 多读一遍输入、慢于 seq 属预期;
+64 位元素每个元素约需一次跨通道 shuffle，缓存内 SIMD 与标量持平甚至略慢):
+
+========== 测试02: 吞吐量 - 缓存内 (n = 65536, 硬件线程 = 1) ==========
+
+type                     naive     std     seq   unseq     par  par_unseq   (GB/s)
+int32 inclusive          22.34   22.34   22.34   37.87   17.65      26.49
+uint32 exclusive (CSR)   22.34   22.34   22.34   37.42   17.63      26.38
+int64 inclusive          43.23   42.17   42.15   37.43   29.01      28.61
+float inclusive          11.19   11.19   11.19   32.46    5.60      23.64
+double inclusive         22.18   22.26   22.29   37.43   11.18      28.74
+
+========== 测试03: 吞吐量 - 内存带宽 (n = 10000000, 硬件线程 = 1) ==========
+
+type                     naive     std     seq   unseq     par  par_unseq   (GB/s)
+int32 inclusive           9.80    9.93    9.10   12.01    7.70      10.53
+uint32 exclusive (CSR)    9.42    9.11    9.13   11.64    6.82       9.04
+int64 inclusive           9.98   10.38   10.22   10.60    6.58       7.29
+float inclusive           8.35    8.43    8.48   11.24    4.57       7.53
+double inclusive          8.76    8.97   10.14   11.32    5.80       6.59
+*/
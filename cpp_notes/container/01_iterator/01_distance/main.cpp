@@ -0,0 +1,117 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <string>
+
+#include "mystl/algorithm.h"
+#include "mystl/deque.h"
+#include "mystl/iterator.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 迭代器类别要点
+// =====================================================
+// 1. 五种类别: input -> forward -> bidirectional -> random_access (-> contiguous)，
+//    标签类之间是继承关系，重载按最接近的基类匹配
+// 2. mystl::iterator_traits<Iter> 取迭代器的成员类型；原生指针特化为 contiguous
+// 3. distance / advance / next / prev 按类别分派: 随机访问 O(1)，其余逐个移动 O(n)
+// 4. deque 迭代器跨 buffer 时要先换算节点再定位，但 operator- / operator+= 仍是 O(1)
+// 5. 迭代器声明了 iterator_category 之后，std::distance / std::sort 等标准库算法也能用
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 逐个前进计数，相当于输入迭代器的 distance
+template <typename Iter>
+std::ptrdiff_t step_distance(Iter first, Iter last)
+{
+    std::ptrdiff_t n = 0;
+    for (; first != last; ++first) ++n;
+    return n;
+}
+
+// =====================================================
+// 测试01: 类别推导
+// =====================================================
+void test01_category()
+{
+    printSeparator("测试01: 类别推导");
+
+    using deque_iter = mystl::deque<int>::iterator;
+    using list_iter = std::list<int>::iterator;
+    std::cout << std::boolalpha;
+    std::cout << "int*                random_access: " << mystl::is_random_access_iterator<int*>::value
+              << "  contiguous: " << mystl::is_contiguous_iterator<int*>::value << std::endl;
+    std::cout << "deque::iterator     random_access: " << mystl::is_random_access_iterator<deque_iter>::value
+              << "  contiguous: " << mystl::is_contiguous_iterator<deque_iter>::value << std::endl;
+    std::cout << "std::list::iterator random_access: " << mystl::is_random_access_iterator<list_iter>::value
+              << "  bidirectional: " << mystl::is_bidirectional_iterator<list_iter>::value << std::endl;
+}
+
+// =====================================================
+// 测试02: distance / advance 耗时
+// =====================================================
+void test02_distance(size_t n)
+{
+    printSeparator("测试02: distance / advance (n = " + std::to_string(n) + ")");
+
+    mystl::deque<int> d(n, 1);
+    std::list<int> l(n, 1);
+    const auto half = static_cast<std::ptrdiff_t>(n / 2);
+
+    auto row = [](const char* name, double ms, std::ptrdiff_t result) {
+        std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << ms * 1e6 << std::setw(12) << result << std::endl;
+    };
+
+    std::cout << std::left << std::setw(36) << "operation" << std::right << std::setw(16) << "time (ns)"
+              << std::setw(12) << "result" << std::endl;
+
+    std::ptrdiff_t r = 0;
+    double t = best_of_ms(5, [&] { r = step_distance(d.begin(), d.end()); do_not_optimize(r); });
+    row("deque  step-by-step distance", t, r);
+    t = best_of_ms(5, [&] { r = mystl::distance(d.begin(), d.end()); do_not_optimize(r); });
+    row("deque  mystl::distance", t, r);
+    t = best_of_ms(5, [&] { r = std::distance(d.begin(), d.end()); do_not_optimize(r); });
+    row("deque  std::distance", t, r);
+    t = best_of_ms(5, [&] { auto it = d.begin(); mystl::advance(it, half); r = *it + (it - d.begin()) - 1; do_not_optimize(r); });
+    row("deque  mystl::advance(n / 2)", t, r);
+    t = best_of_ms(5, [&] { r = mystl::distance(l.begin(), l.end()); do_not_optimize(r); });
+    row("list   mystl::distance", t, r);
+    t = best_of_ms(5, [&] { auto it = l.begin(); mystl::advance(it, half); r = *it + half - 1; do_not_optimize(r); });
+    row("list   mystl::advance(n / 2)", t, r);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    test01_category();
+    test02_distance(n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3; O(1) 的几十纳秒基本是计时本身的开销):
+
+========== 测试01: 类别推导 ==========
+
+int*                random_access: true  contiguous: true
+deque::iterator     random_access: true  contiguous: false
+std::list::iterator random_access: false  bidirectional: true
+
+========== 测试02: distance / advance (n = 10000000) ==========
+
+operation                                  time (ns)      result
+deque  step-by-step distance               7335170.0    10000000
+deque  mystl::distance                          44.0    10000000
+deque  std::distance                            35.0    10000000
+deque  mystl::advance(n / 2)                    35.0     5000000
+list   mystl::distance                    47535696.0    10000000
+list   mystl::advance(n / 2)              24895725.0     5000000
+*/
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mystl/small_vector.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// small_vector 要点
+// =====================================================
+// 1. mystl::vector 第一次 push_back 就申请堆内存，容量 0 -> 1 -> 2 -> 4 -> 8，
+//    装 5 个元素要 malloc / free 4 次
+// 2. small_vector<T, N> 在对象内部预留 N 个元素的空间，不超过 N 个元素时完全不申请堆内存
+// 3. 超过 N 后从 2N 开始按 2 倍扩容，与 vector 相同；shrink_to_fit 可以搬回内联缓冲区
+// 4. 代价: 对象变大 (N * sizeof(T))，移动时内联元素要逐个移动
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 统计 allocate 次数的分配器
+static size_t g_alloc_count = 0;
+
+template <typename Tp>
+struct counting_alloc : std::allocator<Tp>
+{
+    template <typename U> struct rebind { using other = counting_alloc<U>; };
+
+    counting_alloc() = default;
+    template <typename U> counting_alloc(const counting_alloc<U>&) {}
+
+    Tp* allocate(size_t n)
+    {
+        ++g_alloc_count;
+        return std::allocator<Tp>::allocate(n);
+    }
+};
+
+using value_t = std::uint64_t;
+
+// 构造一个含 k 个元素的列表、遍历一遍、析构
+template <typename Vec>
+value_t build_list(size_t k)
+{
+    Vec v;
+    for (size_t i = 0; i < k; ++i) v.push_back(static_cast<value_t>(i));
+    value_t sum = 0;
+    for (auto x : v) sum += x;
+    return sum;
+}
+
+// =====================================================
+// 测试01: 固定长度 - 每个列表的堆分配次数与耗时
+// =====================================================
+template <typename Vec>
+void fixed_row(const char* name, size_t rounds)
+{
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1);
+    for (size_t k : {2, 6, 12, 24}) {
+        g_alloc_count = 0;
+        build_list<Vec>(k);
+        size_t allocs = g_alloc_count;
+        double ms = best_of_ms(5, [&] {
+            value_t sum = 0;
+            for (size_t r = 0; r < rounds; ++r) sum += build_list<Vec>(k);
+            do_not_optimize(sum);
+        });
+        std::cout << std::setw(6) << allocs << std::setw(8) << ms * 1e6 / rounds;
+    }
+    std::cout << std::endl;
+}
+
+void test01_fixed(size_t rounds)
+{
+    printSeparator("测试01: 固定长度 (allocs / ns per list)");
+
+    std::cout << std::left << std::setw(22) << "container" << std::right;
+    for (const char* k : {"k=2", "k=6", "k=12", "k=24"}) std::cout << std::setw(14) << k;
+    std::cout << std::endl;
+
+    fixed_row<mystl::vector<value_t, counting_alloc<value_t>>>("mystl::vector", rounds);
+    fixed_row<std::vector<value_t, counting_alloc<value_t>>>("std::vector", rounds);
+    fixed_row<mystl::small_vector<value_t, 4, counting_alloc<value_t>>>("small_vector<4>", rounds);
+    fixed_row<mystl::small_vector<value_t, 8, counting_alloc<value_t>>>("small_vector<8>", rounds);
+    fixed_row<mystl::small_vector<value_t, 16, counting_alloc<value_t>>>("small_vector<16>", rounds);
+}
+
+// =====================================================
+// 测试02: 长度随机 (大多数少于 8 个) - 平均分配次数与耗时
+// =====================================================
+template <typename Vec>
+void mixed_row(const char* name, const std::vector<size_t>& lengths)
+{
+    g_alloc_count = 0;
+    value_t sum = 0;
+    for (size_t k : lengths) sum += build_list<Vec>(k);
+    do_not_optimize(sum);
+    double allocs = static_cast<double>(g_alloc_count) / lengths.size();
+
+    double ms = best_of_ms(5, [&] {
+        value_t s = 0;
+        for (size_t k : lengths) s += build_list<Vec>(k);
+        do_not_optimize(s);
+    });
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << allocs << std::setw(12) << ms * 1e6 / lengths.size()
+              << std::setw(12) << sizeof(Vec) << std::endl;
+}
+
+void test02_mixed(size_t rounds)
+{
+    printSeparator("测试02: 随机长度 (几何分布，均值约 5，最长 64)");
+
+    std::mt19937 rng(5);
+    std::geometric_distribution<size_t> dist(0.2);
+    std::vector<size_t> lengths(rounds);
+    for (auto& k : lengths) k = std::min<size_t>(1 + dist(rng), 64);
+
+    std::cout << std::left << std::setw(22) << "container" << std::right << std::setw(12) << "allocs"
+              << std::setw(12) << "ns/list" << std::setw(12) << "sizeof" << std::endl;
+    mixed_row<mystl::vector<value_t, counting_alloc<value_t>>>("mystl::vector", lengths);
+    mixed_row<std::vector<value_t, counting_alloc<value_t>>>("std::vector", lengths);
+    mixed_row<mystl::small_vector<value_t, 4, counting_alloc<value_t>>>("small_vector<4>", lengths);
+    mixed_row<mystl::small_vector<value_t, 8, counting_alloc<value_t>>>("small_vector<8>", lengths);
+    mixed_row<mystl::small_vector<value_t, 16, counting_alloc<value_t>>>("small_vector<16>", lengths);
+}
+
+// =====================================================
+// 测试03: shrink_to_fit 搬回内联缓冲区
+// =====================================================
+void test03_shrink()
+{
+    printSeparator("测试03: shrink_to_fit");
+
+    mystl::small_vector<std::string, 4> v;
+    for (int i = 0; i < 10; ++i) v.push_back("item" + std::to_string(i));
+    std::cout << "push 10:        size = " << v.size() << ", capacity = " << v.capacity()
+              << ", inline = " << std::boolalpha << v.is_inline() << std::endl;
+    while (v.size() > 3) v.pop_back();
+    std::cout << "pop to 3:       size = " << v.size() << ", capacity = " << v.capacity()
+              << ", inline = " << v.is_inline() << std::endl;
+    v.shrink_to_fit();
+    std::cout << "shrink_to_fit:  size = " << v.size() << ", capacity = " << v.capacity()
+              << ", inline = " << v.is_inline() << ", v[2] = " << v[2] << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_fixed(rounds);
+    test02_mixed(rounds);
+    test03_shrink();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 每个列表构造 + 遍历 + 析构):
+
+========== 测试01: 固定长度 (allocs / ns per list) ==========
+
+container                        k=2           k=6          k=12          k=24
+mystl::vector              2    39.4     4    94.0     5   110.2     6   154.1
+std::vector                2    50.0     4    99.6     5   111.2     6   165.3
+small_vector<4>            0    13.0     1    38.4     2    49.7     3    89.4
+small_vector<8>            0    11.9     0    16.2     1    53.4     2    82.2
+small_vector<16>           0    11.7     0    14.8     0    19.6     1    59.9
+
+========== 测试02: 随机长度 (几何分布，均值约 5，最长 64) ==========
+
+container                   allocs     ns/list      sizeof
+mystl::vector                 3.05       81.76          32
+std::vector                   3.05       80.43          24
+small_vector<4>               0.61       29.99          64
+small_vector<8>               0.20       23.77          96
+small_vector<16>              0.03       20.42         160
+
+========== 测试03: shrink_to_fit ==========
+
+push 10:        size = 10, capacity = 16, inline = false
+pop to 3:       size = 3, capacity = 16, inline = false
+shrink_to_fit:  size = 3, capacity = 4, inline = true, v[2] = item2
+*/
@@ -0,0 +1,154 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <malloc.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mystl/basic_string.h"
+#include "mystl/type_traits.h"
+#include "mystl/unique_ptr.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 平凡重定位 (trivially relocatable) 要点
+// =====================================================
+// 1. vector 扩容 / insert / erase 本质上是把元素搬到另一个地址：移动构造到新位置 + 析构旧对象
+// 2. 如果对象不保存指向自身的指针，搬动等价于按字节拷贝，之后旧对象不再析构即可，
+//    整段元素一次 memcpy / memmove 完成
+// 3. mystl::is_trivially_relocatable: 可平凡拷贝的类型默认满足；mystl 的 string、unique_ptr、
+//    shared_ptr、vector、deque 特化为 true；small_vector 的内联缓冲区会被 data_ 指向，不满足
+// 4. std::string (libstdc++) 的短字符串模式保存指向自身缓冲区的指针，不能按字节搬动
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 与 mystl::string 布局相同，但没有声明可平凡重定位，vector 只能逐个移动构造 + 析构
+struct legacy_string
+{
+    mystl::string s;
+    explicit legacy_string(const char* str) : s(str) {}
+    legacy_string(legacy_string&& other) noexcept : s(std::move(other.s)) {}
+    legacy_string(const legacy_string& other) = default;
+    legacy_string& operator=(legacy_string&& other) noexcept { s = std::move(other.s); return *this; }
+};
+
+// 一半短字符串 (SSO)、一半需要堆内存的长字符串
+const char* sample(size_t i) { return i % 2 ? "short" : "a string that does not fit into SSO"; }
+
+template <typename Vec>
+Vec make_vec(size_t n)
+{
+    Vec v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) v.emplace_back(sample(i));
+    return v;
+}
+
+// =====================================================
+// 测试01: reserve - 1M 个字符串扩容一次
+// =====================================================
+template <typename Vec>
+double time_reserve(size_t n)
+{
+    Vec v;
+    return best_of_ms(5, [&] { v = make_vec<Vec>(n); }, [&] { v.reserve(2 * n); });
+}
+
+void reserve_rows(size_t n)
+{
+    double legacy = time_reserve<mystl::vector<legacy_string>>(n);
+    double fast = time_reserve<mystl::vector<mystl::string>>(n);
+    double std_ms = time_reserve<std::vector<std::string>>(n);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << "mystl::vector<legacy_string>" << std::right << std::setw(10) << legacy << " ms" << std::endl;
+    std::cout << std::left << std::setw(40) << "mystl::vector<mystl::string> (memcpy)" << std::right << std::setw(10) << fast
+              << " ms   (" << legacy / fast << "x)" << std::endl;
+    std::cout << std::left << std::setw(40) << "std::vector<std::string>" << std::right << std::setw(10) << std_ms << " ms" << std::endl;
+}
+
+void test01_reserve(size_t n)
+{
+    printSeparator("测试01: reserve (n = " + std::to_string(n) + ")");
+
+    std::cout << std::boolalpha;
+    std::cout << "is_trivially_relocatable<mystl::string> = " << mystl::is_trivially_relocatable_v<mystl::string> << std::endl;
+    std::cout << "is_trivially_relocatable<legacy_string> = " << mystl::is_trivially_relocatable_v<legacy_string> << std::endl;
+
+    // 大块内存默认每次都由 mmap 新申请，首次写入的缺页中断占了大部分时间，两种搬法差别被掩盖
+    std::cout << "\n[cold] 新缓冲区每次都是刚 mmap 的页:" << std::endl;
+    reserve_rows(n);
+
+    // 让 malloc 复用释放掉的内存，只比较搬动元素本身的开销
+    mallopt(M_MMAP_THRESHOLD, 1 << 30);
+    mallopt(M_TRIM_THRESHOLD, 1 << 30);
+    std::cout << "\n[warm] malloc 复用已经访问过的页:" << std::endl;
+    reserve_rows(n);
+}
+
+// =====================================================
+// 测试02: 在头部 insert / erase
+// =====================================================
+template <typename Vec>
+double time_insert_erase(size_t n, size_t ops)
+{
+    Vec v = make_vec<Vec>(n);
+    return best_of_ms(3, [&] {
+        for (size_t i = 0; i < ops; ++i) v.insert(0, sample(i));
+        for (size_t i = 0; i < ops; ++i) v.erase(0);
+    });
+}
+
+void test02_insert_erase(size_t n)
+{
+    const size_t ops = 100;
+    printSeparator("测试02: 头部 insert + erase 各 " + std::to_string(ops) + " 次 (n = " + std::to_string(n) + ")");
+
+    double legacy = time_insert_erase<mystl::vector<legacy_string>>(n, ops);
+    double fast = time_insert_erase<mystl::vector<mystl::string>>(n, ops);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << "mystl::vector<legacy_string>" << std::right << std::setw(10) << legacy << " ms" << std::endl;
+    std::cout << std::left << std::setw(40) << "mystl::vector<mystl::string> (memmove)" << std::right << std::setw(10) << fast
+              << " ms   (" << legacy / fast << "x)" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    test01_reserve(n);
+    test02_insert_erase(n / 10);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3; mystl::string 的移动构造本身很便宜，逐个搬动也已接近内存带宽，
+memcpy 的收益主要体现在 insert / erase 的整段平移上):
+
+========== 测试01: reserve (n = 1000000) ==========
+
+is_trivially_relocatable<mystl::string> = true
+is_trivially_relocatable<legacy_string> = false
+
+[cold] 新缓冲区每次都是刚 mmap 的页:
+mystl::vector<legacy_string>                 25.58 ms
+mystl::vector<mystl::string> (memcpy)        27.21 ms   (0.94x)
+std::vector<std::string>                     18.37 ms
+
+[warm] malloc 复用已经访问过的页:
+mystl::vector<legacy_string>                  7.52 ms
+mystl::vector<mystl::string> (memcpy)         6.20 ms   (1.21x)
+std::vector<std::string>                      6.73 ms
+
+========== 测试02: 头部 insert + erase 各 100 次 (n = 100000) ==========
+
+mystl::vector<legacy_string>                 59.30 ms
+mystl::vector<mystl::string> (memmove)       36.15 ms   (1.64x)
+*/
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mystl/page_allocator.h"
+#include "mystl/vector.h"
+
+// =====================================================
+// 页分配器与 mremap 扩容 要点
+// =====================================================
+// 1. 普通扩容：申请新块 -> 拷贝全部元素 -> 释放旧块。拷贝时新旧两份数据同时驻留，
+//    峰值约为扩容前数据量的 2 倍；拷贝几百 MB（连同新块的缺页中断）要几百毫秒
+// 2. mystl::page_allocator 大块直接用匿名 mmap，reallocate 用 mremap 调整大小：
+//    内核只移动页表项，数据不拷贝，旧的虚拟地址随即失效，不会出现两份数据
+// 3. mystl::vector 的分配器有 reallocate 且元素可平凡重定位时，reserve 直接调用 reallocate
+// 4. 扩容策略是 vector 的第三个模板参数：growth_double (默认)、growth_1_5x、growth_pages<Chunk>；
+//    mremap 不拷贝，按页线性增长也不会退化成 O(n^2)，多余的空间不超过一个 Chunk
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+using clock_type = std::chrono::steady_clock;
+
+double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+// 进程生命期内的最大常驻内存 (MB)
+double peak_rss_mb()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+// 只给触发扩容的那次 push_back 计时，其余 push_back 不受计时开销影响
+template <typename Vec>
+void run(const char* name, size_t n)
+{
+    Vec v;
+    size_t grows = 0;
+    double grow_total = 0, grow_worst = 0;
+
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < n; ++i) {
+        if (v.size() == v.capacity()) {
+            auto g0 = clock_type::now();
+            v.push_back(i);
+            double t = ms_since(g0);
+            ++grows;
+            grow_total += t;
+            if (t > grow_worst) grow_worst = t;
+        } else {
+            v.push_back(i);
+        }
+    }
+    double total = ms_since(t0);
+
+    // 校验，顺便防止被优化掉
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i += 4096) sum += v[i] - i;
+    if (sum != 0) std::cout << "wrong result!" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(34) << name << std::right
+              << std::setw(10) << total
+              << std::setw(8) << grows
+              << std::setw(12) << grow_total
+              << std::setw(12) << grow_worst
+              << std::setw(12) << peak_rss_mb()
+              << std::setw(12) << v.capacity() * sizeof(uint64_t) / (1024.0 * 1024.0) << std::endl;
+}
+
+// ru_maxrss 是整个进程的峰值，每种配置放到单独的子进程里跑
+template <typename Vec>
+void run_in_child(const char* name, size_t n)
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        run<Vec>(name, n);
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+void push_back_rows(size_t n)
+{
+    std::cout << std::left << std::setw(34) << "config" << std::right
+              << std::setw(10) << "total ms"
+              << std::setw(8) << "grows"
+              << std::setw(12) << "grow ms"
+              << std::setw(12) << "worst ms"
+              << std::setw(12) << "peak MB"
+              << std::setw(12) << "cap MB" << std::endl;
+
+    using page_alloc = mystl::page_allocator<uint64_t>;
+    run_in_child<std::vector<uint64_t>>("std::vector", n);
+    run_in_child<mystl::vector<uint64_t>>("std::allocator, 2x", n);
+    run_in_child<mystl::vector<uint64_t, std::allocator<uint64_t>, mystl::growth_1_5x>>("std::allocator, 1.5x", n);
+    run_in_child<mystl::vector<uint64_t, page_alloc>>("page_allocator, 2x", n);
+    run_in_child<mystl::vector<uint64_t, page_alloc, mystl::growth_1_5x>>("page_allocator, 1.5x", n);
+    run_in_child<mystl::vector<uint64_t, page_alloc, mystl::growth_pages<>>>("page_allocator, pages (2MB)", n);
+    run_in_child<mystl::vector<uint64_t, page_alloc, mystl::growth_pages<64 << 20>>>("page_allocator, pages (64MB)", n);
+}
+
+// =====================================================
+// 测试01: push_back 2^k 个 uint64_t
+// =====================================================
+// 最后一次 2 倍扩容刚好放满，普通扩容的峰值 (拷贝时的新旧两份) 恰好等于最终数据量
+void test01_power_of_two(int log2_n)
+{
+    size_t n = size_t(1) << log2_n;
+    printSeparator("测试01: push_back 2^" + std::to_string(log2_n) + " 个 uint64_t (" +
+                   std::to_string(n * sizeof(uint64_t) >> 20) + " MB)");
+    push_back_rows(n);
+}
+
+// =====================================================
+// 测试02: push_back 1.5 * 2^k 个 uint64_t
+// =====================================================
+// 一般情况：2^k 扩到 2^(k+1) 时拷贝 2^k 个元素，峰值比最终数据量多出 1/3
+void test02_one_and_half(int log2_n)
+{
+    size_t n = (size_t(3) << log2_n) / 2;
+    printSeparator("测试02: push_back 1.5 * 2^" + std::to_string(log2_n) + " 个 uint64_t (" +
+                   std::to_string(n * sizeof(uint64_t) >> 20) + " MB)");
+    push_back_rows(n);
+}
+
+int main(int argc, char* argv[])
+{
+    // 默认 2^27 个元素 (1GB)；2^30 个元素需要 8GB，超出了测试机的内存 (6GB)
+    int log2_n = argc > 1 ? std::atoi(argv[1]) : 27;
+
+    test01_power_of_two(log2_n);
+    test02_one_and_half(log2_n);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 6GB 内存；n = 2^30 的数据量 8GB 放不下，缩小到 2^27。
+grow ms / worst ms 为触发扩容的 push_back 的累计 / 最大耗时，peak MB 为子进程的 ru_maxrss):
+
+========== 测试01: push_back 2^27 个 uint64_t (1024 MB) ==========
+
+config                              total ms   grows     grow ms    worst ms     peak MB      cap MB
+std::vector                           1848.9      28       929.1       474.3      1026.4      1024.0
+std::allocator, 2x                    1681.0      28       927.3       444.7      1026.4      1024.0
+std::allocator, 1.5x                  2511.8      47      1855.4       601.8      1387.1      1039.2
+page_allocator, 2x                     669.8      28         1.0         0.4      1026.5      1024.0
+page_allocator, 1.5x                   675.9      47         4.6         1.8      1026.4      1039.2
+page_allocator, pages (2MB)            668.5     521         5.8         0.4      1026.5      1024.0
+page_allocator, pages (64MB)           674.7      30         1.4         0.4      1026.5      1024.0
+
+========== 测试02: push_back 1.5 * 2^27 个 uint64_t (1536 MB) ==========
+
+config                              total ms   grows     grow ms    worst ms     peak MB      cap MB
+std::vector                           3153.0      29      1804.7       968.0      2049.4      2048.0
+std::allocator, 2x                    2842.1      29      1800.4       922.3      2049.4      2048.0
+std::allocator, 1.5x                  3788.1      48      2703.0       950.7      2079.9      1558.9
+page_allocator, 2x                     864.8      29         1.1         0.4      1538.5      2048.0
+page_allocator, 1.5x                  1041.8      48        10.2         4.2      1538.4      1558.9
+page_allocator, pages (2MB)           1079.5     777         7.0         0.4      1538.5      1536.0
+page_allocator, pages (64MB)          1098.5      38         1.7         0.4      1538.5      1536.0
+*/
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "mystl/basic_string.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// vector 区间插入 要点
+// =====================================================
+// 1. 逐个 insert(pos, x) 插入 m 个元素：每次都把尾部后移一格，共搬动 O(n * m) 个元素，
+//    还可能扩容多次
+// 2. insert(pos, first, last) / insert(pos, n, value)：先求出最终大小，最多扩容一次，
+//    尾部只后移一次；扩容时新元素直接构造到新缓冲区，前后两段各搬一次
+// 3. 元素可平凡拷贝、源是同类型指针时新元素整块 memcpy；尾部可平凡重定位时整块 memmove
+// 4. 同样的路径提供了 assign、append_range 和迭代器区间构造函数
+// 5. 单遍的输入迭代器 (如 istream_iterator) 无法预先求个数，先读到临时 vector 再整体插入
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 一条入库记录，可平凡拷贝
+struct record
+{
+    std::uint64_t id;
+    double value;
+    char tag[16];
+};
+
+std::vector<record> make_records(size_t n, std::uint64_t base)
+{
+    std::vector<record> r(n);
+    for (size_t i = 0; i < n; ++i) r[i] = record{base + i, i * 0.5, "batch"};
+    return r;
+}
+
+// 逐个插入：mystl::vector 原来唯一的办法
+template <typename Vec, typename Src>
+void insert_one_by_one(Vec& v, size_t pos, const Src& src)
+{
+    for (size_t i = 0; i < src.size(); ++i) v.insert(pos + i, src[i]);
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: 向 n 条记录中插入 batches 批、每批 m 条
+// =====================================================
+// pos_of(size) 给出每批的插入位置
+template <typename PosOf>
+void batch_rows(size_t n, size_t m, size_t batches, PosOf pos_of)
+{
+    auto base = make_records(n, 0);
+    std::vector<std::vector<record>> src;
+    for (size_t b = 0; b < batches; ++b) src.push_back(make_records(m, (b + 1) << 32));
+
+    mystl::vector<record> v;
+    std::vector<record> sv;
+    auto reset = [&] { v.assign(base.begin(), base.end()); v.shrink_to_fit(); };
+    auto reset_std = [&] { sv.assign(base.begin(), base.end()); sv.shrink_to_fit(); };
+
+    double one = best_of_ms(3, reset, [&] {
+        for (auto& s : src) insert_one_by_one(v, pos_of(v.size()), s);
+    });
+    double range = best_of_ms(3, reset, [&] {
+        for (auto& s : src) v.insert(pos_of(v.size()), s.data(), s.data() + s.size());
+    });
+    double std_ms = best_of_ms(3, reset_std, [&] {
+        for (auto& s : src) sv.insert(sv.begin() + pos_of(sv.size()), s.begin(), s.end());
+    });
+    do_not_optimize(v.data());
+    do_not_optimize(sv.data());
+
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("mystl::vector insert(pos, x) x m", one, 0);
+    print_row("mystl::vector insert(pos, first, last)", range, one);
+    print_row("std::vector insert(pos, first, last)", std_ms, 0);
+}
+
+void test01_batch_insert(size_t n)
+{
+    const size_t m = 1000, batches = 5;
+    printSeparator("测试01: " + std::to_string(n) + " 条记录中插入 " + std::to_string(batches) + " 批 x " +
+                   std::to_string(m) + " 条 (record = " + std::to_string(sizeof(record)) + " 字节)");
+
+    std::cout << "[front] 插在头部:" << std::endl;
+    batch_rows(n, m, batches, [](size_t) { return size_t(0); });
+    std::cout << "\n[middle] 插在中间:" << std::endl;
+    batch_rows(n, m, batches, [](size_t size) { return size / 2; });
+}
+
+// =====================================================
+// 测试02: 逐批追加到末尾 (不预先 reserve)
+// =====================================================
+template <typename Vec, typename Src>
+double time_append(const Src& src, bool bulk)
+{
+    return best_of_ms(5, [&] {
+        Vec v;
+        for (auto& s : src) {
+            if (bulk) v.append_range(s);
+            else for (auto& x : s) v.push_back(x);
+        }
+        do_not_optimize(v.data());
+    });
+}
+
+void test02_append(size_t n)
+{
+    const size_t m = 1000;
+    printSeparator("测试02: 逐批追加 " + std::to_string(n / m) + " 批 x " + std::to_string(m) + " 条");
+
+    std::vector<std::vector<record>> src;
+    for (size_t b = 0; b < n / m; ++b) src.push_back(make_records(m, b * m));
+    std::vector<mystl::vector<mystl::string>> strs;
+    for (size_t b = 0; b < n / m; ++b) {
+        strs.emplace_back();
+        for (size_t i = 0; i < m; ++i) strs.back().push_back(mystl::string(i % 2 ? "short" : "a string that does not fit into SSO"));
+    }
+
+    double rec_push = time_append<mystl::vector<record>>(src, false);
+    double rec_bulk = time_append<mystl::vector<record>>(src, true);
+    double str_push = time_append<mystl::vector<mystl::string>>(strs, false);
+    double str_bulk = time_append<mystl::vector<mystl::string>>(strs, true);
+
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("record: push_back x m", rec_push, 0);
+    print_row("record: append_range (memcpy)", rec_bulk, rec_push);
+    print_row("mystl::string: push_back x m", str_push, 0);
+    print_row("mystl::string: append_range", str_bulk, str_push);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    test01_batch_insert(n);
+    test02_append(n * 10);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3; 追加到末尾时逐个 push_back 本来就不搬动尾部，
+批量追加只省掉了多次扩容和逐个构造，耗时主要在新页的缺页中断上):
+
+========== 测试01: 100000 条记录中插入 5 批 x 1000 条 (record = 32 字节) ==========
+
+[front] 插在头部:
+mystl::vector insert(pos, x) x m            730.26 ms
+mystl::vector insert(pos, first, last)        0.95 ms   (769.39x)
+std::vector insert(pos, first, last)          0.96 ms
+
+[middle] 插在中间:
+mystl::vector insert(pos, x) x m            224.15 ms
+mystl::vector insert(pos, first, last)        0.57 ms   (394.45x)
+std::vector insert(pos, first, last)          0.57 ms
+
+========== 测试02: 逐批追加 1000 批 x 1000 条 ==========
+
+record: push_back x m                        37.90 ms
+record: append_range (memcpy)                30.79 ms   (1.23x)
+mystl::string: push_back x m                 55.42 ms
+mystl::string: append_range                  56.63 ms   (0.98x)
+*/
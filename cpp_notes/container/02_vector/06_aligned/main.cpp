@@ -0,0 +1,222 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <immintrin.h>
+
+#include "mystl/aligned_allocator.h"
+#include "mystl/array.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 对齐分配与尾部填充 要点
+// =====================================================
+// 1. std::allocator 只保证 alignof(max_align_t) = 16 字节对齐；glibc 对大块直接 mmap，
+//    返回的地址是页首 + 16，AVX2 的 32 字节加载有一半跨越缓存行
+// 2. mystl::aligned_allocator<T, Align>: 按 Align 对齐，mystl::vector 把容量取整到
+//    Align / sizeof(T) 个元素的倍数；mystl::array<T, N, Align> 同样对齐并把存储补齐
+// 3. 容量已取整，fill_padding 把 [size, 取整后的 size) 清零后，SIMD 循环可以整块处理尾部，
+//    不需要逐个元素的收尾循环，也可以用对齐加载 _mm256_load_ps
+// 4. 数据量超出缓存时瓶颈是内存带宽，对齐的收益有限；数据在 L1 / L2 中、反复调用时收益明显
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+
+// 标量点积 (没有 -ffast-math，编译器不会改变浮点加法顺序去向量化)
+float dot_scalar(const float* a, const float* b, size_t n)
+{
+    float s = 0;
+    for (size_t i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+SIMD_TARGET inline float hsum(__m256 v)
+{
+    __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    x = _mm_add_ss(x, _mm_movehdup_ps(x));
+    return _mm_cvtss_f32(x);
+}
+
+// 任意地址、任意长度：非对齐加载，不足 8 个的尾部逐个处理
+SIMD_TARGET float dot_avx2_unaligned(const float* a, const float* b, size_t n)
+{
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8) s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+    float s = hsum(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+    for (; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+// 32 字节对齐、长度已补齐到 8 的倍数且填充区为 0：对齐加载，没有标量收尾
+SIMD_TARGET float dot_avx2_padded(const float* a, const float* b, size_t padded_n)
+{
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= padded_n; i += 32) {
+        s0 = _mm256_fmadd_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_load_ps(a + i + 8), _mm256_load_ps(b + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_load_ps(a + i + 16), _mm256_load_ps(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_load_ps(a + i + 24), _mm256_load_ps(b + i + 24), s3);
+    }
+    for (; i < padded_n; i += 8) s0 = _mm256_fmadd_ps(_mm256_load_ps(a + i), _mm256_load_ps(b + i), s0);
+    return hsum(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+}
+
+using aligned_vec = mystl::vector<float, mystl::aligned_allocator<float, 32>>;
+
+float value_at(size_t i) { return static_cast<float>(i % 17) * 0.25f; }
+
+// 每次调用处理 n 个元素，反复调用到约 total 个元素，返回 GFLOP/s
+template <typename Func>
+double gflops(size_t n, size_t total, Func func)
+{
+    size_t calls = total / n + 1;
+    double ms = best_of_ms(11, [&] {
+        float s = 0;
+        for (size_t c = 0; c < calls; ++c) {
+            s += func();
+            do_not_optimize(s);  // 带 memory clobber，阻止编译器把相同输入的调用提到循环外
+        }
+    });
+    return 2.0 * n * calls / ms / 1e6;
+}
+
+void print_row(const std::string& name, double gf, double base)
+{
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10) << gf << " GFLOP/s";
+    if (base > 0) std::cout << "   (" << gf / base << "x)";
+    std::cout << std::endl;
+}
+
+void dot_rows(size_t n, size_t total)
+{
+    std::vector<float> sa(n), sb(n);
+    aligned_vec va, vb;
+    for (size_t i = 0; i < n; ++i) {
+        sa[i] = value_at(i);
+        sb[i] = value_at(i + 3);
+        va.push_back(sa[i]);
+        vb.push_back(sb[i]);
+    }
+    mystl::fill_padding<32>(va);
+    mystl::fill_padding<32>(vb);
+    const size_t padded = mystl::padded_count<float, 32>(n);
+
+    std::cout << "std::vector 的地址 mod 32 = " << reinterpret_cast<uintptr_t>(sa.data()) % 32
+              << ", aligned_allocator 的地址 mod 32 = " << reinterpret_cast<uintptr_t>(va.data()) % 32
+              << ", capacity = " << va.capacity() << std::endl;
+
+    float r1 = dot_avx2_unaligned(sa.data(), sb.data(), n), r2 = dot_avx2_padded(va.data(), vb.data(), padded);
+    if (std::abs(r1 - r2) > 1e-5f * std::abs(r1)) std::cout << "result differs: " << r1 << " vs " << r2 << std::endl;
+
+    double scalar = gflops(n, total, [&] { return dot_scalar(sa.data(), sb.data(), n); });
+    double unaligned = gflops(n, total, [&] { return dot_avx2_unaligned(sa.data(), sb.data(), n); });
+    double unaligned_on_aligned = gflops(n, total, [&] { return dot_avx2_unaligned(va.data(), vb.data(), n); });
+    double padded_ms = gflops(n, total, [&] { return dot_avx2_padded(va.data(), vb.data(), padded); });
+
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("scalar, std::vector", scalar, 0);
+    print_row("AVX2 loadu + epilogue, std::vector", unaligned, 0);
+    print_row("AVX2 loadu + epilogue, aligned_allocator", unaligned_on_aligned, unaligned);
+    print_row("AVX2 load, padded tail, aligned_allocator", padded_ms, unaligned);
+}
+
+// =====================================================
+// 测试01: 1M 个 float 的点积 (两个数组共 8MB)
+// =====================================================
+void test01_large(size_t n)
+{
+    printSeparator("测试01: 点积 n = " + std::to_string(n));
+    dot_rows(n, 64 * n);
+}
+
+// =====================================================
+// 测试02: 缓存内的短向量，反复调用
+// =====================================================
+void test02_small()
+{
+    for (size_t n : {1003, 4099}) {
+        printSeparator("测试02: 点积 n = " + std::to_string(n) + " (L1 / L2 内，反复调用)");
+        dot_rows(n, 200000000);
+    }
+}
+
+// =====================================================
+// 测试03: mystl::array 的对齐与填充
+// =====================================================
+void test03_array()
+{
+    printSeparator("测试03: mystl::array<float, 13, 32>");
+
+    mystl::array<float, 13, 32> a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+    mystl::array<float, 13, 32> b = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    std::cout << "size = " << a.size() << ", padded_size = " << a.padded_size << ", sizeof = " << sizeof(a)
+              << ", alignof = " << alignof(decltype(a)) << std::endl;
+    std::cout << "dot (padded) = " << dot_avx2_padded(a.data(), b.data(), a.padded_size) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000003;
+
+    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+        std::cout << "CPU 不支持 AVX2 / FMA" << std::endl;
+        return 0;
+    }
+
+    test01_large(n);
+    test02_small();
+    test03_array();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机，缓存内的几组数据在多次运行之间有 1.2x ~ 1.7x 的波动;
+1M 个 float 的两个数组共 8MB，受内存带宽限制，对齐与否几乎没有差别):
+
+========== 测试01: 点积 n = 1000003 ==========
+
+std::vector 的地址 mod 32 = 16, aligned_allocator 的地址 mod 32 = 0, capacity = 1048576
+scalar, std::vector                               2.44 GFLOP/s
+AVX2 loadu + epilogue, std::vector                5.90 GFLOP/s
+AVX2 loadu + epilogue, aligned_allocator          6.05 GFLOP/s   (1.03x)
+AVX2 load, padded tail, aligned_allocator         6.01 GFLOP/s   (1.02x)
+
+========== 测试02: 点积 n = 1003 (L1 / L2 内，反复调用) ==========
+
+std::vector 的地址 mod 32 = 16, aligned_allocator 的地址 mod 32 = 0, capacity = 1024
+scalar, std::vector                               2.56 GFLOP/s
+AVX2 loadu + epilogue, std::vector               22.71 GFLOP/s
+AVX2 loadu + epilogue, aligned_allocator         26.80 GFLOP/s   (1.18x)
+AVX2 load, padded tail, aligned_allocator        28.02 GFLOP/s   (1.23x)
+
+========== 测试02: 点积 n = 4099 (L1 / L2 内，反复调用) ==========
+
+std::vector 的地址 mod 32 = 16, aligned_allocator 的地址 mod 32 = 0, capacity = 8192
+scalar, std::vector                               2.42 GFLOP/s
+AVX2 loadu + epilogue, std::vector               26.11 GFLOP/s
+AVX2 loadu + epilogue, aligned_allocator         30.86 GFLOP/s   (1.18x)
+AVX2 load, padded tail, aligned_allocator        31.13 GFLOP/s   (1.19x)
+
+========== 测试03: mystl::array<float, 13, 32> ==========
+
+size = 13, padded_size = 16, sizeof = 64, alignof = 32
+dot (padded) = 91.00
+*/
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <immintrin.h>
+
+#include "mystl/soa_vector.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 结构体数组 (SoA) 要点
+// =====================================================
+// 1. vector<Record> (AoS): 一条记录 64 字节，只读 price 一个字段时每条记录仍要读一整条缓存行，
+//    有用的只有 8 字节
+// 2. soa_vector<Fields...>: 每个字段一列，扫描 price 只读 price 列，读取的内存是 AoS 的 1/8；
+//    两个字段的过滤条件只读两列，而且连续的同类型数据容易被编译器向量化
+// 3. 列首 64 字节对齐、容量按 SIMD 宽度取整，column<I>() 返回 span，fill_padding 之后
+//    SIMD 内核可以对齐加载、整块处理尾部
+// 4. 排序: soa_vector::sort_by 只对 (键, 行号) 排序 (升序时用基数排序)，再把每一列按排列收集一遍。
+//    收集是随机读，列多时 (这里 9 列) 全表重排不比 AoS 的 std::sort 快；
+//    只需要顺序时用 sorted_permutation，按排列访问需要的一两列即可
+// 5. 反过来，每次都要访问整条记录的代码 (按行读写所有字段) 用 AoS 更合适
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+struct Record
+{
+    uint64_t id;
+    double price;
+    int32_t qty;
+    int32_t flags;
+    int64_t ts;
+    double bid;
+    double ask;
+    double weight;
+    uint64_t owner;
+};
+static_assert(sizeof(Record) == 64, "Record should fill one cache line");
+
+using Table = mystl::soa_vector<uint64_t, double, int32_t, int32_t, int64_t, double, double, double, uint64_t>;
+enum { ID, PRICE, QTY, FLAGS, TS, BID, ASK, WEIGHT, OWNER };
+
+uint64_t mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+Record make_record(uint64_t i)
+{
+    uint64_t h = mix(i + 1);
+    return Record{i, static_cast<double>(h % 20000) / 100, static_cast<int32_t>(h >> 20) % 100, static_cast<int32_t>(h >> 40) & 7,
+                  static_cast<int64_t>(h >> 8), 1.0, 2.0, 0.5, h % 1000};
+}
+
+void fill(mystl::vector<Record>& aos, Table& soa, size_t n)
+{
+    aos.reserve(n);
+    soa.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        Record r = make_record(i);
+        aos.push_back(r);
+        soa.emplace_back(r.id, r.price, r.qty, r.flags, r.ts, r.bid, r.ask, r.weight, r.owner);
+    }
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(40) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: 扫描一个字段 (sum of price)
+// =====================================================
+void test01_one_field(const mystl::vector<Record>& aos, const Table& soa)
+{
+    printSeparator("测试01: 一个字段求和 sum(price), n = " + std::to_string(aos.size()));
+
+    double r1 = 0, r2 = 0;
+    double base = best_of_ms(5, [&] {
+        double s = 0;
+        for (size_t i = 0; i < aos.size(); ++i) s += aos[i].price;
+        r1 = s;
+        do_not_optimize(r1);
+    });
+    double soa_ms = best_of_ms(5, [&] {
+        double s = 0;
+        for (double p : soa.column<PRICE>()) s += p;
+        r2 = s;
+        do_not_optimize(r2);
+    });
+    if (r1 != r2) std::cout << "result differs: " << r1 << " vs " << r2 << std::endl;
+    print_row("AoS mystl::vector<Record>", base, 0);
+    print_row("SoA column<PRICE>()", soa_ms, base);
+}
+
+// =====================================================
+// 测试02: 两个字段的过滤计数 (qty > 50 && price < 100)
+// =====================================================
+void test02_two_fields(const mystl::vector<Record>& aos, const Table& soa)
+{
+    printSeparator("测试02: 两个字段过滤计数 count(qty > 50 && price < 100)");
+
+    size_t c1 = 0, c2 = 0;
+    double base = best_of_ms(5, [&] {
+        size_t c = 0;
+        for (size_t i = 0; i < aos.size(); ++i) c += (aos[i].qty > 50) & (aos[i].price < 100);
+        c1 = c;
+        do_not_optimize(c1);
+    });
+    double soa_ms = best_of_ms(5, [&] {
+        auto qty = soa.column<QTY>();
+        auto price = soa.column<PRICE>();
+        size_t c = 0;
+        for (size_t i = 0; i < qty.size(); ++i) c += (qty[i] > 50) & (price[i] < 100);
+        c2 = c;
+        do_not_optimize(c2);
+    });
+    if (c1 != c2) std::cout << "result differs: " << c1 << " vs " << c2 << std::endl;
+    print_row("AoS mystl::vector<Record>", base, 0);
+    print_row("SoA column<QTY>() + column<PRICE>()", soa_ms, base);
+}
+
+// 对齐的列、填充区为 0：对齐加载，没有标量收尾
+__attribute__((target("avx2"))) double sum_avx2_padded(const double* p, size_t padded_n)
+{
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    for (size_t i = 0; i < padded_n; i += 8) {
+        s0 = _mm256_add_pd(s0, _mm256_load_pd(p + i));
+        s1 = _mm256_add_pd(s1, _mm256_load_pd(p + i + 4));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(s0, s1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// =====================================================
+// 测试03: 列 span 交给 SIMD 内核
+// =====================================================
+void test03_simd(Table& soa)
+{
+    printSeparator("测试03: column<PRICE>() 交给 AVX2 内核 (对齐加载，无尾部循环)");
+
+    if (!__builtin_cpu_supports("avx2")) {
+        std::cout << "CPU 不支持 AVX2" << std::endl;
+        return;
+    }
+    soa.fill_padding<PRICE>();
+    auto price = soa.column<PRICE>();
+    const size_t padded = mystl::padded_count<double, 64>(price.size());
+    std::cout << "column<PRICE>().data() mod 64 = " << reinterpret_cast<uintptr_t>(price.data()) % 64 << std::endl;
+
+    double r1 = 0, r2 = 0;
+    double base = best_of_ms(5, [&] {
+        double s = 0;
+        for (double p : price) s += p;
+        r1 = s;
+        do_not_optimize(r1);
+    });
+    double simd = best_of_ms(5, [&] {
+        r2 = sum_avx2_padded(price.data(), padded);
+        do_not_optimize(r2);
+    });
+    if (std::abs(r1 - r2) > 1e-9 * std::abs(r1)) std::cout << "result differs: " << r1 << " vs " << r2 << std::endl;
+    print_row("scalar loop over column<PRICE>()", base, 0);
+    print_row("AVX2 kernel over column<PRICE>()", simd, base);
+}
+
+// =====================================================
+// 测试04: 按一个字段排序
+// =====================================================
+void test04_sort(const mystl::vector<Record>& aos, const Table& soa)
+{
+    printSeparator("测试04: 按 ts 排序");
+
+    mystl::vector<Record> a;
+    Table s;
+    double base = best_of_ms(3, [&] { a = aos; }, [&] {
+        std::sort(a.begin(), a.end(), [](const Record& x, const Record& y) { return x.ts < y.ts; });
+    });
+    double soa_ms = best_of_ms(3, [&] { s = soa; }, [&] { s.sort_by<TS>(); });
+    double perm_ms = best_of_ms(3, [&] { do_not_optimize(soa.sorted_permutation<TS>().data()); });
+
+    bool same = true;
+    for (size_t i = 0; i < a.size(); ++i) same &= a[i].id == s.column<ID>()[i];
+    if (!same) std::cout << "order differs" << std::endl;
+    print_row("AoS std::sort(vector<Record>)", base, 0);
+    print_row("SoA sort_by<TS>()", soa_ms, base);
+    print_row("SoA sorted_permutation<TS>() only", perm_ms, base);
+
+    // radix_sort 不支持的键 (bool、long double) 走比较排序，相等的键同样保持原来的顺序
+    mystl::soa_vector<int, bool, long double> small;
+    for (int i = 0; i < 1000; ++i) small.emplace_back(i, i % 3 == 0, static_cast<long double>((i * 7) % 10));
+    bool stable = true;
+    small.sort_by<1>();
+    const auto ids = small.column<0>();
+    const auto flags = small.column<1>();
+    for (size_t i = 1; i < small.size(); ++i) stable &= flags[i - 1] < flags[i] || (flags[i - 1] == flags[i] && ids[i - 1] < ids[i]);
+    small.sort_by<2>();
+    for (size_t i = 1; i < small.size(); ++i) stable &= small.column<2>()[i - 1] <= small.column<2>()[i];
+    std::cout << "sort_by on bool / long double columns: " << (stable ? "OK" : "FAILED") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    mystl::vector<Record> aos;
+    Table soa;
+    fill(aos, soa, n);
+
+    test01_one_field(aos, soa);
+    test02_two_fields(aos, soa);
+    test03_simd(soa);
+    test04_sort(aos, soa);
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机, 2M 条 64 字节的记录):
+
+========== 测试01: 一个字段求和 sum(price), n = 2000000 ==========
+
+AoS mystl::vector<Record>                    11.28 ms
+SoA column<PRICE>()                           1.63 ms   (6.92x)
+
+========== 测试02: 两个字段过滤计数 count(qty > 50 && price < 100) ==========
+
+AoS mystl::vector<Record>                    15.66 ms
+SoA column<QTY>() + column<PRICE>()           1.27 ms   (12.36x)
+
+========== 测试03: column<PRICE>() 交给 AVX2 内核 (对齐加载，无尾部循环) ==========
+
+column<PRICE>().data() mod 64 = 0
+scalar loop over column<PRICE>()              1.65 ms
+AVX2 kernel over column<PRICE>()              0.67 ms   (2.46x)
+
+========== 测试04: 按 ts 排序 ==========
+
+AoS std::sort(vector<Record>)               305.95 ms
+SoA sort_by<TS>()                           355.01 ms   (0.86x)
+SoA sorted_permutation<TS>() only           203.64 ms   (1.50x)
+sort_by on bool / long double columns: OK
+*/
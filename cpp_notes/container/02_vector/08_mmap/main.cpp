@@ -0,0 +1,233 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "mystl/algorithm.h"
+#include "mystl/mmap_vector.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 内存映射文件上的 vector 要点
+// =====================================================
+// 1. 每次启动把大数组从文件读回 vector: 先分配、再 read 拷贝一遍，耗时和数据量成正比
+// 2. mystl::mmap_vector<T>: 数据就存放在映射的文件中，打开只是一次 mmap，不读取内容，
+//    页在第一次访问时才换入 (在 page cache 中时只是缺页中断，不读磁盘)
+// 3. 扩容按 vector 的 Growth 策略: ftruncate 扩展文件 + mremap 扩展映射，已有数据不拷贝
+// 4. 元素个数写在文件头中，修改直接写进 page cache，进程崩溃不丢数据；
+//    flush() (msync) 等待写回磁盘，作为掉电时的持久化点，代价与脏页数量成正比
+// 5. 迭代器是裸指针，mystl::sort、std::lower_bound 等算法可以直接使用
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+struct Record
+{
+    uint64_t key;
+    uint64_t value;
+};
+
+const char* k_raw_path = "/tmp/mystl_mmap_bench.raw";
+const char* k_mmap_path = "/tmp/mystl_mmap_bench.mv";
+
+Record make_record(uint64_t i)
+{
+    uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ULL;
+    return Record{h ^ (h >> 29), i};
+}
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(12) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+// 把整个文件读到 p，返回读到的字节数
+size_t read_all(int fd, char* p, size_t n)
+{
+    size_t done = 0;
+    while (done < n) {
+        ssize_t r = ::read(fd, p + done, n - done);
+        if (r <= 0) break;
+        done += static_cast<size_t>(r);
+    }
+    return done;
+}
+
+void write_all(int fd, const char* p, size_t n)
+{
+    size_t done = 0;
+    while (done < n) {
+        ssize_t r = ::write(fd, p + done, n - done);
+        if (r <= 0) break;
+        done += static_cast<size_t>(r);
+    }
+}
+
+// 启动时的做法: 从原始记录文件重建 mystl::vector
+mystl::vector<Record> load_vector()
+{
+    int fd = ::open(k_raw_path, O_RDONLY);
+    size_t bytes = static_cast<size_t>(::lseek(fd, 0, SEEK_END));
+    ::lseek(fd, 0, SEEK_SET);
+    mystl::vector<Record> v;
+    v.resize_for_overwrite(bytes / sizeof(Record));
+    read_all(fd, reinterpret_cast<char*>(v.data()), bytes);
+    ::close(fd);
+    return v;
+}
+
+template <typename Vec>
+uint64_t checksum(const Vec& v)
+{
+    uint64_t s = 0;
+    for (const Record& r : v) s += r.key ^ r.value;
+    return s;
+}
+
+// =====================================================
+// 测试01: 逐个 push_back 构建
+// =====================================================
+void test01_build(size_t n)
+{
+    printSeparator("测试01: push_back " + std::to_string(n) + " 条 16 字节记录 (" + std::to_string(n * sizeof(Record) >> 20) + " MB)");
+
+    double vec_ms = best_of_ms(3, [&] {
+        mystl::vector<Record> v;
+        for (size_t i = 0; i < n; ++i) v.push_back(make_record(i));
+        int fd = ::open(k_raw_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        write_all(fd, reinterpret_cast<const char*>(v.data()), v.size() * sizeof(Record));
+        ::close(fd);
+    });
+    double mmap_ms = best_of_ms(3, [&] { ::unlink(k_mmap_path); }, [&] {
+        mystl::mmap_vector<Record> v(k_mmap_path);
+        for (size_t i = 0; i < n; ++i) v.push_back(make_record(i));
+    });
+    print_row("mystl::vector + write() to file", vec_ms, 0);
+    print_row("mmap_vector (ftruncate + mremap growth)", mmap_ms, vec_ms);
+}
+
+// =====================================================
+// 测试02: 进程启动时加载 (文件在 page cache 中)
+// =====================================================
+void test02_open()
+{
+    printSeparator("测试02: 启动时加载 (文件在 page cache 中)");
+
+    uint64_t c1 = 0, c2 = 0;
+    double load = best_of_ms(5, [&] { mystl::vector<Record> v = load_vector(); do_not_optimize(v.data()); });
+    double load_scan = best_of_ms(5, [&] { mystl::vector<Record> v = load_vector(); c1 = checksum(v); });
+    double open = best_of_ms(5, [&] { mystl::mmap_vector<Record> v(k_mmap_path); do_not_optimize(v.data()); });
+    double open_first = best_of_ms(5, [&] { mystl::mmap_vector<Record> v(k_mmap_path); do_not_optimize(v[v.size() / 2]); });
+    double open_scan = best_of_ms(5, [&] { mystl::mmap_vector<Record> v(k_mmap_path); c2 = checksum(v); });
+    if (c1 != c2) std::cout << "checksum differs" << std::endl;
+
+    print_row("vector: read() whole file", load, 0);
+    print_row("mmap_vector: open", open, load);
+    print_row("mmap_vector: open + one lookup", open_first, load);
+    std::cout << std::endl;
+    print_row("vector: read() + full scan", load_scan, 0);
+    print_row("mmap_vector: open + full scan", open_scan, load_scan);
+}
+
+// =====================================================
+// 测试03: 现有算法直接作用于 mmap_vector
+// =====================================================
+void test03_algorithms()
+{
+    printSeparator("测试03: mystl::sort / std::lower_bound");
+
+    auto by_key = [](const Record& a, const Record& b) { return a.key < b.key; };
+    mystl::vector<Record> v = load_vector();
+    mystl::mmap_vector<Record> m(k_mmap_path);
+
+    double vec_sort = best_of_ms(1, [&] { mystl::sort(v.begin(), v.end(), by_key); });
+    double mmap_sort = best_of_ms(1, [&] { mystl::sort(m.begin(), m.end(), by_key); });
+
+    size_t hits = 0;
+    double lookups = best_of_ms(3, [&] {
+        hits = 0;
+        for (size_t i = 0; i < 1000000; ++i) {
+            uint64_t k = make_record(i * 7 % m.size()).key;
+            auto it = std::lower_bound(m.begin(), m.end(), k, [](const Record& r, uint64_t x) { return r.key < x; });
+            hits += it != m.end() && it->key == k;
+        }
+        do_not_optimize(hits);
+    });
+    print_row("mystl::sort, mystl::vector", vec_sort, 0);
+    print_row("mystl::sort, mmap_vector", mmap_sort, vec_sort);
+    print_row("1M std::lower_bound on mmap_vector", lookups, 0);
+    std::cout << "hits = " << hits << ", sorted = " << std::is_sorted(m.begin(), m.end(), by_key) << std::endl;
+}
+
+// =====================================================
+// 测试04: flush (msync) 的代价
+// =====================================================
+void test04_flush()
+{
+    printSeparator("测试04: 修改后 flush (msync 写回磁盘)");
+
+    mystl::mmap_vector<Record> m(k_mmap_path);
+    m.flush();
+    for (size_t step : {size_t(1) << 20, size_t(1) << 12, size_t(1) << 8}) {
+        size_t pages = 0;
+        Timer t;
+        for (size_t i = 0; i < m.size(); i += step, ++pages) m[i].value += 1;
+        m.flush();
+        std::cout << "dirty pages ~ " << std::setw(8) << pages << ": flush " << std::setw(10) << t.elapsed_ms() << " ms" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1) << 24);
+
+    test01_build(n);
+    test02_open();
+    test03_algorithms();
+    test04_flush();
+
+    ::unlink(k_raw_path);
+    ::unlink(k_mmap_path);
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机, ext4; 测试01 两种做法的数据都只写进了 page cache，没有等待写回磁盘):
+
+========== 测试01: push_back 16777216 条 16 字节记录 (256 MB) ==========
+
+mystl::vector + write() to file                   493.44 ms
+mmap_vector (ftruncate + mremap growth)           163.03 ms   (3.03x)
+
+========== 测试02: 启动时加载 (文件在 page cache 中) ==========
+
+vector: read() whole file                         192.86 ms
+mmap_vector: open                                   0.01 ms   (17025.03x)
+mmap_vector: open + one lookup                      0.01 ms   (15679.63x)
+
+vector: read() + full scan                        217.69 ms
+mmap_vector: open + full scan                      51.50 ms   (4.23x)
+
+========== 测试03: mystl::sort / std::lower_bound ==========
+
+mystl::sort, mystl::vector                       2414.29 ms
+mystl::sort, mmap_vector                         2320.83 ms   (1.04x)
+1M std::lower_bound on mmap_vector               1043.32 ms
+hits = 1000000, sorted = 1
+
+========== 测试04: 修改后 flush (msync 写回磁盘) ==========
+
+dirty pages ~       16: flush       5.84 ms
+dirty pages ~     4096: flush     100.65 ms
+dirty pages ~    65536: flush     196.14 ms
+*/
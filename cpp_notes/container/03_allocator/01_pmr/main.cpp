@@ -0,0 +1,234 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "mystl/basic_string.h"
+#include "mystl/memory_resource.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 多态内存资源 (pmr) 要点
+// =====================================================
+// 1. 一个请求里构造成百上千个小 string / vector，每个都单独 malloc、单独 free，
+//    分配器的开销可能超过真正的计算
+// 2. mystl::pmr::vector / deque / string 使用 polymorphic_allocator，内存来自运行时指定的
+//    memory_resource；construct 按 uses-allocator 规则把资源传给元素，嵌套的容器也用同一个资源
+// 3. monotonic_buffer_resource: 请求级的 arena，分配只移动指针，释放什么也不做，
+//    请求结束时整块归还；给一块预先准备好的缓冲区时整个请求不调用 malloc
+// 4. unsynchronized_pool_resource: 按大小分档的空闲链表，释放的块可以复用，适合长期存在、
+//    反复分配释放的场景；synchronized_pool_resource 多一把锁
+// 5. 代价: 每次分配多一次虚函数调用；monotonic 不复用释放的内存 (vector 扩容留下的旧空间)，
+//    峰值内存更高，只适合生命周期有明确边界的请求
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 统计全局 operator new 的调用次数
+static size_t g_new_calls = 0;
+
+void* operator new(std::size_t n)
+{
+    ++g_new_calls;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// 统计向上游申请的次数和字节数
+class counting_resource : public mystl::pmr::memory_resource
+{
+public:
+    size_t calls = 0;
+    size_t bytes = 0;
+
+protected:
+    void* do_allocate(std::size_t n, std::size_t align) override
+    {
+        ++calls;
+        bytes += n;
+        return mystl::pmr::new_delete_resource()->allocate(n, align);
+    }
+    void do_deallocate(void* p, std::size_t n, std::size_t align) override
+    {
+        mystl::pmr::new_delete_resource()->deallocate(p, n, align);
+    }
+    bool do_is_equal(const mystl::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+constexpr size_t k_containers = 10000;  // 每个请求构造的小容器个数 (一半 vector<int>，一半 string)
+
+std::vector<std::string> make_words()
+{
+    std::vector<std::string> words;
+    for (size_t i = 0; i < 256; ++i) words.push_back(std::string(8 + i * 37 % 56, static_cast<char>('a' + i % 26)));
+    return words;
+}
+
+const std::vector<std::string> g_words = make_words();
+
+// 一个请求: 构造 5000 个长度 1~8 的 vector<int> 和 5000 个长度 8~63 的 string，算一个结果后全部析构。
+// 默认分配器的容器类型不传参数，pmr 容器类型传入 memory_resource*
+template <typename VecVec, typename VecStr, typename... Res>
+size_t run_request(Res... res)
+{
+    VecVec vv(res...);
+    VecStr vs(res...);
+    for (size_t i = 0; i < k_containers / 2; ++i) {
+        vv.emplace_back();
+        auto& v = vv[vv.size() - 1];
+        for (size_t j = 0; j <= i % 8; ++j) v.push_back(static_cast<int>(i + j));
+        vs.emplace_back(g_words[i % g_words.size()].c_str());
+    }
+    size_t sum = 0;
+    for (size_t i = 0; i < vv.size(); ++i) sum += vv[i].size() + vs[i].size();
+    return sum;
+}
+
+using std_vv = mystl::vector<mystl::vector<int>>;
+using std_vs = mystl::vector<mystl::string>;
+using pmr_vv = mystl::pmr::vector<mystl::pmr::vector<int>>;
+using pmr_vs = mystl::pmr::vector<mystl::pmr::string>;
+
+constexpr int k_requests = 20;
+
+// 返回每个请求的平均耗时 (us)，calls 为每个请求调用 operator new 的次数
+template <typename Func>
+double time_requests(Func request, size_t& calls)
+{
+    size_t before = g_new_calls;
+    request();
+    calls = g_new_calls - before;
+    double ms = best_of_ms(5, [&] {
+        for (int r = 0; r < k_requests; ++r) do_not_optimize(request());
+    });
+    return ms * 1000 / k_requests;
+}
+
+void print_row(const std::string& name, double us, double base, size_t calls)
+{
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10) << us << " us"
+              << std::setw(10) << calls << " new";
+    if (base > 0) std::cout << "   (" << base / us << "x)";
+    std::cout << std::endl;
+}
+
+// =====================================================
+// 测试01: 一个请求构造 1 万个小容器
+// =====================================================
+void test01_request()
+{
+    printSeparator("测试01: 每个请求 " + std::to_string(k_containers) + " 个小容器 (每行: 每个请求的耗时 / operator new 次数)");
+
+    namespace pmr = mystl::pmr;
+    size_t calls = 0;
+    std::cout << std::fixed << std::setprecision(1);
+
+    double base = time_requests([] { return run_request<std_vv, std_vs>(); }, calls);
+    print_row("std::allocator", base, 0, calls);
+
+    double us = time_requests([] { return run_request<pmr_vv, pmr_vs>(pmr::new_delete_resource()); }, calls);
+    print_row("pmr, new_delete_resource", us, base, calls);
+
+    pmr::unsynchronized_pool_resource pool;
+    run_request<pmr_vv, pmr_vs>(&pool);  // 预热，池中已有空闲块
+    us = time_requests([&] { return run_request<pmr_vv, pmr_vs>(&pool); }, calls);
+    print_row("pmr, unsynchronized_pool (long-lived)", us, base, calls);
+
+    pmr::synchronized_pool_resource sync_pool;
+    run_request<pmr_vv, pmr_vs>(&sync_pool);
+    us = time_requests([&] { return run_request<pmr_vv, pmr_vs>(&sync_pool); }, calls);
+    print_row("pmr, synchronized_pool (long-lived)", us, base, calls);
+
+    us = time_requests([] {
+        pmr::monotonic_buffer_resource arena;
+        return run_request<pmr_vv, pmr_vs>(&arena);
+    }, calls);
+    print_row("pmr, monotonic per request", us, base, calls);
+
+    // 请求之间复用同一块缓冲区，请求结束时 release()
+    std::vector<char> buffer(4 << 20);
+    pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    us = time_requests([&] {
+        size_t r = run_request<pmr_vv, pmr_vs>(&arena);
+        arena.release();
+        return r;
+    }, calls);
+    print_row("pmr, monotonic on reused 4MB buffer", us, base, calls);
+}
+
+// =====================================================
+// 测试02: 资源传递给嵌套元素，以及各资源向上游申请的内存
+// =====================================================
+void test02_upstream()
+{
+    printSeparator("测试02: 嵌套元素使用的资源 / 向上游申请的内存");
+
+    namespace pmr = mystl::pmr;
+    {
+        counting_resource upstream;
+        pmr::monotonic_buffer_resource arena(&upstream);
+        pmr_vs vs(&arena);
+        vs.emplace_back("a string longer than the sso buffer");
+        vs.push_back(pmr::string("temporary from the default resource"));
+        std::cout << "vs[0] uses arena: " << (vs[0].get_allocator().resource() == &arena)
+                  << ", vs[1] uses arena: " << (vs[1].get_allocator().resource() == &arena) << std::endl;
+    }
+
+    std::cout << std::left << std::setw(44) << "\nresource (cumulative)" << std::right << std::setw(12) << "calls" << std::setw(14) << "KB" << std::endl;
+    auto row = [](const std::string& name, const counting_resource& up) {
+        std::cout << std::left << std::setw(43) << name << std::right << std::setw(12) << up.calls << std::setw(14) << up.bytes / 1024 << std::endl;
+    };
+    {
+        counting_resource up;
+        pmr::monotonic_buffer_resource arena(&up);
+        run_request<pmr_vv, pmr_vs>(&arena);
+        row("monotonic_buffer_resource", up);
+    }
+    {
+        counting_resource up;
+        pmr::unsynchronized_pool_resource pool(&up);
+        run_request<pmr_vv, pmr_vs>(&pool);
+        row("unsynchronized_pool_resource (1st request)", up);
+        run_request<pmr_vv, pmr_vs>(&pool);
+        row("unsynchronized_pool_resource (after 2nd)", up);
+    }
+}
+
+int main()
+{
+    test01_request();
+    test02_upstream();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机，多次运行之间有 10% ~ 20% 的波动;
+每个请求新建的 monotonic arena 向上游申请新内存，大块由 glibc 直接 mmap、释放时 munmap，每个请求都要重新缺页，
+复用同一块缓冲区时没有 malloc 也没有缺页; pool 的 new 来自超过 4KB 的外层 vector，直接交给上游):
+
+========== 测试01: 每个请求 10000 个小容器 (每行: 每个请求的耗时 / operator new 次数) ==========
+
+std::allocator                                  1023.5 us     20009 new
+pmr, new_delete_resource                        1294.7 us     20009 new   (0.8x)
+pmr, unsynchronized_pool (long-lived)            795.4 us        13 new   (1.3x)
+pmr, synchronized_pool (long-lived)             1191.4 us        13 new   (0.9x)
+pmr, monotonic per request                       909.6 us        11 new   (1.1x)
+pmr, monotonic on reused 4MB buffer              317.5 us         0 new   (3.2x)
+
+========== 测试02: 嵌套元素使用的资源 / 向上游申请的内存 ==========
+
+vs[0] uses arena: 1, vs[1] uses arena: 1
+
+resource (cumulative)                             calls            KB
+monotonic_buffer_resource                            11          2110
+unsynchronized_pool_resource (1st request)           72          1531
+unsynchronized_pool_resource (after 2nd)             85          2670
+*/
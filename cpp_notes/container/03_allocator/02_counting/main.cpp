@@ -0,0 +1,191 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+
+#include "mystl/basic_string.h"
+#include "mystl/counting_allocator.h"
+#include "mystl/deque.h"
+#include "mystl/shared_ptr.h"
+#include "mystl/vector.h"
+#include "test_class/Timer.h"
+
+// =====================================================
+// 分配计数器 (counting_allocator) 要点
+// =====================================================
+// 1. 热路径上的分配往往看不见: push_back 逐步扩容、临时 string、deque 的块和 map，
+//    每一次都是一次 malloc / free
+// 2. mystl::counting_allocator<T, Tag, Alloc>: 包装任意分配器，按 Tag 统计分配次数、累计字节、
+//    存活字节峰值和大小分布；次数和分布按线程分片，多线程共用同一个 Tag 也不会争抢同一条缓存行
+// 3. 同一个 Tag 可以给多个容器使用，rebind 保留 Tag，所以 deque 的 map、allocate_shared 的控制块
+//    都算在各自的 Tag 上；print_allocation_report 按 Tag 输出一张表
+// 4. 用法: 给怀疑的容器换上带 Tag 的分配器，跑一遍业务，看报告里哪个 Tag 的 allocs 最多、
+//    大小分布集中在哪一档，再针对性地 reserve / 复用 / 换 pmr arena
+// 5. 代价: 分片计数只是普通的读写，每次分配 / 释放只有存活字节数一次原子加减；
+//    全局原子计数 (每次分配 4 次原子读改写) 在这台机器上会让小对象分配慢一倍以上
+// =====================================================
+
+void printSeparator(const std::string& title) {
+    std::cout << "\n========== " << title << " ==========\n" << std::endl;
+}
+
+// 每个可疑的分配点一个 Tag，报告中按 Tag 的类型名显示
+struct ids_tag {};
+struct names_tag {};
+struct queue_tag {};
+struct session_tag {};
+
+template <typename T, typename Tag>
+using counted = mystl::counting_allocator<T, Tag>;
+
+using id_vector = mystl::vector<int, counted<int, ids_tag>>;
+using name_string = mystl::basic_string<char, std::char_traits<char>, counted<char, names_tag>>;
+using name_vector = mystl::vector<name_string, counted<name_string, names_tag>>;
+using job_queue = mystl::deque<int, counted<int, queue_tag>>;
+
+struct Session
+{
+    int id;
+    double score;
+};
+
+// 模拟一次请求: 收集 id、拼接名字、排队任务
+size_t handle_request(size_t n, bool tuned)
+{
+    id_vector ids;
+    name_vector names;
+    job_queue jobs;
+    if (tuned) {
+        ids.reserve(n);
+        names.reserve(n);
+    }
+    name_string name;
+    for (size_t i = 0; i < n; ++i) {
+        ids.push_back(static_cast<int>(i));
+        if (tuned) {
+            name.clear();  // 复用同一个缓冲区
+        } else {
+            name = name_string();
+        }
+        name += "user-";
+        name += std::to_string(i).c_str();
+        name += "-with-a-long-suffix";
+        names.push_back(name);
+        jobs.push_back(static_cast<int>(i));
+    }
+    return ids.size() + names.size() + jobs.size();
+}
+
+// =====================================================
+// 测试01: 找出一次请求中的分配热点
+// =====================================================
+void test01_hotspots()
+{
+    printSeparator("测试01: 一次请求 (n = 10000) 的分配报告");
+
+    mystl::reset_allocation_stats();
+    do_not_optimize(handle_request(10000, false));
+    std::cout << "-- 未优化 --" << std::endl;
+    mystl::print_allocation_report();
+
+    mystl::reset_allocation_stats();
+    do_not_optimize(handle_request(10000, true));
+    std::cout << "\n-- reserve + 复用临时 string --" << std::endl;
+    mystl::print_allocation_report();
+}
+
+// =====================================================
+// 测试02: allocate_shared
+// =====================================================
+void test02_shared()
+{
+    printSeparator("测试02: allocate_shared 的控制块和对象一次分配");
+
+    mystl::reset_allocation_stats();
+    for (int i = 0; i < 1000; ++i) {
+        auto p = mystl::allocate_shared<Session>(counted<Session, session_tag>(), Session{i, 0.5});
+        do_not_optimize(p.get());
+    }
+    const mystl::allocation_snapshot s = mystl::allocation_stats_for<session_tag>().snapshot();
+    std::cout << "1000 x allocate_shared<Session>: allocs = " << s.allocations << ", bytes = " << s.bytes
+              << " (" << s.bytes / 1000 << " bytes per block)" << std::endl;
+}
+
+// =====================================================
+// 测试03: 计数本身的开销
+// =====================================================
+struct overhead_tag {};
+
+void print_row(const std::string& name, double ms, double base)
+{
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(10) << ms << " ms";
+    if (base > 0) std::cout << "   (" << base / ms << "x)";
+    std::cout << std::endl;
+}
+
+template <typename Vec>
+void small_vectors(size_t rounds)
+{
+    for (size_t r = 0; r < rounds; ++r) {
+        Vec v;
+        for (int i = 0; i < 16; ++i) v.push_back(i);
+        do_not_optimize(v.data());
+    }
+}
+
+void test03_overhead()
+{
+    printSeparator("测试03: 1M 个小 vector (每个 5 次分配) 的耗时");
+
+    const size_t rounds = 1000000;
+    double base = best_of_ms(5, [&] { small_vectors<mystl::vector<int>>(rounds); });
+    double counted_ms = best_of_ms(5, [&] { small_vectors<mystl::vector<int, counted<int, overhead_tag>>>(rounds); });
+    print_row("mystl::vector<int>", base, 0);
+    print_row("mystl::vector<int, counting_allocator>", counted_ms, base);
+    std::cout << "counted allocations: " << mystl::allocation_stats_for<overhead_tag>().snapshot().allocations << std::endl;
+}
+
+int main()
+{
+    test01_hotspots();
+    test02_shared();
+    test03_overhead();
+
+    return 0;
+}
+
+/*
+运行结果示例 (g++ 12 -O3, 单核虚拟机; queue_tag 一行说明 mystl::deque 的 map 每次只扩一个节点，
+每 4 个元素就重新分配一次 map，是报告找出的下一个热点):
+
+========== 测试01: 一次请求 (n = 10000) 的分配报告 ==========
+
+-- 未优化 --
+tag                                   allocs       frees         bytes        live        peak
+queue_tag                               5003        5003      25110048           0       80072
+    sizes: <=16:2503 <=32:1 <=64:4 <=128:8 <=256:16 <=512:32 <=1024:64 <=2048:128 <=4096:256 <=8192:512 <=16384:1024 <=32768:455
+ids_tag                                   15          15        131068           0       98304
+    sizes: <=4:1 <=8:1 <=16:1 <=32:1 <=64:1 <=128:1 <=256:1 <=512:1 <=1024:1 <=2048:1 <=4096:1 <=8192:1 <=16384:1 <=32768:1 <=65536:1
+names_tag                              20015       20015       1909570           0     1219529
+    sizes: <=32:20000 <=64:1 <=128:1 <=256:1 <=512:1 <=1024:1 <=2048:1 <=4096:1 <=8192:1 <=16384:1 <=32768:1 <=65536:1 <=131072:1 <=262144:1 <=524288:1 <=1048576:1
+
+-- reserve + 复用临时 string --
+tag                                   allocs       frees         bytes        live        peak
+queue_tag                               5003        5003      25110048           0       80072
+    sizes: <=16:2503 <=32:1 <=64:4 <=128:8 <=256:16 <=512:32 <=1024:64 <=2048:128 <=4096:256 <=8192:512 <=16384:1024 <=32768:455
+ids_tag                                    1           1         40000           0       40000
+    sizes: <=65536:1
+names_tag                              10002       10002        688921           0      688921
+    sizes: <=32:10001 <=524288:1
+
+========== 测试02: allocate_shared 的控制块和对象一次分配 ==========
+
+1000 x allocate_shared<Session>: allocs = 1000, bytes = 56000 (56 bytes per block)
+
+========== 测试03: 1M 个小 vector (每个 5 次分配) 的耗时 ==========
+
+mystl::vector<int>                              154.40 ms
+mystl::vector<int, counting_allocator>          212.86 ms   (0.73x)
+counted allocations: 25000000
+*/
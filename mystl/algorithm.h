@@ -2,7 +2,10 @@
 
 #include "utility.h"
 
+#include "algorithm/heap.h"
 #include "algorithm/sort.h"
+#include "algorithm/select.h"
 #include "algorithm/algobase.h"
+#include "algorithm/numeric.h"
 
 #include "algorithm/search.h"
\ No newline at end of file
@@ -1,5 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../execution.h"
+#include "../iterator.h"
+#include "../utility.h"
+#include "../thread_pool.h"
+
 namespace mystl
 {
 
@@ -11,23 +23,420 @@ void swap(Tp& d1, Tp& d2)
     d2 = mystl::move(temp);
 }
 
+// 随机访问迭代器先算出元素个数，循环条件只比较计数器，不必每次比较迭代器
+template <typename Iter, typename Func>
+Func for_each(Iter first, Iter last, Func func)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        for (iter_difference_t<Iter> n = last - first; n > 0; --n, ++first) {
+            func(*first);
+        }
+    } else {
+        for (; first != last; ++first) {
+            func(*first);
+        }
+    }
+    return func;
+}
+
+namespace detail
+{
+// 第一个参数是执行策略时才启用带策略的重载，否则启用普通重载，
+// 避免 transform(policy, first, last, out, op) 与 transform(first1, last1, first2, out, op) 这类同参数个数的重载歧义
+template <typename Policy, typename R>
+using enable_if_policy_t = std::enable_if_t<is_execution_policy_v<Policy>, R>;
+
 template <typename Iter>
-int distance(Iter first, Iter last)
+using disable_if_policy_t = std::enable_if_t<!is_execution_policy_v<Iter>>;
+} // namespace detail
+
+template <typename Iter, typename Size, typename Func, typename = detail::disable_if_policy_t<Iter>>
+Iter for_each_n(Iter first, Size n, Func func)
+{
+    for (; n > 0; --n, ++first) {
+        func(*first);
+    }
+    return first;
+}
+
+template <typename Iter, typename Out, typename UnaryOp, typename = detail::disable_if_policy_t<Iter>>
+Out transform(Iter first, Iter last, Out d_first, UnaryOp op)
+{
+    for (; first != last; ++first, ++d_first) {
+        *d_first = op(*first);
+    }
+    return d_first;
+}
+
+template <typename Iter1, typename Iter2, typename Out, typename BinaryOp, typename = detail::disable_if_policy_t<Iter1>>
+Out transform(Iter1 first1, Iter1 last1, Iter2 first2, Out d_first, BinaryOp op)
+{
+    for (; first1 != last1; ++first1, ++first2, ++d_first) {
+        *d_first = op(*first1, *first2);
+    }
+    return d_first;
+}
+
+// 与 std::reduce 一样，op 需要满足结合律和交换律，带策略的版本会以任意顺序合并
+template <typename Iter, typename Tp, typename BinaryOp = std::plus<>, typename = detail::disable_if_policy_t<Iter>>
+Tp reduce(Iter first, Iter last, Tp init, BinaryOp op = {})
+{
+    for (; first != last; ++first) {
+        init = op(mystl::move(init), *first);
+    }
+    return init;
+}
+
+template <typename Iter, typename Tp, typename ReduceOp, typename TransformOp, typename = detail::disable_if_policy_t<Iter>>
+Tp transform_reduce(Iter first, Iter last, Tp init, ReduceOp reduce_op, TransformOp transform_op)
+{
+    for (; first != last; ++first) {
+        init = reduce_op(mystl::move(init), transform_op(*first));
+    }
+    return init;
+}
+
+template <typename Iter1, typename Iter2, typename Tp, typename ReduceOp, typename TransformOp,
+          typename = detail::disable_if_policy_t<Iter1>>
+Tp transform_reduce(Iter1 first1, Iter1 last1, Iter2 first2, Tp init, ReduceOp reduce_op, TransformOp transform_op)
 {
-    int count = 0;
-    while (first != last) {
-        ++first;
+    for (; first1 != last1; ++first1, ++first2) {
+        init = reduce_op(mystl::move(init), transform_op(*first1, *first2));
+    }
+    return init;
+}
+
+// 内积
+template <typename Iter1, typename Iter2, typename Tp, typename = detail::disable_if_policy_t<Iter1>>
+Tp transform_reduce(Iter1 first1, Iter1 last1, Iter2 first2, Tp init)
+{
+    return mystl::transform_reduce(first1, last1, first2, mystl::move(init), std::plus<>(), std::multiplies<>());
+}
+
+template <typename Iter, typename Pred, typename = detail::disable_if_policy_t<Iter>>
+std::ptrdiff_t count_if(Iter first, Iter last, Pred pred)
+{
+    std::ptrdiff_t count = 0;
+    for (; first != last; ++first) {
+        if (pred(*first)) ++count;
     }
     return count;
 }
 
-template <typename Iter, typename Func>
-Func for_each(Iter first, Iter last, Func func)
+template <typename Iter, typename Pred, typename = detail::disable_if_policy_t<Iter>>
+Iter find_if(Iter first, Iter last, Pred pred)
 {
     for (; first != last; ++first) {
-        func(*first);
+        if (pred(*first)) return first;
     }
-    return func;
+    return last;
+}
+
+template <typename Iter, typename Pred, typename = detail::disable_if_policy_t<Iter>>
+bool any_of(Iter first, Iter last, Pred pred)
+{
+    return mystl::find_if(first, last, pred) != last;
+}
+
+// ---- 带执行策略的版本 ----
+// 随机访问区间按下标切块：par / par_unseq 把块交给线程池，unseq / par_unseq 的块内循环允许向量化。
+// 不支持随机访问的迭代器退回普通顺序版本
+namespace detail
+{
+// 每个线程分到的块数，多分几块便于负载均衡
+constexpr std::ptrdiff_t k_chunks_per_thread = 4;
+// unseq 归约使用的独立累加器个数
+constexpr std::ptrdiff_t k_reduce_lanes = 8;
+// find_if 每隔多少个元素检查一次是否已有更靠前的结果；unseq 时也是块内向量化判断的块长
+constexpr std::ptrdiff_t k_find_block = 64;
+
+template <typename Policy>
+struct is_parallel_policy : std::false_type {};
+
+template <bool Vectorize>
+struct is_parallel_policy<execution::basic_parallel_policy<Vectorize>> : std::true_type {};
+
+template <typename Policy>
+struct is_vectorized_policy : std::integral_constant<bool, std::is_same<Policy, execution::unsequenced_policy>::value> {};
+
+template <bool Vectorize>
+struct is_vectorized_policy<execution::basic_parallel_policy<Vectorize>> : std::integral_constant<bool, Vectorize> {};
+
+// 每个块的部分结果独占一条缓存行，避免伪共享
+template <typename Tp>
+struct alignas(64) padded_value
+{
+    Tp value;
+};
+
+template <typename Policy>
+std::ptrdiff_t chunk_size(const Policy& policy, std::ptrdiff_t n)
+{
+    // 确定性模式的分块只取决于 grain，与线程数无关
+    if (policy.is_deterministic()) return policy.grain_size();
+    const std::ptrdiff_t parts = static_cast<std::ptrdiff_t>(policy.pool().size()) * k_chunks_per_thread;
+    const std::ptrdiff_t even = (n + parts - 1) / parts;
+    return even > policy.grain_size() ? even : policy.grain_size();
+}
+
+// 把 [0, n) 切成长度为 chunk 的块，func(begin, end, index) 处理一块。
+// 第 0 块由当前线程执行，其余交给线程池
+template <typename Func>
+void parallel_chunks(thread_pool& pool, std::ptrdiff_t n, std::ptrdiff_t chunk, Func& func)
+{
+    const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+    if (chunks <= 1 || pool.size() == 1) {
+        for (std::ptrdiff_t c = 0; c < chunks; ++c)
+            func(c * chunk, (c + 1) * chunk < n ? (c + 1) * chunk : n, c);
+        return;
+    }
+    task_group group(pool);
+    for (std::ptrdiff_t c = 1; c < chunks; ++c) {
+        group.run([&func, c, chunk, n] { func(c * chunk, (c + 1) * chunk < n ? (c + 1) * chunk : n, c); });
+    }
+    func(0, chunk, 0);
+    group.wait();
+}
+
+// get(i) 返回第 i 个（变换后的）元素。向量化版本用 8 个独立累加器打破循环依赖，
+// 每一步的 8 次 op 互不依赖，编译器可以合成一条向量指令
+template <bool Vectorize, typename Tp, typename BinaryOp, typename Get>
+Tp reduce_index(std::ptrdiff_t b, std::ptrdiff_t e, Tp init, BinaryOp& op, Get& get)
+{
+    if (!Vectorize || e - b < 2 * k_reduce_lanes) {
+        for (; b < e; ++b) init = op(mystl::move(init), get(b));
+        return init;
+    }
+    Tp acc[k_reduce_lanes] = {Tp(get(b)), Tp(get(b + 1)), Tp(get(b + 2)), Tp(get(b + 3)),
+                              Tp(get(b + 4)), Tp(get(b + 5)), Tp(get(b + 6)), Tp(get(b + 7))};
+    std::ptrdiff_t i = b + k_reduce_lanes;
+    for (; i + k_reduce_lanes <= e; i += k_reduce_lanes) {
+        for (std::ptrdiff_t j = 0; j < k_reduce_lanes; ++j)
+            acc[j] = op(mystl::move(acc[j]), get(i + j));
+    }
+    for (; i < e; ++i) acc[0] = op(mystl::move(acc[0]), get(i));
+    for (std::ptrdiff_t width = k_reduce_lanes / 2; width > 0; width /= 2) {
+        for (std::ptrdiff_t j = 0; j < width; ++j)
+            acc[j] = op(mystl::move(acc[j]), mystl::move(acc[j + width]));
+    }
+    return op(mystl::move(init), mystl::move(acc[0]));
+}
+
+template <typename Policy, typename Func>
+void policy_for_each(const Policy& policy, std::ptrdiff_t n, Func& func)
+{
+    constexpr bool vectorize = is_vectorized_policy<Policy>::value;
+    auto body = [&func](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t) {
+        if (vectorize) {
+            MYSTL_SIMD_LOOP
+            for (std::ptrdiff_t i = b; i < e; ++i) func(i);
+        } else {
+            for (std::ptrdiff_t i = b; i < e; ++i) func(i);
+        }
+    };
+    if constexpr (is_parallel_policy<Policy>::value) {
+        detail::parallel_chunks(policy.pool(), n, detail::chunk_size(policy, n), body);
+    } else {
+        body(0, n, 0);
+    }
+}
+
+// 并行时每块从自己的第一个元素开始归约，最后按块序合并到 init 上
+template <typename Policy, typename Tp, typename BinaryOp, typename Get>
+Tp policy_reduce(const Policy& policy, std::ptrdiff_t n, Tp init, BinaryOp& op, Get& get)
+{
+    constexpr bool vectorize = is_vectorized_policy<Policy>::value;
+    if constexpr (is_parallel_policy<Policy>::value) {
+        if (n == 0) return init;
+        const std::ptrdiff_t chunk = detail::chunk_size(policy, n);
+        const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+        std::vector<padded_value<Tp>> partial(static_cast<std::size_t>(chunks), padded_value<Tp>{init});
+        auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t c) {
+            partial[c].value = detail::reduce_index<vectorize>(b + 1, e, Tp(get(b)), op, get);
+        };
+        detail::parallel_chunks(policy.pool(), n, chunk, body);
+        for (auto& p : partial) init = op(mystl::move(init), mystl::move(p.value));
+        return init;
+    } else {
+        return detail::reduce_index<vectorize>(0, n, mystl::move(init), op, get);
+    }
+}
+
+template <typename Tp>
+void atomic_fetch_min(std::atomic<Tp>& target, Tp value)
+{
+    Tp current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+// 返回第一个满足 pred(i) 的下标，没有则返回 n
+template <bool Vectorize, typename Pred>
+std::ptrdiff_t find_index(std::ptrdiff_t b, std::ptrdiff_t e, Pred& pred)
+{
+    if (Vectorize) {
+        // 先整块判断有没有命中（无分支、可向量化），命中后再逐个找位置
+        for (; b + k_find_block <= e; b += k_find_block) {
+            unsigned hits = 0;
+            MYSTL_SIMD_LOOP
+            for (std::ptrdiff_t i = b; i < b + k_find_block; ++i) hits |= pred(i) ? 1u : 0u;
+            if (hits) break;
+        }
+    }
+    for (; b < e; ++b) {
+        if (pred(b)) return b;
+    }
+    return -1;
+}
+
+template <typename Policy, typename Pred>
+std::ptrdiff_t policy_find_if(const Policy& policy, std::ptrdiff_t n, Pred& pred)
+{
+    constexpr bool vectorize = is_vectorized_policy<Policy>::value;
+    if constexpr (is_parallel_policy<Policy>::value) {
+        std::atomic<std::ptrdiff_t> found{n};
+        auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t) {
+            for (; b < e; b += k_find_block) {
+                // 更靠前的位置已经找到，这一块不可能是答案
+                if (found.load(std::memory_order_relaxed) < b) return;
+                std::ptrdiff_t hit = detail::find_index<vectorize>(b, b + k_find_block < e ? b + k_find_block : e, pred);
+                if (hit >= 0) {
+                    detail::atomic_fetch_min(found, hit);
+                    return;
+                }
+            }
+        };
+        detail::parallel_chunks(policy.pool(), n, detail::chunk_size(policy, n), body);
+        return found.load();
+    } else {
+        std::ptrdiff_t hit = detail::find_index<vectorize>(0, n, pred);
+        return hit >= 0 ? hit : n;
+    }
+}
+
+} // namespace detail
+
+template <typename Policy, typename Iter, typename Func>
+detail::enable_if_policy_t<Policy, void> for_each(Policy&& policy, Iter first, Iter last, Func func)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        auto body = [first, &func](std::ptrdiff_t i) { func(*(first + i)); };
+        detail::policy_for_each(policy, last - first, body);
+    } else {
+        mystl::for_each(first, last, func);
+    }
+}
+
+template <typename Policy, typename Iter, typename Size, typename Func>
+detail::enable_if_policy_t<Policy, Iter> for_each_n(Policy&& policy, Iter first, Size n, Func func)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        if (n <= 0) return first;
+        auto body = [first, &func](std::ptrdiff_t i) { func(*(first + i)); };
+        detail::policy_for_each(policy, static_cast<std::ptrdiff_t>(n), body);
+        return first + static_cast<std::ptrdiff_t>(n);
+    } else {
+        return mystl::for_each_n(first, n, func);
+    }
+}
+
+template <typename Policy, typename Iter, typename Out, typename UnaryOp>
+detail::enable_if_policy_t<Policy, Out> transform(Policy&& policy, Iter first, Iter last, Out d_first, UnaryOp op)
+{
+    if constexpr (is_random_access_iterator<Iter>::value && is_random_access_iterator<Out>::value) {
+        const std::ptrdiff_t n = last - first;
+        auto body = [first, d_first, &op](std::ptrdiff_t i) { *(d_first + i) = op(*(first + i)); };
+        detail::policy_for_each(policy, n, body);
+        return d_first + n;
+    } else {
+        return mystl::transform(first, last, d_first, op);
+    }
+}
+
+template <typename Policy, typename Iter1, typename Iter2, typename Out, typename BinaryOp>
+detail::enable_if_policy_t<Policy, Out> transform(Policy&& policy, Iter1 first1, Iter1 last1, Iter2 first2, Out d_first, BinaryOp op)
+{
+    if constexpr (is_random_access_iterator<Iter1>::value && is_random_access_iterator<Iter2>::value
+                  && is_random_access_iterator<Out>::value) {
+        const std::ptrdiff_t n = last1 - first1;
+        auto body = [first1, first2, d_first, &op](std::ptrdiff_t i) { *(d_first + i) = op(*(first1 + i), *(first2 + i)); };
+        detail::policy_for_each(policy, n, body);
+        return d_first + n;
+    } else {
+        return mystl::transform(first1, last1, first2, d_first, op);
+    }
+}
+
+// 浮点数的归约结果与合并顺序有关：seq 严格从左到右；unseq 用 8 个累加器；
+// par / par_unseq 的分块随线程数变化，需要结果可复现时用 par.deterministic()
+template <typename Policy, typename Iter, typename Tp, typename BinaryOp = std::plus<>>
+detail::enable_if_policy_t<Policy, Tp> reduce(Policy&& policy, Iter first, Iter last, Tp init, BinaryOp op = {})
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        auto get = [first](std::ptrdiff_t i) -> decltype(auto) { return *(first + i); };
+        return detail::policy_reduce(policy, last - first, mystl::move(init), op, get);
+    } else {
+        return mystl::reduce(first, last, mystl::move(init), op);
+    }
+}
+
+template <typename Policy, typename Iter, typename Tp, typename ReduceOp, typename TransformOp>
+detail::enable_if_policy_t<Policy, Tp> transform_reduce(Policy&& policy, Iter first, Iter last, Tp init,
+                                                        ReduceOp reduce_op, TransformOp transform_op)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        auto get = [first, &transform_op](std::ptrdiff_t i) { return transform_op(*(first + i)); };
+        return detail::policy_reduce(policy, last - first, mystl::move(init), reduce_op, get);
+    } else {
+        return mystl::transform_reduce(first, last, mystl::move(init), reduce_op, transform_op);
+    }
+}
+
+template <typename Policy, typename Iter1, typename Iter2, typename Tp, typename ReduceOp, typename TransformOp>
+detail::enable_if_policy_t<Policy, Tp> transform_reduce(Policy&& policy, Iter1 first1, Iter1 last1, Iter2 first2, Tp init,
+                                                        ReduceOp reduce_op, TransformOp transform_op)
+{
+    if constexpr (is_random_access_iterator<Iter1>::value && is_random_access_iterator<Iter2>::value) {
+        auto get = [first1, first2, &transform_op](std::ptrdiff_t i) { return transform_op(*(first1 + i), *(first2 + i)); };
+        return detail::policy_reduce(policy, last1 - first1, mystl::move(init), reduce_op, get);
+    } else {
+        return mystl::transform_reduce(first1, last1, first2, mystl::move(init), reduce_op, transform_op);
+    }
+}
+
+template <typename Policy, typename Iter1, typename Iter2, typename Tp>
+detail::enable_if_policy_t<Policy, Tp> transform_reduce(Policy&& policy, Iter1 first1, Iter1 last1, Iter2 first2, Tp init)
+{
+    return mystl::transform_reduce(policy, first1, last1, first2, mystl::move(init), std::plus<>(), std::multiplies<>());
+}
+
+template <typename Policy, typename Iter, typename Pred>
+detail::enable_if_policy_t<Policy, std::ptrdiff_t> count_if(Policy&& policy, Iter first, Iter last, Pred pred)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        // 谓词结果转成 0 / 1 再求和，循环中没有分支
+        auto get = [first, &pred](std::ptrdiff_t i) { return static_cast<std::ptrdiff_t>(pred(*(first + i)) ? 1 : 0); };
+        std::plus<> op;
+        return detail::policy_reduce(policy, last - first, std::ptrdiff_t(0), op, get);
+    } else {
+        return mystl::count_if(first, last, pred);
+    }
+}
+
+template <typename Policy, typename Iter, typename Pred>
+detail::enable_if_policy_t<Policy, Iter> find_if(Policy&& policy, Iter first, Iter last, Pred pred)
+{
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        auto test = [first, &pred](std::ptrdiff_t i) { return static_cast<bool>(pred(*(first + i))); };
+        return first + detail::policy_find_if(policy, last - first, test);
+    } else {
+        return mystl::find_if(first, last, pred);
+    }
+}
+
+template <typename Policy, typename Iter, typename Pred>
+detail::enable_if_policy_t<Policy, bool> any_of(Policy&& policy, Iter first, Iter last, Pred pred)
+{
+    return mystl::find_if(policy, first, last, pred) != last;
 }
 
 } // namespace mystl
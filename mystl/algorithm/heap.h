@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "../utility.h"
+#include "algobase.h"
+
+namespace mystl
+{
+
+// ---- 二叉堆 ----
+// 以 [first, last) 表示一棵完全二叉树，下标 i 的孩子为 2i+1 / 2i+2，
+// comp 为 "小于" 时得到大顶堆，与 std::make_heap 语义一致。
+namespace detail
+{
+
+// 将 value 从 hole 位置向上冒泡，直到不再大于父节点或到达 top
+template <typename Iter, typename Tp, typename Compare>
+void push_heap_aux(Iter first, std::ptrdiff_t hole, std::ptrdiff_t top, Tp value, Compare& comp)
+{
+    std::ptrdiff_t parent = (hole - 1) / 2;
+    while (hole > top && comp(*(first + parent), value)) {
+        *(first + hole) = mystl::move(*(first + parent));
+        hole = parent;
+        parent = (hole - 1) / 2;
+    }
+    *(first + hole) = mystl::move(value);
+}
+
+// Floyd 式下沉：先把空洞一路沉到叶子（每层只比较一次两个孩子），再把 value 向上冒泡回来
+template <typename Iter, typename Tp, typename Compare>
+void adjust_heap(Iter first, std::ptrdiff_t hole, std::ptrdiff_t len, Tp value, Compare& comp)
+{
+    const std::ptrdiff_t top = hole;
+    std::ptrdiff_t child = hole;
+    while (child < (len - 1) / 2) {
+        child = 2 * (child + 1);
+        if (comp(*(first + child), *(first + (child - 1)))) --child;
+        *(first + hole) = mystl::move(*(first + child));
+        hole = child;
+    }
+    if ((len & 1) == 0 && child == (len - 2) / 2) {
+        child = 2 * (child + 1);
+        *(first + hole) = mystl::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+    push_heap_aux(first, hole, top, mystl::move(value), comp);
+}
+
+// 把堆顶移到 result，result 原来的值重新放回堆 [first, last)
+template <typename Iter, typename Compare>
+void pop_heap_aux(Iter first, Iter last, Iter result, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    value_type value = mystl::move(*result);
+    *result = mystl::move(*first);
+    adjust_heap(first, std::ptrdiff_t(0), std::ptrdiff_t(last - first), mystl::move(value), comp);
+}
+
+} // namespace detail
+
+// [first, last - 1) 已是堆，把 *(last - 1) 加入堆
+template <typename Iter, typename Compare = std::less<>>
+void push_heap(Iter first, Iter last, Compare comp = {})
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    std::ptrdiff_t len = last - first;
+    if (len < 2) return;
+    value_type value = mystl::move(*(first + (len - 1)));
+    detail::push_heap_aux(first, len - 1, std::ptrdiff_t(0), mystl::move(value), comp);
+}
+
+// 把堆顶换到 last - 1，[first, last - 1) 重新成为堆
+template <typename Iter, typename Compare = std::less<>>
+void pop_heap(Iter first, Iter last, Compare comp = {})
+{
+    if (last - first < 2) return;
+    --last;
+    detail::pop_heap_aux(first, last, last, comp);
+}
+
+// 自底向上建堆，O(n)
+template <typename Iter, typename Compare = std::less<>>
+void make_heap(Iter first, Iter last, Compare comp = {})
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    std::ptrdiff_t len = last - first;
+    if (len < 2) return;
+    for (std::ptrdiff_t parent = (len - 2) / 2; ; --parent) {
+        value_type value = mystl::move(*(first + parent));
+        detail::adjust_heap(first, parent, len, mystl::move(value), comp);
+        if (parent == 0) return;
+    }
+}
+
+// 反复 pop_heap，把堆变成升序序列
+template <typename Iter, typename Compare = std::less<>>
+void sort_heap(Iter first, Iter last, Compare comp = {})
+{
+    while (last - first > 1) {
+        --last;
+        detail::pop_heap_aux(first, last, last, comp);
+    }
+}
+
+} // namespace mystl
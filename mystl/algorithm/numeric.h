@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "../execution.h"
+#include "../utility.h"
+#include "algobase.h"
+#include "simd_scan.h"
+
+namespace mystl
+{
+
+// ---- 前缀和 ----
+// inclusive_scan:  out[i] = init op in[0] op ... op in[i]
+// exclusive_scan:  out[i] = init op in[0] op ... op in[i - 1]，out[0] = init
+// 与 std 一样，op 需要满足结合律；d_first 可以与 first 相同（原地前缀和）
+
+template <typename Iter, typename Out, typename BinaryOp, typename Tp, typename = detail::disable_if_policy_t<Iter>>
+Out inclusive_scan(Iter first, Iter last, Out d_first, BinaryOp op, Tp init)
+{
+    for (; first != last; ++first, ++d_first) {
+        init = op(mystl::move(init), *first);
+        *d_first = init;
+    }
+    return d_first;
+}
+
+template <typename Iter, typename Out, typename BinaryOp = std::plus<>, typename = detail::disable_if_policy_t<Iter>>
+Out inclusive_scan(Iter first, Iter last, Out d_first, BinaryOp op = {})
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    if (first == last) return d_first;
+    value_type init = *first;
+    *d_first = init;
+    return mystl::inclusive_scan(++first, last, ++d_first, op, mystl::move(init));
+}
+
+template <typename Iter, typename Out, typename Tp, typename BinaryOp = std::plus<>, typename = detail::disable_if_policy_t<Iter>>
+Out exclusive_scan(Iter first, Iter last, Out d_first, Tp init, BinaryOp op = {})
+{
+    for (; first != last; ++first, ++d_first) {
+        // 先读 *first 再写 *d_first，原地时不会读到已经写过的值
+        Tp next = op(init, *first);
+        *d_first = mystl::move(init);
+        init = mystl::move(next);
+    }
+    return d_first;
+}
+
+template <typename Iter, typename Out, typename Tp, typename BinaryOp, typename UnaryOp,
+          typename = detail::disable_if_policy_t<Iter>>
+Out transform_exclusive_scan(Iter first, Iter last, Out d_first, Tp init, BinaryOp binary_op, UnaryOp unary_op)
+{
+    for (; first != last; ++first, ++d_first) {
+        Tp next = binary_op(init, unary_op(*first));
+        *d_first = mystl::move(init);
+        init = mystl::move(next);
+    }
+    return d_first;
+}
+
+// ---- 带执行策略的版本 ----
+// seq / par 块内逐个元素扫描；unseq / par_unseq 在元素为 32 / 64 位整数或浮点、op 为加法、
+// 输入输出都是指针时（mystl::vector 的迭代器即是）使用寄存器内移位相加的 SIMD 前缀和。
+// par / par_unseq 两遍扫描：第一遍各块并行求和，按块序对块和做一次串行的 exclusive scan 得到各块的起始值，
+// 第二遍各块从起始值开始并行扫描。每个元素读两次写一次，第一遍只读，原地前缀和同样成立
+namespace detail
+{
+
+// 逐个元素扫描 [b, e)：get(i) 返回第 i 个（变换后的）输入，put(i, v) 写第 i 个输出，返回扫描完之后的累计值
+template <bool Inclusive, typename Tp, typename BinaryOp, typename Get, typename Put>
+Tp scan_index(std::ptrdiff_t b, std::ptrdiff_t e, Tp init, BinaryOp& op, Get& get, Put& put)
+{
+    for (; b < e; ++b) {
+        if (Inclusive) {
+            init = op(mystl::move(init), get(b));
+            put(b, init);
+        } else {
+            Tp next = op(init, get(b));
+            put(b, mystl::move(init));
+            init = mystl::move(next);
+        }
+    }
+    return init;
+}
+
+// scan(b, e, carry) 以 carry 为起始值扫描 [b, e) 并返回之后的累计值
+template <typename Policy, typename Tp, typename BinaryOp, typename Get, typename Scan>
+void policy_scan(const Policy& policy, std::ptrdiff_t n, Tp init, BinaryOp& op, Get& get, Scan& scan)
+{
+    if constexpr (is_parallel_policy<Policy>::value) {
+        constexpr bool vectorize = is_vectorized_policy<Policy>::value;
+        const std::ptrdiff_t chunk = detail::chunk_size(policy, n);
+        const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+        if (chunks <= 1) {
+            scan(0, n, mystl::move(init));
+            return;
+        }
+
+        std::vector<padded_value<Tp>> carry(static_cast<std::size_t>(chunks), padded_value<Tp>{init});
+        auto sum = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t c) {
+            carry[c].value = detail::reduce_index<vectorize>(b + 1, e, Tp(get(b)), op, get);
+        };
+        detail::parallel_chunks(policy.pool(), n, chunk, sum);
+
+        // 块和 -> 各块的起始值
+        for (auto& c : carry) {
+            Tp next = op(init, mystl::move(c.value));
+            c.value = mystl::move(init);
+            init = mystl::move(next);
+        }
+
+        auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t c) { scan(b, e, mystl::move(carry[c].value)); };
+        detail::parallel_chunks(policy.pool(), n, chunk, body);
+    } else {
+        scan(0, n, mystl::move(init));
+    }
+}
+
+template <bool Inclusive, typename Policy, typename Iter, typename Out, typename Tp, typename BinaryOp>
+Out policy_scan_range(const Policy& policy, Iter first, Iter last, Out d_first, Tp init, BinaryOp& op)
+{
+    const std::ptrdiff_t n = last - first;
+    auto get = [first](std::ptrdiff_t i) -> decltype(auto) { return *(first + i); };
+    if constexpr (is_vectorized_policy<Policy>::value && is_simd_scannable<Iter, Out, Tp, BinaryOp>::value) {
+        auto scan = [first, d_first](std::ptrdiff_t b, std::ptrdiff_t e, Tp carry) {
+            return detail::simd_scan<Inclusive>(first + b, d_first + b, static_cast<std::size_t>(e - b), carry);
+        };
+        detail::policy_scan(policy, n, mystl::move(init), op, get, scan);
+    } else {
+        auto put = [d_first](std::ptrdiff_t i, Tp value) { *(d_first + i) = mystl::move(value); };
+        auto scan = [&op, &get, &put](std::ptrdiff_t b, std::ptrdiff_t e, Tp carry) {
+            return detail::scan_index<Inclusive>(b, e, mystl::move(carry), op, get, put);
+        };
+        detail::policy_scan(policy, n, mystl::move(init), op, get, scan);
+    }
+    return d_first + n;
+}
+
+} // namespace detail
+
+template <typename Policy, typename Iter, typename Out, typename BinaryOp, typename Tp>
+detail::enable_if_policy_t<Policy, Out> inclusive_scan(Policy&& policy, Iter first, Iter last, Out d_first, BinaryOp op, Tp init)
+{
+    if constexpr (is_random_access_iterator<Iter>::value && is_random_access_iterator<Out>::value) {
+        return detail::policy_scan_range<true>(policy, first, last, d_first, mystl::move(init), op);
+    } else {
+        return mystl::inclusive_scan(first, last, d_first, op, mystl::move(init));
+    }
+}
+
+template <typename Policy, typename Iter, typename Out, typename BinaryOp = std::plus<>>
+detail::enable_if_policy_t<Policy, Out> inclusive_scan(Policy&& policy, Iter first, Iter last, Out d_first, BinaryOp op = {})
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    if (first == last) return d_first;
+    value_type init = *first;
+    *d_first = init;
+    return mystl::inclusive_scan(policy, ++first, last, ++d_first, op, mystl::move(init));
+}
+
+template <typename Policy, typename Iter, typename Out, typename Tp, typename BinaryOp = std::plus<>>
+detail::enable_if_policy_t<Policy, Out> exclusive_scan(Policy&& policy, Iter first, Iter last, Out d_first, Tp init, BinaryOp op = {})
+{
+    if constexpr (is_random_access_iterator<Iter>::value && is_random_access_iterator<Out>::value) {
+        return detail::policy_scan_range<false>(policy, first, last, d_first, mystl::move(init), op);
+    } else {
+        return mystl::exclusive_scan(first, last, d_first, mystl::move(init), op);
+    }
+}
+
+template <typename Policy, typename Iter, typename Out, typename Tp, typename BinaryOp, typename UnaryOp>
+detail::enable_if_policy_t<Policy, Out> transform_exclusive_scan(Policy&& policy, Iter first, Iter last, Out d_first, Tp init,
+                                                                 BinaryOp binary_op, UnaryOp unary_op)
+{
+    if constexpr (is_random_access_iterator<Iter>::value && is_random_access_iterator<Out>::value) {
+        const std::ptrdiff_t n = last - first;
+        auto get = [first, &unary_op](std::ptrdiff_t i) { return unary_op(*(first + i)); };
+        auto put = [d_first](std::ptrdiff_t i, Tp value) { *(d_first + i) = mystl::move(value); };
+        auto scan = [&binary_op, &get, &put](std::ptrdiff_t b, std::ptrdiff_t e, Tp carry) {
+            return detail::scan_index<false>(b, e, mystl::move(carry), binary_op, get, put);
+        };
+        detail::policy_scan(policy, n, mystl::move(init), binary_op, get, scan);
+        return d_first + n;
+    } else {
+        return mystl::transform_exclusive_scan(first, last, d_first, mystl::move(init), binary_op, unary_op);
+    }
+}
+
+} // namespace mystl
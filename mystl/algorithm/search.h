@@ -1,18 +1,39 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../iterator.h"
+#include "../shared_ptr.h"
+#include "../thread_pool.h"
 #include "../vector.h"
+#include "algobase.h"
+#include "sort.h"
 
 namespace mystl
 {
+// KMP 从不回退文本，文本只需要逐个前进，前向迭代器即可；
+// 模式串先拷贝到 vector 中按下标访问，任何前向迭代器都是 O(n + m)
 template <typename Iter>
 Iter kmp_search(Iter s_start, Iter s_last, Iter patt_b, Iter patt_e) {
-    size_t str_size = s_last - s_start;
-    size_t patt_size = patt_e - patt_b;
-
-    int *lps = new int[patt_size];
+    static_assert(is_forward_iterator<Iter>::value, "mystl::kmp_search requires forward iterators");
+    const vector<iter_value_t<Iter>> patt(patt_b, patt_e);
+    const size_t patt_size = patt.size();
+    if (patt_size == 0) return s_start;
 
+    vector<size_t> lps(patt_size, 0);
     for (size_t i = 1, len = 0; i < patt_size;) {
-        if (*(patt_b + i) == *(patt_b + len)) {
+        if (patt[i] == patt[len]) {
             lps[i++] = ++len;
         } else if (len != 0) {
             len = lps[len - 1];
@@ -21,18 +42,1011 @@ Iter kmp_search(Iter s_start, Iter s_last, Iter patt_b, Iter patt_e) {
         }
     }
 
+    // i 为 it 在文本中的下标，匹配成功时结果从 it 往回 j 个位置
     size_t i = 0;
     size_t j = 0;
-    while (i < str_size) {
-        if (*(s_start + i) == *(patt_b + j)) { 
-            ++i; ++j;
-            if (j == patt_size) return s_start + i - j;
+    for (Iter it = s_start; it != s_last;) {
+        if (*it == patt[j]) {
+            ++it; ++i; ++j;
+            if (j == patt_size) return mystl::next(s_start, i - j);
         }
         else if (j > 0) { j = lps[j - 1]; }
-        else { ++i; }
+        else { ++it; ++i; }
     }
-
-    delete[] lps;
     return s_last;
 }
-}
\ No newline at end of file
+
+// ========== 预编译的搜索器 ==========
+// 模式串和预处理表在构造时计算一次，放在共享的只读块中：拷贝搜索器只增加引用计数，
+// operator() 是 const 的，多个线程可以同时使用同一个搜索器。
+// 约定与 std::boyer_moore_horspool_searcher 相同: operator()(first, last) 返回匹配区间
+// [match, match + m)，没有匹配时返回 (last, last)；空模式匹配在 first
+namespace detail
+{
+template <typename T>
+struct kmp_table
+{
+    vector<T> pattern;
+    vector<std::size_t> lps;  // lps[i]: pattern[0, i] 最长的相等真前缀、后缀的长度
+};
+
+// 单字节元素用 256 项的数组做跳转表，其余元素用哈希表
+template <typename T, typename Pred>
+struct is_byte_alphabet
+    : std::integral_constant<bool, sizeof(T) == 1 && std::is_integral<T>::value &&
+                                       (std::is_same<Pred, std::equal_to<T>>::value || std::is_same<Pred, std::equal_to<>>::value)> {};
+
+template <typename T, typename Hash, typename Pred>
+struct bmh_table
+{
+    static constexpr bool byte = is_byte_alphabet<T, Pred>::value;
+    using shift_table = std::conditional_t<byte, std::array<std::size_t, 256>, std::unordered_map<T, std::size_t, Hash, Pred>>;
+
+    vector<T> pattern;
+    shift_table shift;  // 窗口末尾字符为 c 时窗口可以右移的距离，不在表中的字符右移 m
+
+    bmh_table(const Hash& hash, const Pred& pred) : shift(make_table(hash, pred)) {}
+
+private:
+    static shift_table make_table(const Hash& hash, const Pred& pred)
+    {
+        if constexpr (byte) {
+            (void)hash;
+            (void)pred;
+            return shift_table();
+        } else {
+            return shift_table(0, hash, pred);
+        }
+    }
+};
+
+template <typename T>
+struct two_way_table
+{
+    vector<T> pattern;
+    std::size_t suffix = 0;   // 临界分解位置: pattern = u v，v 从 suffix 开始
+    std::size_t period = 0;   // 模式串的周期 (periodic 为 false 时是保守的移动距离)
+    bool periodic = false;
+};
+
+template <typename Iter, typename T>
+vector<T> copy_pattern(Iter first, Iter last)
+{
+    vector<T> p;
+    for (; first != last; ++first) p.push_back(*first);
+    return p;
+}
+} // namespace detail
+
+// KMP: 文本只逐个前进，不回退，可以用于前向迭代器 (链表、单趟的流)；最坏 O(n + m)
+template <typename T, typename Pred = std::equal_to<T>>
+class kmp_searcher
+{
+    shared_ptr<const detail::kmp_table<T>> table_;
+    Pred pred_;
+
+    template <typename, typename>
+    friend class kmp_stream;
+
+public:
+    template <typename PatIter>
+    kmp_searcher(PatIter first, PatIter last, Pred pred = Pred()) : pred_(pred)
+    {
+        auto t = mystl::make_shared<detail::kmp_table<T>>();
+        t->pattern = detail::copy_pattern<PatIter, T>(first, last);
+        const vector<T>& p = t->pattern;
+        t->lps = vector<std::size_t>(p.size());
+        for (std::size_t i = 1, len = 0; i < p.size();) {
+            if (pred_(p[i], p[len])) {
+                t->lps[i++] = ++len;
+            } else if (len != 0) {
+                len = t->lps[len - 1];
+            } else {
+                t->lps[i++] = 0;
+            }
+        }
+        table_ = t;
+    }
+
+    std::size_t pattern_size() const noexcept { return table_->pattern.size(); }
+
+    template <typename Iter>
+    std::pair<Iter, Iter> operator()(Iter first, Iter last) const
+    {
+        static_assert(is_forward_iterator<Iter>::value, "mystl::kmp_searcher requires forward iterators");
+        const vector<T>& p = table_->pattern;
+        const vector<std::size_t>& lps = table_->lps;
+        const std::size_t m = p.size();
+        if (m == 0) return {first, first};
+
+        std::size_t i = 0, j = 0;
+        for (Iter it = first; it != last;) {
+            if (pred_(*it, p[j])) {
+                ++it; ++i; ++j;
+                if (j == m) return {mystl::next(first, i - m), it};
+            } else if (j > 0) {
+                j = lps[j - 1];
+            } else {
+                ++it; ++i;
+            }
+        }
+        return {last, last};
+    }
+};
+
+// Boyer-Moore-Horspool: 先比较窗口末尾字符，不匹配时按末尾字符查表跳过，
+// 字母表大、模式较长时平均每次跳过接近 m 个字符；最坏 O(n * m) (如在 "aaa..." 中找 "baa...a")
+template <typename T, typename Hash = std::hash<T>, typename Pred = std::equal_to<T>>
+class boyer_moore_horspool_searcher
+{
+    using table_type = detail::bmh_table<T, Hash, Pred>;
+
+    shared_ptr<const table_type> table_;
+    Pred pred_;
+
+public:
+    template <typename PatIter>
+    boyer_moore_horspool_searcher(PatIter first, PatIter last, Hash hash = Hash(), Pred pred = Pred()) : pred_(pred)
+    {
+        auto t = mystl::make_shared<table_type>(hash, pred);
+        t->pattern = detail::copy_pattern<PatIter, T>(first, last);
+        const vector<T>& p = t->pattern;
+        const std::size_t m = p.size();
+        if constexpr (table_type::byte) {
+            t->shift.fill(m);
+            for (std::size_t i = 0; i + 1 < m; ++i) t->shift[static_cast<unsigned char>(p[i])] = m - 1 - i;
+        } else {
+            for (std::size_t i = 0; i + 1 < m; ++i) t->shift[p[i]] = m - 1 - i;
+        }
+        table_ = t;
+    }
+
+    std::size_t pattern_size() const noexcept { return table_->pattern.size(); }
+
+    template <typename Iter>
+    std::pair<Iter, Iter> operator()(Iter first, Iter last) const
+    {
+        static_assert(is_random_access_iterator<Iter>::value, "mystl::boyer_moore_horspool_searcher requires random access iterators");
+        const table_type& t = *table_;
+        const T* p = t.pattern.data();
+        const std::size_t m = t.pattern.size();
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (m == 0) return {first, first};
+        if (n < m) return {last, last};
+
+        for (std::size_t pos = 0; pos <= n - m;) {
+            const auto& c = first[pos + m - 1];
+            if (pred_(c, p[m - 1])) {
+                std::size_t k = 0;
+                while (k + 1 < m && pred_(first[pos + k], p[k])) ++k;
+                if (k + 1 == m) return {first + pos, first + (pos + m)};
+            }
+            pos += shift_of(t, c);
+        }
+        return {last, last};
+    }
+
+private:
+    template <typename C>
+    static std::size_t shift_of(const table_type& t, const C& c)
+    {
+        if constexpr (table_type::byte) {
+            return t.shift[static_cast<unsigned char>(c)];
+        } else {
+            auto it = t.shift.find(c);
+            return it == t.shift.end() ? t.pattern.size() : it->second;
+        }
+    }
+};
+
+// Two-Way (Crochemore-Perrin): 按临界分解把模式串分为 u v，先从左往右比较 v，再从右往左比较 u，
+// 利用周期决定移动距离。最坏 O(n + m)，额外空间 O(1)，不需要跳转表，
+// 适合长模式、小字母表 (DNA、二进制) 和周期性强的模式；元素需要 == 和 <
+template <typename T>
+class two_way_searcher
+{
+    shared_ptr<const detail::two_way_table<T>> table_;
+
+    // 最大后缀: reverse 为 false 时按 <，为 true 时按 >；返回后缀的起点 - 1 和周期
+    static std::pair<std::ptrdiff_t, std::size_t> maximal_suffix(const vector<T>& p, bool reverse)
+    {
+        const std::size_t m = p.size();
+        std::ptrdiff_t ms = -1;
+        std::size_t j = 0, k = 1, period = 1;
+        while (j + k < m) {
+            const T& a = p[j + k];
+            const T& b = p[static_cast<std::size_t>(ms + static_cast<std::ptrdiff_t>(k))];
+            if (reverse ? b < a : a < b) {
+                j += k;
+                k = 1;
+                period = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(j) - ms);
+            } else if (a == b) {
+                if (k != period) {
+                    ++k;
+                } else {
+                    j += period;
+                    k = 1;
+                }
+            } else {
+                ms = static_cast<std::ptrdiff_t>(j++);
+                k = period = 1;
+            }
+        }
+        return {ms, period};
+    }
+
+public:
+    template <typename PatIter>
+    two_way_searcher(PatIter first, PatIter last)
+    {
+        auto t = mystl::make_shared<detail::two_way_table<T>>();
+        t->pattern = detail::copy_pattern<PatIter, T>(first, last);
+        const vector<T>& p = t->pattern;
+        const std::size_t m = p.size();
+        if (m > 0) {
+            // 临界分解取两种顺序下最大后缀中较靠后的一个
+            auto fwd = maximal_suffix(p, false);
+            auto rev = maximal_suffix(p, true);
+            auto best = rev.first < fwd.first ? fwd : rev;
+            t->suffix = static_cast<std::size_t>(best.first + 1);
+            t->period = best.second;
+            // u 是 v 的周期部分的后缀时模式串以 period 为周期，匹配后可以记住已比较过的前缀
+            t->periodic = t->period + t->suffix <= m;
+            for (std::size_t i = 0; t->periodic && i < t->suffix; ++i) t->periodic = p[i] == p[i + t->period];
+            if (!t->periodic) t->period = (t->suffix > m - t->suffix ? t->suffix : m - t->suffix) + 1;
+        }
+        table_ = t;
+    }
+
+    std::size_t pattern_size() const noexcept { return table_->pattern.size(); }
+
+    template <typename Iter>
+    std::pair<Iter, Iter> operator()(Iter first, Iter last) const
+    {
+        static_assert(is_random_access_iterator<Iter>::value, "mystl::two_way_searcher requires random access iterators");
+        const detail::two_way_table<T>& t = *table_;
+        const T* p = t.pattern.data();
+        const std::size_t m = t.pattern.size();
+        const std::size_t n = static_cast<std::size_t>(last - first);
+        if (m == 0) return {first, first};
+        if (n < m) return {last, last};
+
+        const std::size_t suffix = t.suffix;
+        const std::size_t period = t.period;
+        if (t.periodic) {
+            // memory: 上一次按周期移动后，窗口开头已知匹配的长度
+            std::size_t memory = 0;
+            for (std::size_t j = 0; j <= n - m;) {
+                std::size_t i = suffix > memory ? suffix : memory;
+                while (i < m && p[i] == first[j + i]) ++i;
+                if (i >= m) {
+                    i = suffix;
+                    while (i > memory && p[i - 1] == first[j + i - 1]) --i;
+                    if (i <= memory) return {first + j, first + (j + m)};
+                    j += period;
+                    memory = m - period;
+                } else {
+                    j += i - suffix + 1;
+                    memory = 0;
+                }
+            }
+        } else {
+            for (std::size_t j = 0; j <= n - m;) {
+                std::size_t i = suffix;
+                while (i < m && p[i] == first[j + i]) ++i;
+                if (i >= m) {
+                    i = suffix;
+                    while (i > 0 && p[i - 1] == first[j + i - 1]) --i;
+                    if (i == 0) return {first + j, first + (j + m)};
+                    j += period;
+                } else {
+                    j += i - suffix + 1;
+                }
+            }
+        }
+        return {last, last};
+    }
+};
+
+// 按模式串选择算法的搜索器:
+//   m == 0      空模式
+//   m == 1      查找单个元素 (连续的字节序列用 memchr)
+//   单字节字母表且模式中不同字符足够多 -> Boyer-Moore-Horspool，跳转距离大
+//   其余 (字母表小、周期性强、非字节元素) -> Two-Way，最坏情况也是线性的
+template <typename T>
+class searcher
+{
+public:
+    enum class algorithm { empty, single, horspool, two_way };
+
+private:
+    algorithm algo_ = algorithm::empty;
+    T single_{};
+    shared_ptr<const boyer_moore_horspool_searcher<T>> horspool_;
+    shared_ptr<const two_way_searcher<T>> two_way_;
+    std::size_t size_ = 0;
+
+public:
+    // BMH 要求模式中至少有这么多不同的字符，否则平均跳转距离太短
+    static constexpr std::size_t k_horspool_min_distinct = 4;
+
+    template <typename PatIter>
+    searcher(PatIter first, PatIter last)
+    {
+        vector<T> p = detail::copy_pattern<PatIter, T>(first, last);
+        size_ = p.size();
+        if (size_ == 0) {
+            algo_ = algorithm::empty;
+        } else if (size_ == 1) {
+            algo_ = algorithm::single;
+            single_ = p[0];
+        } else if (detail::is_byte_alphabet<T, std::equal_to<T>>::value && distinct_bytes(p) >= k_horspool_min_distinct) {
+            algo_ = algorithm::horspool;
+            horspool_ = mystl::make_shared<boyer_moore_horspool_searcher<T>>(p.begin(), p.end());
+        } else {
+            algo_ = algorithm::two_way;
+            two_way_ = mystl::make_shared<two_way_searcher<T>>(p.begin(), p.end());
+        }
+    }
+
+    algorithm selected() const noexcept { return algo_; }
+    std::size_t pattern_size() const noexcept { return size_; }
+
+    template <typename Iter>
+    std::pair<Iter, Iter> operator()(Iter first, Iter last) const
+    {
+        switch (algo_) {
+        case algorithm::empty: return {first, first};
+        case algorithm::single: {
+            Iter it = find_single(first, last);
+            return {it, it == last ? last : mystl::next(it)};
+        }
+        case algorithm::horspool: return (*horspool_)(first, last);
+        default: return (*two_way_)(first, last);
+        }
+    }
+
+private:
+    static std::size_t distinct_bytes(const vector<T>& p)
+    {
+        bool seen[256] = {};
+        std::size_t n = 0;
+        for (const T& c : p) {
+            const unsigned char b = static_cast<unsigned char>(c);
+            n += !seen[b];
+            seen[b] = true;
+        }
+        return n;
+    }
+
+    template <typename Iter>
+    Iter find_single(Iter first, Iter last) const
+    {
+        if constexpr (std::is_pointer<Iter>::value && detail::is_byte_alphabet<T, std::equal_to<T>>::value) {
+            const void* hit = std::memchr(first, static_cast<unsigned char>(single_), static_cast<std::size_t>(last - first));
+            return hit ? first + (static_cast<const unsigned char*>(hit) - reinterpret_cast<const unsigned char*>(first)) : last;
+        } else {
+            for (; first != last; ++first) {
+                if (*first == single_) return first;
+            }
+            return last;
+        }
+    }
+};
+
+template <typename PatIter>
+kmp_searcher(PatIter, PatIter) -> kmp_searcher<iter_value_t<PatIter>>;
+
+template <typename PatIter>
+boyer_moore_horspool_searcher(PatIter, PatIter) -> boyer_moore_horspool_searcher<iter_value_t<PatIter>>;
+
+template <typename PatIter>
+two_way_searcher(PatIter, PatIter) -> two_way_searcher<iter_value_t<PatIter>>;
+
+template <typename PatIter>
+searcher(PatIter, PatIter) -> searcher<iter_value_t<PatIter>>;
+
+// 在 [first, last) 中查找 searcher 的模式串，返回第一个匹配的起点，没有时返回 last
+template <typename Iter, typename Searcher>
+Iter search(Iter first, Iter last, const Searcher& s)
+{
+    return s(first, last).first;
+}
+
+// ========== 多模式匹配 (Aho-Corasick) ==========
+enum class match_kind
+{
+    overlapping,       // 所有模式的所有出现，可以重叠，按结束位置报告 (同一位置结束的先报告长的)
+    leftmost_longest,  // 不重叠: 取起点最靠左的匹配中最长的一个，再从它的末尾继续
+};
+
+// 第 pattern 个模式出现在 [begin, end)，下标相对于查找区间的起点
+struct ac_match
+{
+    std::size_t pattern;
+    std::size_t begin;
+    std::size_t end;
+};
+
+namespace detail
+{
+template <typename S, typename = void>
+struct has_data_size : std::false_type {};
+
+template <typename S>
+struct has_data_size<S, std::void_t<decltype(std::declval<const S&>().data()), decltype(std::declval<const S&>().size())>>
+    : std::true_type {};
+
+// 模式可以是 C 字符串、带 data() / size() 的 std::string / string_view，或者带 c_str() / size() 的 mystl::basic_string
+template <typename S>
+std::pair<const unsigned char*, std::size_t> pattern_bytes(const S& s)
+{
+    if constexpr (std::is_convertible<const S&, const char*>::value) {
+        const char* p = s;
+        return {reinterpret_cast<const unsigned char*>(p), std::strlen(p)};
+    } else if constexpr (has_data_size<S>::value) {
+        static_assert(sizeof(*s.data()) == 1, "mystl::aho_corasick patterns must be byte strings");
+        return {reinterpret_cast<const unsigned char*>(s.data()), s.size()};
+    } else {
+        static_assert(sizeof(*s.c_str()) == 1, "mystl::aho_corasick patterns must be byte strings");
+        return {reinterpret_cast<const unsigned char*>(s.c_str()), s.size()};
+    }
+}
+
+// 回调返回 bool 时，false 表示停止查找
+template <typename F>
+bool invoke_match_callback(F& f, const ac_match& m)
+{
+    if constexpr (std::is_same<decltype(f(m)), bool>::value) {
+        return f(m);
+    } else {
+        f(m);
+        return true;
+    }
+}
+
+// 自动机存成按字节类别压缩的双数组 (double-array):
+//   状态 s 经类别 c 的转移是 t = base[s] + c，当且仅当 check[t] == s 时存在。
+// 模式中没有出现的字节都归为类别 0，没有任何转移；base / check / fail / output 放在同一个 16 字节的格子里，
+// 查找时每个字节通常只访问当前状态和目标状态两个格子
+struct ac_table
+{
+    static constexpr std::uint32_t k_none = ~std::uint32_t(0);
+
+    struct cell
+    {
+        std::uint32_t base = 0;
+        std::uint32_t check = k_none;  // 父状态，空闲的格子为 k_none
+        std::uint32_t fail = 0;        // 失配链接
+        std::uint32_t output = 0;      // 失配链上 (含自身) 最近的终止状态，没有时为 0 (根)
+    };
+
+    std::array<std::uint8_t, 256> byte_class{};
+    std::uint32_t classes = 1;
+    vector<cell> cells;                // 下标即状态号，0 为根
+    vector<std::uint32_t> depth;       // 状态对应的前缀长度
+    vector<std::uint32_t> pattern;     // 终止状态的模式号 (相同的模式取最小的号)，其余为 k_none
+    vector<std::uint32_t> same_next;   // 按模式号: 下一个与它相同的模式，没有时为 k_none
+    std::size_t patterns = 0;
+    std::size_t states = 0;
+    std::size_t max_length = 0;
+
+    std::uint32_t next(std::uint32_t s, std::uint32_t c) const
+    {
+        if (c == 0) return 0;
+        for (;;) {
+            const std::uint32_t t = cells[s].base + c;
+            if (cells[t].check == s) return t;
+            if (s == 0) return 0;
+            s = cells[s].fail;
+        }
+    }
+
+    // 从状态 s、位置 pos 开始消耗 [first, last)，报告所有 (可重叠) 匹配；s、pos、first 随之前进，
+    // 可以分多次调用。f 返回 false 时在该匹配所在的字节之后停止，同一位置结束的其余匹配不再报告
+    template <typename Iter, typename F>
+    bool scan(std::uint32_t& s, std::size_t& pos, Iter& first, Iter last, F& f) const
+    {
+        while (first != last) {
+            s = next(s, byte_class[static_cast<unsigned char>(*first)]);
+            ++first;
+            ++pos;
+            for (std::uint32_t u = cells[s].output; u != 0; u = cells[cells[u].fail].output) {
+                for (std::uint32_t id = pattern[u]; id != k_none; id = same_next[id]) {
+                    if (!invoke_match_callback(f, ac_match{id, pos - depth[u], pos})) return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+inline shared_ptr<const ac_table> build_ac_table(const vector<std::pair<const unsigned char*, std::size_t>>& pats)
+{
+    constexpr std::uint32_t none = ac_table::k_none;
+    auto t = mystl::make_shared<ac_table>();
+    const std::uint32_t np = static_cast<std::uint32_t>(pats.size());
+    t->patterns = np;
+    t->same_next = vector<std::uint32_t>(np, none);
+
+    // 字节类别按字节值编号，保持字典序
+    bool seen[256] = {};
+    for (const auto& p : pats) {
+        for (std::size_t i = 0; i < p.second; ++i) seen[p.first[i]] = true;
+        if (p.second > t->max_length) t->max_length = p.second;
+    }
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        if (seen[b]) t->byte_class[b] = static_cast<std::uint8_t>(t->classes++);
+    }
+
+    // 模式按字典序插入: 与上一个模式的公共前缀已经在树上，之后的节点都是新建的，
+    // 而且总是父节点的最后一个孩子，不需要查找孩子
+    vector<std::uint32_t> order(np);
+    for (std::uint32_t i = 0; i < np; ++i) order[i] = i;
+    mystl::sort(order.begin(), order.end(), [&pats](std::uint32_t a, std::uint32_t b) {
+        const std::size_t la = pats[a].second, lb = pats[b].second;
+        const int r = std::memcmp(pats[a].first, pats[b].first, la < lb ? la : lb);
+        if (r != 0) return r < 0;
+        return la != lb ? la < lb : a < b;
+    });
+
+    struct trie_node
+    {
+        std::uint32_t first_child = none;
+        std::uint32_t last_child = none;
+        std::uint32_t next_sibling = none;
+        std::uint32_t label = 0;        // 入边的字节类别
+        std::uint32_t pattern = none;
+    };
+    vector<trie_node> trie;
+    trie.emplace_back();
+    vector<std::uint32_t> path(t->max_length + 1, 0);  // path[d]: 上一个模式深度为 d 的节点
+    std::pair<const unsigned char*, std::size_t> prev{nullptr, 0};
+    std::uint32_t prev_id = none;
+    for (std::uint32_t id : order) {
+        const auto& p = pats[id];
+        if (p.second == 0) continue;  // 空模式不参与匹配
+        std::size_t lcp = 0;
+        while (lcp < p.second && lcp < prev.second && p.first[lcp] == prev.first[lcp]) ++lcp;
+        if (lcp == p.second && lcp == prev.second) {  // 与上一个模式相同
+            t->same_next[prev_id] = id;
+            prev_id = id;
+            continue;
+        }
+        for (std::size_t d = lcp; d < p.second; ++d) {
+            const std::uint32_t node = static_cast<std::uint32_t>(trie.size());
+            trie.emplace_back();
+            trie[node].label = t->byte_class[p.first[d]];
+            trie_node& parent = trie[path[d]];
+            if (parent.last_child == none) parent.first_child = node;
+            else trie[parent.last_child].next_sibling = node;
+            parent.last_child = node;
+            path[d + 1] = node;
+        }
+        trie[path[p.second]].pattern = id;
+        prev = p;
+        prev_id = id;
+    }
+    t->states = trie.size();
+
+    // 按层次遍历放入双数组，同时计算失配链接 (失配目标的深度更小，已经放好)
+    vector<ac_table::cell>& cells = t->cells;
+    vector<std::uint32_t> skip;  // 空闲格子查找的路径压缩: 已占用的格子 i 指向下一个可能空闲的格子
+    auto grow = [&](std::size_t n) {
+        if (n <= cells.size()) return;
+        std::size_t cap = cells.size() * 2;
+        if (cap < n) cap = n;
+        const std::size_t old = cells.size();
+        cells.resize(cap);
+        t->depth.resize(cap);
+        t->pattern.resize(cap);
+        skip.resize(cap);
+        for (std::size_t i = old; i < cap; ++i) {
+            t->pattern[i] = none;
+            skip[i] = static_cast<std::uint32_t>(i + 1);
+        }
+    };
+    auto next_free = [&](std::uint32_t i) {
+        grow(std::size_t(i) + 1);
+        std::uint32_t r = i;
+        while (cells[r].check != none) {
+            r = skip[r];
+            grow(std::size_t(r) + 1);
+        }
+        while (i != r) {
+            const std::uint32_t n = skip[i];
+            skip[i] = r;
+            i = n;
+        }
+        return r;
+    };
+
+    grow(t->states + t->classes + 256);
+    cells[0].check = 0;  // 根占用 0 号格子；转移目标总是 base + c >= 1，不会与根混淆
+    vector<std::uint32_t> slot_of(trie.size(), 0);
+    vector<std::uint32_t> queue;
+    queue.push_back(0);
+    vector<std::uint32_t> labels;
+    std::uint32_t wide_from = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const std::uint32_t x = queue[head];
+        const std::uint32_t s = slot_of[x];
+        if (trie[x].first_child == none) continue;
+
+        labels.clear();
+        for (std::uint32_t y = trie[x].first_child; y != none; y = trie[y].next_sibling) labels.push_back(trie[y].label);
+
+        // 找第一个能放下所有孩子的 base：第一个孩子放在某个空闲格子上，再检查其余孩子。
+        // 只有一个孩子的节点 (大多数) 从头开始填空洞；多个孩子的节点从上一个多孩子节点的位置往后找，
+        // 否则每个节点都要重新试一遍前面那些放不下它的空洞
+        const bool wide = labels.size() > 1;
+        std::uint32_t pos = next_free(wide && wide_from > labels[0] ? wide_from : labels[0]);
+        std::uint32_t base;
+        for (;;) {
+            base = pos - labels[0];
+            grow(std::size_t(base) + t->classes);  // 任何类别的 base + c 都在数组内，查找时不用检查边界
+            bool fits = true;
+            for (std::size_t k = 1; k < labels.size() && fits; ++k) fits = cells[base + labels[k]].check == none;
+            if (fits) break;
+            pos = next_free(pos + 1);
+        }
+        if (wide) wide_from = pos;
+        cells[s].base = base;
+
+        for (std::uint32_t y = trie[x].first_child; y != none; y = trie[y].next_sibling) {
+            const std::uint32_t c = trie[y].label;
+            const std::uint32_t n = base + c;
+            cells[n].check = s;
+            skip[n] = n + 1;
+            slot_of[y] = n;
+            t->depth[n] = t->depth[s] + 1;
+            t->pattern[n] = trie[y].pattern;
+            cells[n].fail = s == 0 ? 0 : t->next(cells[s].fail, c);
+            cells[n].output = t->pattern[n] != none ? n : cells[cells[n].fail].output;
+            queue.push_back(y);
+        }
+    }
+    return t;
+}
+
+} // namespace detail
+
+// Aho-Corasick 自动机: 一趟扫描找出一组模式串的所有出现，时间与文本长度和匹配个数成正比，与模式个数无关。
+// 模式是字节串，构造时排序后插入字典树，再按层次放入双数组；和其他搜索器一样，表放在共享的只读块中，
+// 拷贝只加引用计数，const 的查找函数可以多个线程同时调用。空模式不会匹配
+class aho_corasick
+{
+    shared_ptr<const detail::ac_table> table_;
+    match_kind kind_;
+
+    friend class aho_corasick_stream;
+
+    template <typename Iter, typename F>
+    bool overlapping(Iter first, Iter last, F& f) const
+    {
+        std::uint32_t s = 0;
+        std::size_t i = 0;
+        return table_->scan(s, i, first, last, f);
+    }
+
+    // 当前状态表示文本 [i - depth(s), i)，它的起点单调不减；一旦越过已找到的最好匹配的起点，
+    // 后面不会再有更靠左的匹配，报告它并从它的末尾重新开始。最坏 O(n * 最长模式)
+    template <typename Iter, typename F>
+    bool leftmost_longest(Iter first, Iter last, F& f) const
+    {
+        const detail::ac_table& t = *table_;
+        std::size_t i = 0;
+        while (first != last) {
+            std::uint32_t s = 0;
+            bool found = false;
+            ac_match best{0, 0, 0};
+            Iter best_end = first;
+            while (first != last) {
+                s = t.next(s, t.byte_class[static_cast<unsigned char>(*first)]);
+                ++first;
+                ++i;
+                if (found && i - t.depth[s] > best.begin) break;
+                const std::uint32_t u = t.cells[s].output;  // 在这里结束的最长匹配
+                if (u == 0) continue;
+                const std::size_t b = i - t.depth[u];
+                if (!found || b < best.begin || (b == best.begin && i - b > best.end - best.begin)) {
+                    best = ac_match{t.pattern[u], b, i};
+                    best_end = first;
+                    found = true;
+                }
+            }
+            if (!found) break;
+            if (!detail::invoke_match_callback(f, best)) return false;
+            first = best_end;
+            i = best.end;
+        }
+        return true;
+    }
+
+public:
+    // patterns 是一组字节串 (std::string、string_view、mystl::string、const char* ...)，模式号为其中的下标
+    template <typename Range>
+    explicit aho_corasick(const Range& patterns, match_kind kind = match_kind::overlapping) : kind_(kind)
+    {
+        vector<std::pair<const unsigned char*, std::size_t>> pats;
+        for (const auto& p : patterns) pats.push_back(detail::pattern_bytes(p));
+        table_ = detail::build_ac_table(pats);
+    }
+
+    aho_corasick(std::initializer_list<std::string_view> patterns, match_kind kind = match_kind::overlapping)
+        : aho_corasick(vector<std::string_view>(patterns), kind) {}
+
+    match_kind kind() const noexcept { return kind_; }
+    std::size_t pattern_count() const noexcept { return table_->patterns; }
+    std::size_t max_pattern_size() const noexcept { return table_->max_length; }
+    std::size_t state_count() const noexcept { return table_->states; }
+
+    // 双数组及附属表占用的字节数
+    std::size_t memory_bytes() const noexcept
+    {
+        const detail::ac_table& t = *table_;
+        return t.cells.size() * (sizeof(detail::ac_table::cell) + 2 * sizeof(std::uint32_t)) + t.same_next.size() * sizeof(std::uint32_t);
+    }
+
+    // 按构造时的 match_kind 对 [first, last) 中的每个匹配调用 f(const ac_match&)；f 返回 false 时停止
+    template <typename Iter, typename F>
+    void for_each_match(Iter first, Iter last, F f) const
+    {
+        static_assert(is_forward_iterator<Iter>::value, "mystl::aho_corasick requires forward iterators");
+        if (kind_ == match_kind::overlapping) overlapping(first, last, f);
+        else leftmost_longest(first, last, f);
+    }
+
+    template <typename Iter>
+    vector<ac_match> find_all(Iter first, Iter last) const
+    {
+        vector<ac_match> out;
+        for_each_match(first, last, [&out](const ac_match& m) { out.push_back(m); });
+        return out;
+    }
+
+    // 搜索器接口: 第一个匹配 (起点最靠左的匹配中最长的)，没有时返回 (last, last)
+    template <typename Iter>
+    std::pair<Iter, Iter> operator()(Iter first, Iter last) const
+    {
+        static_assert(is_forward_iterator<Iter>::value, "mystl::aho_corasick requires forward iterators");
+        ac_match hit{0, 0, 0};
+        bool found = false;
+        auto stop = [&](const ac_match& m) { hit = m; found = true; return false; };
+        leftmost_longest(first, last, stop);
+        if (!found) return {last, last};
+        Iter b = mystl::next(first, static_cast<iter_difference_t<Iter>>(hit.begin));
+        return {b, mystl::next(b, static_cast<iter_difference_t<Iter>>(hit.end - hit.begin))};
+    }
+};
+
+// ========== 流式匹配 ==========
+// 输入分块到达 (网络包、文件块) 时，匹配器在两次 feed 之间保存自动机的状态，跨块的匹配照样能找到；
+// 不拷贝、不缓存输入，内存与流的长度无关。报告的偏移从流的开头算起 (ac_match 的 begin / end)。
+// feed 返回本次消耗的元素个数：回调返回 false 时停在该匹配的末尾，剩下的部分可以再次 feed
+
+// 单模式 KMP，与 kmp_searcher 共用失配表；报告所有 (可重叠) 的出现，pattern 恒为 0，空模式不匹配
+template <typename T, typename Pred = std::equal_to<T>>
+class kmp_stream
+{
+    shared_ptr<const detail::kmp_table<T>> table_;
+    Pred pred_;
+    std::size_t matched_ = 0;  // 已经匹配的模式前缀长度
+    std::size_t offset_ = 0;   // 已经消耗的元素个数
+
+public:
+    explicit kmp_stream(const kmp_searcher<T, Pred>& s) : table_(s.table_), pred_(s.pred_) {}
+
+    template <typename PatIter>
+    kmp_stream(PatIter first, PatIter last, Pred pred = Pred()) : kmp_stream(kmp_searcher<T, Pred>(first, last, pred)) {}
+
+    std::size_t offset() const noexcept { return offset_; }
+    std::size_t pattern_size() const noexcept { return table_->pattern.size(); }
+
+    void reset() noexcept
+    {
+        matched_ = 0;
+        offset_ = 0;
+    }
+
+    template <typename Iter, typename F>
+    std::size_t feed(Iter first, Iter last, F f)
+    {
+        static_assert(is_forward_iterator<Iter>::value, "mystl::kmp_stream requires forward iterators");
+        const vector<T>& p = table_->pattern;
+        const vector<std::size_t>& lps = table_->lps;
+        const std::size_t m = p.size();
+        const std::size_t start = offset_;
+        if (m == 0) {
+            for (; first != last; ++first) ++offset_;
+            return offset_ - start;
+        }
+
+        std::size_t j = matched_;
+        std::size_t pos = offset_;
+        while (first != last) {
+            if (pred_(*first, p[j])) {
+                ++first;
+                ++pos;
+                if (++j == m) {
+                    j = lps[m - 1];
+                    if (!detail::invoke_match_callback(f, ac_match{0, pos - m, pos})) break;
+                }
+            } else if (j > 0) {
+                j = lps[j - 1];
+            } else {
+                ++first;
+                ++pos;
+            }
+        }
+        matched_ = j;
+        offset_ = pos;
+        return pos - start;
+    }
+};
+
+template <typename PatIter>
+kmp_stream(PatIter, PatIter) -> kmp_stream<iter_value_t<PatIter>>;
+
+// 多模式，与 aho_corasick 共用自动机；报告所有 (可重叠) 的出现。
+// leftmost_longest 找到匹配后要回到匹配末尾重新扫描，可能回到已经丢弃的块中，所以只接受 overlapping 的自动机
+class aho_corasick_stream
+{
+    shared_ptr<const detail::ac_table> table_;
+    std::uint32_t state_ = 0;
+    std::size_t offset_ = 0;
+
+public:
+    explicit aho_corasick_stream(const aho_corasick& ac) : table_(ac.table_)
+    {
+        if (ac.kind() != match_kind::overlapping)
+            throw std::invalid_argument("mystl::aho_corasick_stream requires match_kind::overlapping");
+    }
+
+    std::size_t offset() const noexcept { return offset_; }
+
+    void reset() noexcept
+    {
+        state_ = 0;
+        offset_ = 0;
+    }
+
+    template <typename Iter, typename F>
+    std::size_t feed(Iter first, Iter last, F f)
+    {
+        static_assert(is_forward_iterator<Iter>::value, "mystl::aho_corasick_stream requires forward iterators");
+        const std::size_t start = offset_;
+        table_->scan(state_, offset_, first, last, f);
+        return offset_ - start;
+    }
+};
+
+// ========== 并行查找 ==========
+// 一段很长的文本 (比如 mmap 的大文件) 切成若干块交给线程池，各块独立查找。
+// 匹配归它的结束位置所在的块：块 [b, e) 从 b - (m - 1) 开始查找 (m 为最长模式的长度)，
+// 只报告结束位置在 (b, e] 中的匹配，跨块的匹配恰好被报告一次；按块序拼接后，结果和顺序都与单线程查找相同
+namespace detail
+{
+// 每块至少这么多个元素，并且至少是重叠部分的 k_search_overlap_ratio 倍，重复扫描的比例不超过 1 / 16
+constexpr std::ptrdiff_t k_parallel_search_grain = 1 << 20;
+constexpr std::ptrdiff_t k_search_overlap_ratio = 16;
+
+template <typename Searcher>
+std::size_t longest_match(const Searcher& s)
+{
+    if constexpr (std::is_same<Searcher, aho_corasick>::value) return s.max_pattern_size();
+    else return s.pattern_size();
+}
+
+// leftmost_longest 的下一次查找从上一个匹配的末尾开始，依赖前面所有的匹配，不能分块
+template <typename Searcher>
+std::ptrdiff_t parallel_search_chunk(const thread_pool& pool, std::ptrdiff_t n, const Searcher& s, const char* what)
+{
+    if constexpr (std::is_same<Searcher, aho_corasick>::value) {
+        if (s.kind() != match_kind::overlapping)
+            throw std::invalid_argument(what);
+    }
+    const std::ptrdiff_t parts = static_cast<std::ptrdiff_t>(pool.size()) * k_chunks_per_thread;
+    const std::ptrdiff_t overlap = static_cast<std::ptrdiff_t>(detail::longest_match(s));
+    std::ptrdiff_t chunk = (n + parts - 1) / parts;
+    if (chunk < k_parallel_search_grain) chunk = k_parallel_search_grain;
+    if (chunk < overlap * k_search_overlap_ratio) chunk = overlap * k_search_overlap_ratio;
+    return chunk;
+}
+
+// 查找块 [b, e)，对结束位置大于 b 的匹配调用 f，偏移相对于 first
+template <typename Iter, typename Searcher, typename F>
+void search_chunk(Iter first, std::ptrdiff_t b, std::ptrdiff_t e, const Searcher& s, F& f)
+{
+    const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(detail::longest_match(s));
+    if (m == 0) return;
+    const std::ptrdiff_t from = b > m - 1 ? b - (m - 1) : 0;
+    if constexpr (std::is_same<Searcher, aho_corasick>::value) {
+        const std::size_t base = static_cast<std::size_t>(from);
+        const std::size_t owned = static_cast<std::size_t>(b);
+        s.for_each_match(first + from, first + e, [&](const ac_match& r) {
+            if (base + r.end > owned) f(ac_match{r.pattern, base + r.begin, base + r.end});
+        });
+    } else {
+        // 单模式的匹配长度都是 m，窗口内的匹配结束位置都大于 b，不用过滤
+        const Iter last = first + e;
+        for (Iter it = first + from;;) {
+            const std::pair<Iter, Iter> r = s(it, last);
+            if (r.first == last) break;
+            f(ac_match{0, static_cast<std::size_t>(r.first - first), static_cast<std::size_t>(r.second - first)});
+            it = r.first + 1;
+        }
+    }
+}
+} // namespace detail
+
+// 在 [first, last) 中并行查找 s 的所有匹配：单模式搜索器 (kmp_searcher、searcher 等) 的所有可重叠出现，
+// 或 overlapping 的 aho_corasick 的全部匹配；单模式的 pattern 为 0。线程数由 pool 决定，与 parallel_sort 相同。
+// 结果与顺序同单线程逐个查找 (aho_corasick 即 for_each_match) 一致。s 的 const 查找会被多个线程同时调用；
+// 空模式没有匹配，leftmost_longest 的 aho_corasick 抛出 std::invalid_argument
+template <typename Iter, typename Searcher>
+vector<ac_match> parallel_find_all(thread_pool& pool, Iter first, Iter last, const Searcher& s)
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::parallel_find_all requires random access iterators");
+    const std::ptrdiff_t n = last - first;
+    const std::ptrdiff_t chunk =
+        detail::parallel_search_chunk(pool, n, s, "mystl::parallel_find_all requires match_kind::overlapping");
+    const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+
+    vector<vector<ac_match>> parts(static_cast<std::size_t>(chunks));
+    auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t c) {
+        vector<ac_match>& part = parts[c];
+        auto push = [&part](const ac_match& m) { part.push_back(m); };
+        detail::search_chunk(first, b, e, s, push);
+    };
+    detail::parallel_chunks(pool, n, chunk, body);
+
+    // 按块序拼接，各块并行拷贝到自己的位置
+    vector<std::size_t> offset(static_cast<std::size_t>(chunks) + 1, 0);
+    for (std::ptrdiff_t c = 0; c < chunks; ++c) offset[c + 1] = offset[c] + parts[c].size();
+    vector<ac_match> out;
+    out.resize_for_overwrite(offset[chunks]);
+    auto copy = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t) {
+        for (; b < e; ++b) {
+            if (!parts[b].empty()) std::memcpy(out.data() + offset[b], parts[b].data(), parts[b].size() * sizeof(ac_match));
+        }
+    };
+    detail::parallel_chunks(pool, chunks, 1, copy);
+    return out;
+}
+
+// 不要求顺序时不必保存匹配：f(const ac_match&) 在各个线程上直接调用，顺序不确定，f 需要自己同步
+template <typename Iter, typename Searcher, typename F>
+void parallel_for_each_match(thread_pool& pool, Iter first, Iter last, const Searcher& s, F f)
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::parallel_for_each_match requires random access iterators");
+    const std::ptrdiff_t n = last - first;
+    const std::ptrdiff_t chunk =
+        detail::parallel_search_chunk(pool, n, s, "mystl::parallel_for_each_match requires match_kind::overlapping");
+    auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t) { detail::search_chunk(first, b, e, s, f); };
+    detail::parallel_chunks(pool, n, chunk, body);
+}
+
+// 只统计匹配个数，每块的计数器独占一条缓存行
+template <typename Iter, typename Searcher>
+std::size_t parallel_count(thread_pool& pool, Iter first, Iter last, const Searcher& s)
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::parallel_count requires random access iterators");
+    const std::ptrdiff_t n = last - first;
+    const std::ptrdiff_t chunk =
+        detail::parallel_search_chunk(pool, n, s, "mystl::parallel_count requires match_kind::overlapping");
+    const std::ptrdiff_t chunks = (n + chunk - 1) / chunk;
+    std::vector<detail::padded_value<std::size_t>> counts(static_cast<std::size_t>(chunks), detail::padded_value<std::size_t>{0});
+    auto body = [&](std::ptrdiff_t b, std::ptrdiff_t e, std::ptrdiff_t c) {
+        std::size_t k = 0;
+        auto count = [&k](const ac_match&) { ++k; };
+        detail::search_chunk(first, b, e, s, count);
+        counts[c].value = k;
+    };
+    detail::parallel_chunks(pool, n, chunk, body);
+    std::size_t total = 0;
+    for (const auto& c : counts) total += c.value;
+    return total;
+}
+
+} // namespace mystl
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "../utility.h"
+#include "../vector.h"
+#include "heap.h"
+#include "sort.h"
+
+namespace mystl
+{
+
+// ---- 选择算法 ----
+namespace detail
+{
+// 长度不超过该值的区间直接排序
+constexpr std::ptrdiff_t k_select_sort_threshold = 16;
+// partial_sort 中 k 超过 n / 该值时改用 nth_element + sort，堆太大时随机访问的缓存代价比多做的比较更贵
+constexpr std::ptrdiff_t k_partial_sort_heap_ratio = 8;
+
+// 中位数的中位数 (BFPRT)：每 5 个一组排序，把各组中位数移到区间前部，再递归选出它们的中位数。
+// 保证至少 3/10 的元素落在枢轴两侧，整体 O(n)。常数较大，只在 introselect 划分多次失衡后使用
+template <typename Iter, typename Compare>
+void median_of_medians_select(Iter first, Iter nth, Iter last, Compare& comp)
+{
+    while (last - first > k_select_sort_threshold) {
+        const std::ptrdiff_t len = last - first;
+        const std::ptrdiff_t groups = len / 5;
+        for (std::ptrdiff_t g = 0; g < groups; ++g) {
+            Iter group = first + g * 5;
+            detail::insertion_sort(group, group + 5, comp);
+            detail::iter_swap(first + g, group + 2);
+        }
+        // 中位数都在 [first, first + groups)，选出其中位数放到 *first 作为枢轴
+        detail::median_of_medians_select(first, first + groups / 2, first + groups, comp);
+        detail::iter_swap(first, first + groups / 2);
+
+        // 其余各组的上半部分保证 [first + 1, last) 中既有 >= 枢轴也有 <= 枢轴的元素，可以无边界检查划分
+        Iter cut = detail::unguarded_partition(first + 1, last, first, comp);
+        if (nth < cut) last = cut;
+        else first = cut;
+    }
+    mystl::small_sort(first, last, comp);
+}
+
+// 内省选择：和 introsort 一样选枢轴、划分，但只进入包含 nth 的一侧，期望 O(n)。
+// 划分次数超过 depth_limit 说明枢轴一直选得不好，剩余部分改用中位数的中位数，最坏 O(n)
+template <typename Iter, typename Compare>
+void introselect(Iter first, Iter nth, Iter last, int depth_limit, Compare& comp)
+{
+    while (last - first > k_select_sort_threshold) {
+        if (depth_limit == 0) {
+            detail::median_of_medians_select(first, nth, last, comp);
+            return;
+        }
+        --depth_limit;
+        detail::move_pivot_to_first(first, last, comp);
+        Iter cut = detail::unguarded_partition(first + 1, last, first, comp);
+        if (nth < cut) last = cut;
+        else first = cut;
+    }
+    mystl::small_sort(first, last, comp);
+}
+
+// 用 [first, middle) 上的堆筛出最靠前的 middle - first 个元素，再对堆排序
+template <typename Iter, typename Compare>
+void heap_select_sort(Iter first, Iter middle, Iter last, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    const std::ptrdiff_t len = middle - first;
+    mystl::make_heap(first, middle, comp);
+    for (Iter i = middle; i != last; ++i) {
+        // 堆顶是当前保留元素中最靠后的，新元素比它靠前才替换
+        if (comp(*i, *first)) {
+            value_type value = mystl::move(*i);
+            *i = mystl::move(*first);
+            detail::adjust_heap(first, std::ptrdiff_t(0), len, mystl::move(value), comp);
+        }
+    }
+    mystl::sort_heap(first, middle, comp);
+}
+
+} // namespace detail
+
+// 重排 [first, last)，使 *nth 为完全排序后该位置上的元素，
+// 且 [first, nth) 中的元素都不排在 *nth 之后，(nth, last) 中的元素都不排在 *nth 之前。
+// 内省选择，期望 O(n)，最坏 O(n)（中位数的中位数兜底）
+template <typename Iter, typename Compare = std::less<>>
+void nth_element(Iter first, Iter nth, Iter last, Compare comp = {})
+{
+    if (nth == last || last - first < 2) return;
+    detail::introselect(first, nth, last, 2 * detail::log2_floor(last - first), comp);
+}
+
+// 使 [first, middle) 为整个区间中最靠前的 middle - first 个元素并排好序，[middle, last) 顺序未指定。
+// k 较小时用大小为 k 的堆，O(n log k)；k 较大时先 nth_element 再排序前 k 个
+template <typename Iter, typename Compare = std::less<>>
+void partial_sort(Iter first, Iter middle, Iter last, Compare comp = {})
+{
+    const std::ptrdiff_t k = middle - first;
+    if (k == 0) return;
+    if (k > (last - first) / detail::k_partial_sort_heap_ratio && middle != last) {
+        mystl::nth_element(first, middle, last, comp);
+        mystl::sort(first, middle, comp);
+    } else {
+        detail::heap_select_sort(first, middle, last, comp);
+    }
+}
+
+// 把 [first, last) 中最靠前的 min(n, r_last - r_first) 个元素按序拷贝到 [r_first, r_last)，
+// 返回拷贝结束的位置。输入只需要单遍读取，可以是输入迭代器
+template <typename InputIter, typename Iter, typename Compare = std::less<>>
+Iter partial_sort_copy(InputIter first, InputIter last, Iter r_first, Iter r_last, Compare comp = {})
+{
+    using value_type = std::decay_t<decltype(*r_first)>;
+    if (r_first == r_last) return r_first;
+
+    Iter r_end = r_first;
+    for (; first != last && r_end != r_last; ++first, ++r_end)
+        *r_end = *first;
+    const std::ptrdiff_t len = r_end - r_first;
+    mystl::make_heap(r_first, r_end, comp);
+    for (; first != last; ++first) {
+        if (comp(*first, *r_first))
+            detail::adjust_heap(r_first, std::ptrdiff_t(0), len, value_type(*first), comp);
+    }
+    mystl::sort_heap(r_first, r_end, comp);
+    return r_end;
+}
+
+// 流式 top-k：逐个接收元素，只保留按 comp 排序后最靠前的 k 个，内存 O(k)，每个元素 O(log k)。
+// 与 partial_sort 的语义一致：默认 std::less 保留最小的 k 个，要最大的 k 个用 std::greater<>
+template <typename Tp, typename Compare = std::less<>>
+class top_k
+{
+public:
+    using value_type = Tp;
+    using size_type = std::size_t;
+
+    explicit top_k(size_type k, Compare comp = {}) : k_(k), comp_(comp) { heap_.reserve(k); }
+
+    void push(const value_type& value) { push_impl(value); }
+    void push(value_type&& value) { push_impl(mystl::move(value)); }
+
+    template <typename InputIter>
+    void push(InputIter first, InputIter last)
+    {
+        for (; first != last; ++first) push_impl(*first);
+    }
+
+    size_type k() const { return k_; }
+    size_type size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+    bool full() const { return heap_.size() == k_; }
+
+    // 当前保留的元素中最靠后的一个：已满时新元素必须排在它之前才会被保留
+    const value_type& threshold() const { return heap_[0]; }
+
+    // 按 comp 升序返回保留的元素
+    mystl::vector<value_type> sorted() const &
+    {
+        mystl::vector<value_type> result(heap_);
+        mystl::sort_heap(result.begin(), result.end(), comp_);
+        return result;
+    }
+
+    mystl::vector<value_type> sorted() &&
+    {
+        mystl::sort_heap(heap_.begin(), heap_.end(), comp_);
+        return mystl::move(heap_);
+    }
+
+    void clear() { heap_.clear(); }
+
+private:
+    template <typename U>
+    void push_impl(U&& value)
+    {
+        if (heap_.size() < k_) {
+            heap_.push_back(std::forward<U>(value));
+            mystl::push_heap(heap_.begin(), heap_.end(), comp_);
+        } else if (k_ > 0 && comp_(value, heap_[0])) {
+            detail::adjust_heap(heap_.begin(), std::ptrdiff_t(0), std::ptrdiff_t(heap_.size()),
+                                value_type(std::forward<U>(value)), comp_);
+        }
+    }
+
+    size_type k_;
+    Compare comp_;
+    mystl::vector<value_type> heap_; // 以 comp 为序的大顶堆，堆顶是保留元素中最靠后的
+};
+
+} // namespace mystl
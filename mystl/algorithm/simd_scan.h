@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#include "simd_sort.h"
+
+// 与 simd_sort.h 相同的平台条件，复用其中的 cpu_has_avx2 做运行时分派
+#define MYSTL_HAS_SIMD_SCAN MYSTL_HAS_SIMD_SORT
+
+namespace mystl
+{
+namespace detail
+{
+
+#if MYSTL_HAS_SIMD_SCAN
+
+template <typename Tp>
+Tp wrapping_add(Tp a, Tp b)
+{
+    using unsigned_type = std::make_unsigned_t<Tp>;
+    return static_cast<Tp>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(b));
+}
+
+// ========== SSE2 ==========
+// prefix(v): 寄存器内前缀和，v + (v << 1 个元素) + (v << 2 个元素) ...
+// shift_in_zero(p): 前缀和整体右移一个元素、最低位补 0，得到寄存器内的 exclusive 前缀和
+// broadcast_last(p): 最后一个元素广播到所有元素，作为下一个寄存器的进位
+namespace simd_sse2
+{
+
+struct scan_int32_ops
+{
+    using value_type = std::int32_t;
+    using reg = __m128i;
+    static constexpr std::size_t width = 4;
+
+    static reg load(const value_type* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(value_type* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static reg set1(value_type x) { return _mm_set1_epi32(x); }
+    static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return wrapping_add(a, b); }
+    static reg prefix(reg v)
+    {
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        return _mm_add_epi32(v, _mm_slli_si128(v, 8));
+    }
+    static reg shift_in_zero(reg p) { return _mm_slli_si128(p, 4); }
+    static reg broadcast_last(reg p) { return _mm_shuffle_epi32(p, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+struct scan_int64_ops
+{
+    using value_type = std::int64_t;
+    using reg = __m128i;
+    static constexpr std::size_t width = 2;
+
+    static reg load(const value_type* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(value_type* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static reg set1(value_type x) { return _mm_set1_epi64x(x); }
+    static reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return wrapping_add(a, b); }
+    static reg prefix(reg v) { return _mm_add_epi64(v, _mm_slli_si128(v, 8)); }
+    static reg shift_in_zero(reg p) { return _mm_slli_si128(p, 8); }
+    static reg broadcast_last(reg p) { return _mm_unpackhi_epi64(p, p); }
+};
+
+struct scan_float_ops
+{
+    using value_type = float;
+    using reg = __m128;
+    static constexpr std::size_t width = 4;
+
+    static reg shift(reg v, int bytes)
+    {
+        return bytes == 4 ? _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4))
+                          : _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8));
+    }
+    static reg load(const value_type* p) { return _mm_loadu_ps(p); }
+    static void store(value_type* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg set1(value_type x) { return _mm_set1_ps(x); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return a + b; }
+    static reg prefix(reg v)
+    {
+        v = _mm_add_ps(v, shift(v, 4));
+        return _mm_add_ps(v, shift(v, 8));
+    }
+    static reg shift_in_zero(reg p) { return shift(p, 4); }
+    static reg broadcast_last(reg p) { return _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+struct scan_double_ops
+{
+    using value_type = double;
+    using reg = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static reg load(const value_type* p) { return _mm_loadu_pd(p); }
+    static void store(value_type* p, reg v) { _mm_storeu_pd(p, v); }
+    static reg set1(value_type x) { return _mm_set1_pd(x); }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return a + b; }
+    static reg prefix(reg v) { return _mm_add_pd(v, shift_in_zero(v)); }
+    static reg shift_in_zero(reg p) { return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(p), 8)); }
+    static reg broadcast_last(reg p) { return _mm_unpackhi_pd(p, p); }
+};
+
+#define MYSTL_SIMD_TARGET
+#define MYSTL_SIMD_NS simd_sse2
+#include "simd_scan_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_sse2
+
+// ========== AVX2 ==========
+// 256 位的字节移位只在各自的 128 位半边内进行：先在两个半边内分别求前缀和，
+// 再把低半边的最后一个元素加到高半边上
+namespace simd_avx2
+{
+#define MYSTL_SIMD_TARGET __attribute__((target("avx2")))
+
+struct scan_int32_ops
+{
+    using value_type = std::int32_t;
+    using reg = __m256i;
+    static constexpr std::size_t width = 8;
+
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    MYSTL_SIMD_TARGET static reg set1(value_type x) { return _mm256_set1_epi32(x); }
+    MYSTL_SIMD_TARGET static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return wrapping_add(a, b); }
+    MYSTL_SIMD_TARGET static reg prefix(reg v)
+    {
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+        v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+        reg low_last = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_epi32(v, _mm256_permute2x128_si256(low_last, low_last, 0x08));
+    }
+    MYSTL_SIMD_TARGET static reg shift_in_zero(reg p)
+    {
+        reg rotated = _mm256_permutevar8x32_epi32(p, _mm256_set_epi32(6, 5, 4, 3, 2, 1, 0, 7));
+        return _mm256_blend_epi32(rotated, _mm256_setzero_si256(), 0x01);
+    }
+    MYSTL_SIMD_TARGET static reg broadcast_last(reg p) { return _mm256_permutevar8x32_epi32(p, _mm256_set1_epi32(7)); }
+};
+
+struct scan_int64_ops
+{
+    using value_type = std::int64_t;
+    using reg = __m256i;
+    static constexpr std::size_t width = 4;
+
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    MYSTL_SIMD_TARGET static reg set1(value_type x) { return _mm256_set1_epi64x(x); }
+    MYSTL_SIMD_TARGET static reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return wrapping_add(a, b); }
+    MYSTL_SIMD_TARGET static reg prefix(reg v)
+    {
+        v = _mm256_add_epi64(v, _mm256_slli_si256(v, 8));
+        reg low_last = _mm256_shuffle_epi32(v, _MM_SHUFFLE(3, 2, 3, 2));
+        return _mm256_add_epi64(v, _mm256_permute2x128_si256(low_last, low_last, 0x08));
+    }
+    MYSTL_SIMD_TARGET static reg shift_in_zero(reg p)
+    {
+        reg rotated = _mm256_permute4x64_epi64(p, _MM_SHUFFLE(2, 1, 0, 3));
+        return _mm256_blend_epi32(rotated, _mm256_setzero_si256(), 0x03);
+    }
+    MYSTL_SIMD_TARGET static reg broadcast_last(reg p) { return _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+struct scan_float_ops
+{
+    using value_type = float;
+    using reg = __m256;
+    static constexpr std::size_t width = 8;
+
+    MYSTL_SIMD_TARGET static reg shift(reg v, int bytes)
+    {
+        __m256i x = _mm256_castps_si256(v);
+        return _mm256_castsi256_ps(bytes == 4 ? _mm256_slli_si256(x, 4) : _mm256_slli_si256(x, 8));
+    }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_loadu_ps(p); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_storeu_ps(p, v); }
+    MYSTL_SIMD_TARGET static reg set1(value_type x) { return _mm256_set1_ps(x); }
+    MYSTL_SIMD_TARGET static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return a + b; }
+    MYSTL_SIMD_TARGET static reg prefix(reg v)
+    {
+        v = _mm256_add_ps(v, shift(v, 4));
+        v = _mm256_add_ps(v, shift(v, 8));
+        reg low_last = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm256_add_ps(v, _mm256_permute2f128_ps(low_last, low_last, 0x08));
+    }
+    MYSTL_SIMD_TARGET static reg shift_in_zero(reg p)
+    {
+        reg rotated = _mm256_permutevar8x32_ps(p, _mm256_set_epi32(6, 5, 4, 3, 2, 1, 0, 7));
+        return _mm256_blend_ps(rotated, _mm256_setzero_ps(), 0x01);
+    }
+    MYSTL_SIMD_TARGET static reg broadcast_last(reg p) { return _mm256_permutevar8x32_ps(p, _mm256_set1_epi32(7)); }
+};
+
+struct scan_double_ops
+{
+    using value_type = double;
+    using reg = __m256d;
+    static constexpr std::size_t width = 4;
+
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_loadu_pd(p); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_storeu_pd(p, v); }
+    MYSTL_SIMD_TARGET static reg set1(value_type x) { return _mm256_set1_pd(x); }
+    MYSTL_SIMD_TARGET static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static value_type add_scalar(value_type a, value_type b) { return a + b; }
+    MYSTL_SIMD_TARGET static reg prefix(reg v)
+    {
+        v = _mm256_add_pd(v, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(v), 8)));
+        reg low_last = _mm256_permute_pd(v, 0xF);
+        return _mm256_add_pd(v, _mm256_permute2f128_pd(low_last, low_last, 0x08));
+    }
+    MYSTL_SIMD_TARGET static reg shift_in_zero(reg p)
+    {
+        reg rotated = _mm256_permute4x64_pd(p, _MM_SHUFFLE(2, 1, 0, 3));
+        return _mm256_blend_pd(rotated, _mm256_setzero_pd(), 0x01);
+    }
+    MYSTL_SIMD_TARGET static reg broadcast_last(reg p) { return _mm256_permute4x64_pd(p, _MM_SHUFFLE(3, 3, 3, 3)); }
+};
+
+#define MYSTL_SIMD_NS simd_avx2
+#include "simd_scan_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_avx2
+
+template <typename Tp, typename = void>
+struct simd_scan_ops { static constexpr bool supported = false; };
+
+template <typename Tp>
+struct simd_scan_ops<Tp, std::enable_if_t<std::is_same<Tp, std::int32_t>::value || std::is_same<Tp, std::uint32_t>::value>>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::scan_int32_ops;
+    using avx2 = simd_avx2::scan_int32_ops;
+};
+
+template <typename Tp>
+struct simd_scan_ops<Tp, std::enable_if_t<std::is_same<Tp, std::int64_t>::value || std::is_same<Tp, std::uint64_t>::value>>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::scan_int64_ops;
+    using avx2 = simd_avx2::scan_int64_ops;
+};
+
+template <>
+struct simd_scan_ops<float>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::scan_float_ops;
+    using avx2 = simd_avx2::scan_float_ops;
+};
+
+template <>
+struct simd_scan_ops<double>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::scan_double_ops;
+    using avx2 = simd_avx2::scan_double_ops;
+};
+
+#else
+
+template <typename Tp>
+struct simd_scan_ops { static constexpr bool supported = false; };
+
+#endif // MYSTL_HAS_SIMD_SCAN
+
+// 输入输出都是同一元素类型的指针、元素为 32 / 64 位定长整数或浮点、op 为加法时可以用 SIMD 前缀和
+template <typename InIter, typename OutIter, typename Tp, typename BinaryOp>
+struct is_simd_scannable : std::false_type {};
+
+template <typename In, typename Tp, typename BinaryOp>
+struct is_simd_scannable<In*, Tp*, Tp, BinaryOp>
+    : std::integral_constant<bool, std::is_same<std::remove_const_t<In>, Tp>::value && simd_scan_ops<Tp>::supported
+                                   && (std::is_same<BinaryOp, std::plus<>>::value || std::is_same<BinaryOp, std::plus<Tp>>::value)>
+{};
+
+// [in, in + n) 的前缀和写到 out，carry 为初值，返回整段之和加 carry。只应在 is_simd_scannable 为 true 时调用
+template <bool Inclusive, typename Tp>
+Tp simd_scan(const Tp* in, Tp* out, std::size_t n, Tp carry)
+{
+#if MYSTL_HAS_SIMD_SCAN
+    using ops = simd_scan_ops<Tp>;
+    if (cpu_has_avx2()) return simd_avx2::scan_kernel<typename ops::avx2, Inclusive>(in, out, n, carry);
+    return simd_sse2::scan_kernel<typename ops::sse2, Inclusive>(in, out, n, carry);
+#else
+    (void)in;
+    (void)out;
+    (void)n;
+    return carry;
+#endif
+}
+
+} // namespace detail
+} // namespace mystl
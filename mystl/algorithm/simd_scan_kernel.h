@@ -0,0 +1,47 @@
+// 寄存器内前缀和内核
+// 与 simd_sort_kernel.h 相同，不带 #pragma once：simd_scan.h 以不同的 MYSTL_SIMD_TARGET / MYSTL_SIMD_NS
+// 分别在 SSE2 和 AVX2 命名空间中包含一次。V 为对应指令集的前缀和操作集合（见 simd_scan.h）
+
+// 对 in[0, n) 做前缀和写到 out，carry 为之前所有元素的和，返回加上本段之后的和。
+// 每次读入一个寄存器：先用移位相加算出寄存器内的前缀和，再加上广播的 carry；
+// carry 只依赖每个寄存器的最后一个元素，循环间依赖只有一次向量加法
+template <typename V, bool Inclusive, typename Tp>
+MYSTL_SIMD_TARGET Tp scan_kernel(const Tp* in, Tp* out, std::size_t n, Tp carry)
+{
+    using value_type = typename V::value_type;
+    using reg = typename V::reg;
+    constexpr std::size_t W = V::width;
+    static_assert(sizeof(value_type) == sizeof(Tp), "element size mismatch");
+
+    // 无符号整数与有符号整数的加法在二进制补码下完全相同，共用一套操作
+    const value_type* src = reinterpret_cast<const value_type*>(in);
+    value_type* dst = reinterpret_cast<value_type*>(out);
+    value_type sum;
+    std::memcpy(&sum, &carry, sizeof(Tp));
+
+    reg c = V::set1(sum);
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        reg p = V::prefix(V::load(src + i));
+        V::store(dst + i, V::add(Inclusive ? p : V::shift_in_zero(p), c));
+        c = V::add(c, V::broadcast_last(p));
+    }
+
+    value_type lanes[W];
+    V::store(lanes, c);
+    sum = lanes[0];
+    for (; i < n; ++i) {
+        value_type x = src[i];
+        if (Inclusive) {
+            sum = V::add_scalar(sum, x);
+            dst[i] = sum;
+        } else {
+            dst[i] = sum;
+            sum = V::add_scalar(sum, x);
+        }
+    }
+
+    Tp result;
+    std::memcpy(&result, &sum, sizeof(Tp));
+    return result;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "simd_sort.h"
+
+// 与 simd_sort.h 相同的平台条件，复用其中的 cpu_has_avx2 做运行时分派
+#define MYSTL_HAS_SIMD_SEARCH MYSTL_HAS_SIMD_SORT
+
+namespace mystl
+{
+namespace detail
+{
+
+constexpr std::size_t k_simd_npos = static_cast<std::size_t>(-1);
+
+// find_first_of 的集合不超过这么多字节时逐个广播比较，更大的集合用 256 位的位图逐字节查表
+constexpr std::size_t k_simd_set_max = 16;
+
+#if MYSTL_HAS_SIMD_SEARCH
+
+// ========== SSE2：一次 16 个字节 ==========
+namespace simd_sse2
+{
+struct search_ops
+{
+    using reg = __m128i;
+    static constexpr std::size_t width = 16;
+
+    static reg load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static reg set1(char c) { return _mm_set1_epi8(c); }
+    static reg cmpeq(reg a, reg b) { return _mm_cmpeq_epi8(a, b); }
+    static reg and_(reg a, reg b) { return _mm_and_si128(a, b); }
+    static reg or_(reg a, reg b) { return _mm_or_si128(a, b); }
+    static std::uint32_t movemask(reg v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+};
+
+#define MYSTL_SIMD_TARGET
+#define MYSTL_SIMD_NS simd_sse2
+#include "simd_search_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_sse2
+
+// ========== AVX2：一次 32 个字节 ==========
+namespace simd_avx2
+{
+#define MYSTL_SIMD_TARGET __attribute__((target("avx2")))
+
+struct search_ops
+{
+    using reg = __m256i;
+    static constexpr std::size_t width = 32;
+
+    MYSTL_SIMD_TARGET static reg load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static reg set1(char c) { return _mm256_set1_epi8(c); }
+    MYSTL_SIMD_TARGET static reg cmpeq(reg a, reg b) { return _mm256_cmpeq_epi8(a, b); }
+    MYSTL_SIMD_TARGET static reg and_(reg a, reg b) { return _mm256_and_si256(a, b); }
+    MYSTL_SIMD_TARGET static reg or_(reg a, reg b) { return _mm256_or_si256(a, b); }
+    MYSTL_SIMD_TARGET static std::uint32_t movemask(reg v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+};
+
+#define MYSTL_SIMD_NS simd_avx2
+#include "simd_search_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_avx2
+
+#endif // MYSTL_HAS_SIMD_SEARCH
+
+// ========== 标量版本 ==========
+// 没有 SIMD 或者文本太短 (不足一个寄存器) 时使用：memchr 找首字节，再 memcmp 比较其余字节
+inline std::size_t scalar_find(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+    const char* const stop = h + (n - m) + 1;  // 最后一个起点之后
+    for (const char* s = h; s < stop;) {
+        const void* hit = std::memchr(s, static_cast<unsigned char>(p[0]), static_cast<std::size_t>(stop - s));
+        if (!hit) break;
+        s = static_cast<const char*>(hit);
+        if (std::memcmp(s + 1, p + 1, m - 1) == 0) return static_cast<std::size_t>(s - h);
+        ++s;
+    }
+    return k_simd_npos;
+}
+
+inline std::size_t scalar_rfind(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+    for (std::size_t i = n - m + 1; i-- > 0;) {
+        if (h[i] == p[0] && std::memcmp(h + i + 1, p + 1, m - 1) == 0) return i;
+    }
+    return k_simd_npos;
+}
+
+inline std::size_t scalar_find_first_of(const char* h, std::size_t n, const char* set, std::size_t k)
+{
+    std::uint64_t bits[4] = {};
+    for (std::size_t j = 0; j < k; ++j) {
+        const unsigned char c = static_cast<unsigned char>(set[j]);
+        bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const unsigned char c = static_cast<unsigned char>(h[i]);
+        if (bits[c >> 6] >> (c & 63) & 1) return i;
+    }
+    return k_simd_npos;
+}
+
+// ========== 分派 ==========
+// 以下函数要求 1 <= m <= n (k >= 1)，返回下标，没有时返回 k_simd_npos。
+// 最坏情况 (如在 "aaa...a" 中找 "aa...ab") 每个起点都是候选，为 O(n * m)，与 memchr + memcmp 的做法相同
+inline std::size_t simd_find(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+    if (m == 1) {  // 单个字节交给 memchr，libc 的实现已经向量化并且按对齐展开
+        const void* hit = std::memchr(h, static_cast<unsigned char>(p[0]), n);
+        return hit ? static_cast<std::size_t>(static_cast<const char*>(hit) - h) : k_simd_npos;
+    }
+#if MYSTL_HAS_SIMD_SEARCH
+    if (n - m + 1 >= simd_avx2::search_ops::width && cpu_has_avx2()) {
+        return simd_avx2::find_kernel<simd_avx2::search_ops>(h, n, p, m);
+    }
+    if (n - m + 1 >= simd_sse2::search_ops::width) return simd_sse2::find_kernel<simd_sse2::search_ops>(h, n, p, m);
+#endif
+    return scalar_find(h, n, p, m);
+}
+
+inline std::size_t simd_rfind(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+#if MYSTL_HAS_SIMD_SEARCH
+    if (n - m + 1 >= simd_avx2::search_ops::width && cpu_has_avx2()) {
+        return simd_avx2::rfind_kernel<simd_avx2::search_ops>(h, n, p, m);
+    }
+    if (n - m + 1 >= simd_sse2::search_ops::width) return simd_sse2::rfind_kernel<simd_sse2::search_ops>(h, n, p, m);
+#endif
+    return scalar_rfind(h, n, p, m);
+}
+
+inline std::size_t simd_find_first_of(const char* h, std::size_t n, const char* set, std::size_t k)
+{
+#if MYSTL_HAS_SIMD_SEARCH
+    if (k <= k_simd_set_max) {
+        if (n >= simd_avx2::search_ops::width && cpu_has_avx2()) {
+            return simd_avx2::find_first_of_kernel<simd_avx2::search_ops>(h, n, set, k);
+        }
+        if (n >= simd_sse2::search_ops::width) return simd_sse2::find_first_of_kernel<simd_sse2::search_ops>(h, n, set, k);
+    }
+#endif
+    return scalar_find_first_of(h, n, set, k);
+}
+
+} // namespace detail
+} // namespace mystl
@@ -0,0 +1,119 @@
+// 字节串查找内核
+// 与 simd_scan_kernel.h 相同，不带 #pragma once：simd_search.h 以不同的 MYSTL_SIMD_TARGET / MYSTL_SIMD_NS
+// 分别在 SSE2 和 AVX2 命名空间中包含一次。V 为对应指令集的字节比较操作集合（见 simd_search.h）
+
+// 起点 h[i, i + W) 中首字节等于 first、第 m - 1 个字节等于 last 的位掩码
+template <typename V>
+MYSTL_SIMD_TARGET inline std::uint32_t candidate_mask(const char* h, std::size_t i, std::size_t m, typename V::reg first,
+                                                      typename V::reg last)
+{
+    typename V::reg eq = V::cmpeq(V::load(h + i), first);
+    if (m > 1) eq = V::and_(eq, V::cmpeq(V::load(h + i + m - 1), last));
+    return V::movemask(eq);
+}
+
+// 在 h[0, n) 中找 p[0, m) 第一次出现的位置，1 <= m <= n，没有时返回 k_simd_npos。
+// 一次比较 W 个起点：起点处的字节等于 p[0]、起点 + m - 1 处的字节等于 p[m - 1] 的才是候选，
+// 候选再用 memcmp 比较中间的 m - 2 个字节。最后不足 W 个起点时退回一整块，屏蔽已经检查过的起点
+template <typename V>
+MYSTL_SIMD_TARGET std::size_t find_kernel(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+    using reg = typename V::reg;
+    constexpr std::size_t W = V::width;
+    const std::size_t starts = n - m + 1;
+    if (starts < W) return k_simd_npos;
+
+    const reg first = V::set1(p[0]);
+    const reg last = V::set1(p[m - 1]);
+    auto verify = [&](std::size_t i, std::uint32_t mask) -> std::size_t {
+        for (; mask; mask &= mask - 1) {
+            const std::size_t at = i + static_cast<std::size_t>(__builtin_ctz(mask));
+            if (m <= 2 || std::memcmp(h + at + 1, p + 1, m - 2) == 0) return at;
+        }
+        return k_simd_npos;
+    };
+
+    std::size_t i = 0;
+    for (; i + W <= starts; i += W) {
+        const std::uint32_t mask = candidate_mask<V>(h, i, m, first, last);
+        if (mask) {
+            const std::size_t at = verify(i, mask);
+            if (at != k_simd_npos) return at;
+        }
+    }
+    if (i < starts) {
+        const std::size_t s = starts - W;
+        const std::uint32_t mask = candidate_mask<V>(h, s, m, first, last) & (~std::uint32_t(0) << (i - s));
+        return verify(s, mask);
+    }
+    return k_simd_npos;
+}
+
+// 与 find_kernel 相同，但从最后一个起点往前找，块内从高位往低位检查
+template <typename V>
+MYSTL_SIMD_TARGET std::size_t rfind_kernel(const char* h, std::size_t n, const char* p, std::size_t m)
+{
+    using reg = typename V::reg;
+    constexpr std::size_t W = V::width;
+    const std::size_t starts = n - m + 1;
+    if (starts < W) return k_simd_npos;
+
+    const reg first = V::set1(p[0]);
+    const reg last = V::set1(p[m - 1]);
+    auto verify = [&](std::size_t i, std::uint32_t mask) -> std::size_t {
+        while (mask) {
+            const unsigned bit = 31u - static_cast<unsigned>(__builtin_clz(mask));
+            const std::size_t at = i + bit;
+            if (m <= 2 || std::memcmp(h + at + 1, p + 1, m - 2) == 0) return at;
+            mask &= ~(std::uint32_t(1) << bit);
+        }
+        return k_simd_npos;
+    };
+
+    std::size_t end = starts;  // [0, end) 中的起点尚未检查
+    for (; end >= W; end -= W) {
+        const std::uint32_t mask = candidate_mask<V>(h, end - W, m, first, last);
+        if (mask) {
+            const std::size_t at = verify(end - W, mask);
+            if (at != k_simd_npos) return at;
+        }
+    }
+    if (end > 0) {
+        const std::uint32_t keep = (std::uint32_t(1) << end) - 1;  // end < W <= 32
+        return verify(0, candidate_mask<V>(h, 0, m, first, last) & keep);
+    }
+    return k_simd_npos;
+}
+
+// p[0, W) 中等于 needles[0, k) 之一的字节的位掩码
+template <typename V>
+MYSTL_SIMD_TARGET inline std::uint32_t set_mask(const char* p, const typename V::reg* needles, std::size_t k)
+{
+    const typename V::reg v = V::load(p);
+    typename V::reg eq = V::cmpeq(v, needles[0]);
+    for (std::size_t j = 1; j < k; ++j) eq = V::or_(eq, V::cmpeq(v, needles[j]));
+    return V::movemask(eq);
+}
+
+// h[0, n) 中第一个属于 set[0, k) 的字节，1 <= k <= k_simd_set_max，n >= W；每个集合字节比较一次再按位或
+template <typename V>
+MYSTL_SIMD_TARGET std::size_t find_first_of_kernel(const char* h, std::size_t n, const char* set, std::size_t k)
+{
+    using reg = typename V::reg;
+    constexpr std::size_t W = V::width;
+
+    reg needles[k_simd_set_max];
+    for (std::size_t j = 0; j < k; ++j) needles[j] = V::set1(set[j]);
+
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        const std::uint32_t mask = set_mask<V>(h + i, needles, k);
+        if (mask) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    if (i < n) {
+        const std::size_t s = n - W;
+        const std::uint32_t mask = set_mask<V>(h + s, needles, k) & (~std::uint32_t(0) << (i - s));
+        if (mask) return s + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+    return k_simd_npos;
+}
@@ -0,0 +1,398 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+// 仅在 x86 + GCC/Clang 下启用：需要 target 属性和 __builtin_cpu_supports 做运行时分派
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#define MYSTL_HAS_SIMD_SORT 1
+#include <immintrin.h>
+#else
+#define MYSTL_HAS_SIMD_SORT 0
+#endif
+
+namespace mystl
+{
+namespace detail
+{
+
+// 每次最多使用的向量寄存器数，可排序的最大长度为 width * 32
+constexpr std::size_t k_simd_sort_max_regs = 32;
+
+#if MYSTL_HAS_SIMD_SORT
+
+// ========== SSE2：32 位 4 路，64 位 2 路 ==========
+namespace simd_sse2
+{
+inline __m128i blend_si(__m128i lo, __m128i hi, __m128i mask)
+{
+    return _mm_or_si128(_mm_and_si128(mask, hi), _mm_andnot_si128(mask, lo));
+}
+
+// lane 编号的第 bit 位为 1 的 lane 置为全 1；idx 为各 lane 的编号
+inline __m128i bit_mask(__m128i idx, std::size_t bit)
+{
+    __m128i b = _mm_set1_epi32(static_cast<int>(bit));
+    return _mm_cmpeq_epi32(_mm_and_si128(idx, b), b);
+}
+
+struct int32_ops
+{
+    using value_type = std::int32_t;
+    using reg = __m128i;
+    static constexpr std::size_t width = 4;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    static reg load(const value_type* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(value_type* p, reg v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    // SSE2 没有 pminsd，用比较 + 掩码选择
+    static reg min(reg a, reg b) { return blend_si(a, b, _mm_cmpgt_epi32(a, b)); }
+    static reg max(reg a, reg b) { return blend_si(b, a, _mm_cmpgt_epi32(a, b)); }
+    static reg blend(reg lo, reg hi, reg mask) { return blend_si(lo, hi, mask); }
+    static reg lane_mask(std::size_t bit) { return bit_mask(_mm_set_epi32(3, 2, 1, 0), bit); }
+    static reg mask_not(reg m) { return _mm_xor_si128(m, _mm_set1_epi32(-1)); }
+    static reg mask_xor(reg a, reg b) { return _mm_xor_si128(a, b); }
+    static reg permute_xor(reg v, std::size_t j)
+    {
+        return j == 1 ? _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)) : _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+// 无符号比较：翻转符号位后按有符号比较
+struct uint32_ops : int32_ops
+{
+    using value_type = std::uint32_t;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    static reg load(const value_type* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(value_type* p, reg v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    static reg gt(reg a, reg b)
+    {
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        return _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+    }
+    static reg min(reg a, reg b) { return blend_si(a, b, gt(a, b)); }
+    static reg max(reg a, reg b) { return blend_si(b, a, gt(a, b)); }
+};
+
+struct float_ops
+{
+    using value_type = float;
+    using reg = __m128;
+    static constexpr std::size_t width = 4;
+
+    static value_type pad_value() { return std::numeric_limits<float>::infinity(); }
+    static reg load(const value_type* p) { return _mm_load_ps(p); }
+    static void store(value_type* p, reg v) { _mm_store_ps(p, v); }
+    // 不用 minps / maxps：它们遇到 NaN 或 ±0 时两个输出可能相同，结果不再是输入的排列
+    static reg min(reg a, reg b) { return blend(a, b, _mm_cmplt_ps(b, a)); }
+    static reg max(reg a, reg b) { return blend(b, a, _mm_cmplt_ps(b, a)); }
+    static reg blend(reg lo, reg hi, reg mask) { return _mm_or_ps(_mm_and_ps(mask, hi), _mm_andnot_ps(mask, lo)); }
+    static reg lane_mask(std::size_t bit) { return _mm_castsi128_ps(int32_ops::lane_mask(bit)); }
+    static reg mask_not(reg m) { return _mm_xor_ps(m, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+    static reg mask_xor(reg a, reg b) { return _mm_xor_ps(a, b); }
+    static reg permute_xor(reg v, std::size_t j)
+    {
+        return j == 1 ? _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)) : _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+struct int64_ops
+{
+    using value_type = std::int64_t;
+    using reg = __m128i;
+    static constexpr std::size_t width = 2;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    static reg load(const value_type* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(value_type* p, reg v) { _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+    // SSE2 没有 64 位比较：高 32 位有符号比较，相等时再比较低 32 位（无符号）
+    static reg gt(reg a, reg b)
+    {
+        const __m128i lo_sign = _mm_set_epi32(0, static_cast<int>(0x80000000u), 0, static_cast<int>(0x80000000u));
+        __m128i gt32 = _mm_cmpgt_epi32(_mm_xor_si128(a, lo_sign), _mm_xor_si128(b, lo_sign));
+        __m128i eq32 = _mm_cmpeq_epi32(a, b);
+        __m128i gt_hi = _mm_shuffle_epi32(gt32, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128i gt_lo = _mm_shuffle_epi32(gt32, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128i eq_hi = _mm_shuffle_epi32(eq32, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_or_si128(gt_hi, _mm_and_si128(eq_hi, gt_lo));
+    }
+    static reg min(reg a, reg b) { return blend_si(a, b, gt(a, b)); }
+    static reg max(reg a, reg b) { return blend_si(b, a, gt(a, b)); }
+    static reg blend(reg lo, reg hi, reg mask) { return blend_si(lo, hi, mask); }
+    static reg lane_mask(std::size_t bit) { return bit_mask(_mm_set_epi32(1, 1, 0, 0), bit); }
+    static reg mask_not(reg m) { return _mm_xor_si128(m, _mm_set1_epi32(-1)); }
+    static reg mask_xor(reg a, reg b) { return _mm_xor_si128(a, b); }
+    static reg permute_xor(reg v, std::size_t) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); }
+};
+
+struct double_ops
+{
+    using value_type = double;
+    using reg = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static value_type pad_value() { return std::numeric_limits<double>::infinity(); }
+    static reg load(const value_type* p) { return _mm_load_pd(p); }
+    static void store(value_type* p, reg v) { _mm_store_pd(p, v); }
+    static reg min(reg a, reg b) { return blend(a, b, _mm_cmplt_pd(b, a)); }
+    static reg max(reg a, reg b) { return blend(b, a, _mm_cmplt_pd(b, a)); }
+    static reg blend(reg lo, reg hi, reg mask) { return _mm_or_pd(_mm_and_pd(mask, hi), _mm_andnot_pd(mask, lo)); }
+    static reg lane_mask(std::size_t bit) { return _mm_castsi128_pd(int64_ops::lane_mask(bit)); }
+    static reg mask_not(reg m) { return _mm_xor_pd(m, _mm_castsi128_pd(_mm_set1_epi32(-1))); }
+    static reg mask_xor(reg a, reg b) { return _mm_xor_pd(a, b); }
+    static reg permute_xor(reg v, std::size_t) { return _mm_shuffle_pd(v, v, 1); }
+};
+
+#define MYSTL_SIMD_TARGET
+#define MYSTL_SIMD_NS simd_sse2
+#include "simd_sort_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_sse2
+
+// ========== AVX2：32 位 8 路，64 位 4 路 ==========
+// 所有函数都带 target("avx2")，只有运行时检测到 AVX2 才会被调用
+namespace simd_avx2
+{
+#define MYSTL_SIMD_TARGET __attribute__((target("avx2")))
+
+MYSTL_SIMD_TARGET inline __m256i bit_mask(__m256i idx, std::size_t bit)
+{
+    __m256i b = _mm256_set1_epi32(static_cast<int>(bit));
+    return _mm256_cmpeq_epi32(_mm256_and_si256(idx, b), b);
+}
+
+struct int32_ops
+{
+    using value_type = std::int32_t;
+    using reg = __m256i;
+    static constexpr std::size_t width = 8;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    MYSTL_SIMD_TARGET static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    MYSTL_SIMD_TARGET static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+    MYSTL_SIMD_TARGET static reg blend(reg lo, reg hi, reg mask) { return _mm256_blendv_epi8(lo, hi, mask); }
+    MYSTL_SIMD_TARGET static reg lane_index() { return _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0); }
+    MYSTL_SIMD_TARGET static reg lane_mask(std::size_t bit) { return bit_mask(lane_index(), bit); }
+    MYSTL_SIMD_TARGET static reg mask_not(reg m) { return _mm256_xor_si256(m, _mm256_set1_epi32(-1)); }
+    MYSTL_SIMD_TARGET static reg mask_xor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+    MYSTL_SIMD_TARGET static reg permute_xor(reg v, std::size_t j)
+    {
+        __m256i idx = _mm256_xor_si256(lane_index(), _mm256_set1_epi32(static_cast<int>(j)));
+        return _mm256_permutevar8x32_epi32(v, idx);
+    }
+};
+
+struct uint32_ops : int32_ops
+{
+    using value_type = std::uint32_t;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    MYSTL_SIMD_TARGET static reg min(reg a, reg b) { return _mm256_min_epu32(a, b); }
+    MYSTL_SIMD_TARGET static reg max(reg a, reg b) { return _mm256_max_epu32(a, b); }
+};
+
+struct float_ops
+{
+    using value_type = float;
+    using reg = __m256;
+    static constexpr std::size_t width = 8;
+
+    static value_type pad_value() { return std::numeric_limits<float>::infinity(); }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_load_ps(p); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_store_ps(p, v); }
+    MYSTL_SIMD_TARGET static reg min(reg a, reg b) { return _mm256_blendv_ps(a, b, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+    MYSTL_SIMD_TARGET static reg max(reg a, reg b) { return _mm256_blendv_ps(b, a, _mm256_cmp_ps(b, a, _CMP_LT_OQ)); }
+    MYSTL_SIMD_TARGET static reg blend(reg lo, reg hi, reg mask) { return _mm256_blendv_ps(lo, hi, mask); }
+    MYSTL_SIMD_TARGET static reg lane_mask(std::size_t bit) { return _mm256_castsi256_ps(int32_ops::lane_mask(bit)); }
+    MYSTL_SIMD_TARGET static reg mask_not(reg m) { return _mm256_xor_ps(m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    MYSTL_SIMD_TARGET static reg mask_xor(reg a, reg b) { return _mm256_xor_ps(a, b); }
+    MYSTL_SIMD_TARGET static reg permute_xor(reg v, std::size_t j)
+    {
+        __m256i idx = _mm256_xor_si256(int32_ops::lane_index(), _mm256_set1_epi32(static_cast<int>(j)));
+        return _mm256_permutevar8x32_ps(v, idx);
+    }
+};
+
+struct int64_ops
+{
+    using value_type = std::int64_t;
+    using reg = __m256i;
+    static constexpr std::size_t width = 4;
+
+    static value_type pad_value() { return std::numeric_limits<value_type>::max(); }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    // AVX2 没有 vpminsq，用 vpcmpgtq + blend
+    MYSTL_SIMD_TARGET static reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    MYSTL_SIMD_TARGET static reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    MYSTL_SIMD_TARGET static reg blend(reg lo, reg hi, reg mask) { return _mm256_blendv_epi8(lo, hi, mask); }
+    MYSTL_SIMD_TARGET static reg lane_mask(std::size_t bit) { return bit_mask(_mm256_set_epi32(3, 3, 2, 2, 1, 1, 0, 0), bit); }
+    MYSTL_SIMD_TARGET static reg mask_not(reg m) { return _mm256_xor_si256(m, _mm256_set1_epi32(-1)); }
+    MYSTL_SIMD_TARGET static reg mask_xor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+    MYSTL_SIMD_TARGET static reg permute_xor(reg v, std::size_t j)
+    {
+        return j == 1 ? _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)) : _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+struct double_ops
+{
+    using value_type = double;
+    using reg = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static value_type pad_value() { return std::numeric_limits<double>::infinity(); }
+    MYSTL_SIMD_TARGET static reg load(const value_type* p) { return _mm256_load_pd(p); }
+    MYSTL_SIMD_TARGET static void store(value_type* p, reg v) { _mm256_store_pd(p, v); }
+    MYSTL_SIMD_TARGET static reg min(reg a, reg b) { return _mm256_blendv_pd(a, b, _mm256_cmp_pd(b, a, _CMP_LT_OQ)); }
+    MYSTL_SIMD_TARGET static reg max(reg a, reg b) { return _mm256_blendv_pd(b, a, _mm256_cmp_pd(b, a, _CMP_LT_OQ)); }
+    MYSTL_SIMD_TARGET static reg blend(reg lo, reg hi, reg mask) { return _mm256_blendv_pd(lo, hi, mask); }
+    MYSTL_SIMD_TARGET static reg lane_mask(std::size_t bit) { return _mm256_castsi256_pd(int64_ops::lane_mask(bit)); }
+    MYSTL_SIMD_TARGET static reg mask_not(reg m) { return _mm256_xor_pd(m, _mm256_castsi256_pd(_mm256_set1_epi32(-1))); }
+    MYSTL_SIMD_TARGET static reg mask_xor(reg a, reg b) { return _mm256_xor_pd(a, b); }
+    MYSTL_SIMD_TARGET static reg permute_xor(reg v, std::size_t j)
+    {
+        return j == 1 ? _mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 3, 0, 1)) : _mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+};
+
+#define MYSTL_SIMD_NS simd_avx2
+#include "simd_sort_kernel.h"
+#undef MYSTL_SIMD_NS
+#undef MYSTL_SIMD_TARGET
+} // namespace simd_avx2
+
+inline bool cpu_has_avx2()
+{
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+
+// 元素类型 -> 两套指令集的操作集合；不支持的类型 supported 为 false
+template <typename Tp, typename = void>
+struct simd_sort_ops { static constexpr bool supported = false; };
+
+template <typename Tp>
+struct simd_sort_ops<Tp, std::enable_if_t<std::is_integral<Tp>::value && sizeof(Tp) == 4 && std::is_signed<Tp>::value>>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::int32_ops;
+    using avx2 = simd_avx2::int32_ops;
+};
+
+template <typename Tp>
+struct simd_sort_ops<Tp, std::enable_if_t<std::is_integral<Tp>::value && sizeof(Tp) == 4 && std::is_unsigned<Tp>::value>>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::uint32_ops;
+    using avx2 = simd_avx2::uint32_ops;
+};
+
+template <typename Tp>
+struct simd_sort_ops<Tp, std::enable_if_t<std::is_integral<Tp>::value && sizeof(Tp) == 8 && std::is_signed<Tp>::value>>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::int64_ops;
+    using avx2 = simd_avx2::int64_ops;
+};
+
+template <>
+struct simd_sort_ops<float>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::float_ops;
+    using avx2 = simd_avx2::float_ops;
+};
+
+template <>
+struct simd_sort_ops<double>
+{
+    static constexpr bool supported = true;
+    using sse2 = simd_sse2::double_ops;
+    using avx2 = simd_avx2::double_ops;
+};
+
+#else
+
+template <typename Tp>
+struct simd_sort_ops { static constexpr bool supported = false; };
+
+#endif // MYSTL_HAS_SIMD_SORT
+
+// 比较器是否为升序 / 降序的内置比较
+template <typename Compare, typename Tp>
+struct is_less_compare
+    : std::integral_constant<bool, std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<Tp>>::value>
+{};
+
+template <typename Compare, typename Tp>
+struct is_greater_compare
+    : std::integral_constant<bool, std::is_same<Compare, std::greater<>>::value || std::is_same<Compare, std::greater<Tp>>::value>
+{};
+
+// 迭代器是裸指针（连续存储）、元素类型受支持、比较器是 std::less / std::greater 时才能用 SIMD 排序
+template <typename Iter, typename Compare>
+struct is_simd_sortable : std::false_type {};
+
+template <typename Tp, typename Compare>
+struct is_simd_sortable<Tp*, Compare>
+    : std::integral_constant<bool, simd_sort_ops<std::remove_cv_t<Tp>>::supported && !std::is_const<Tp>::value
+                                   && (is_less_compare<Compare, Tp>::value || is_greater_compare<Compare, Tp>::value)>
+{};
+
+// SIMD 排序可处理的最大长度（按 SSE2 的宽度计算，两套指令集都能处理）
+template <typename Tp>
+constexpr std::size_t simd_sort_capacity()
+{
+    return (sizeof(Tp) == 4 ? 4 : 2) * k_simd_sort_max_regs;
+}
+
+// 作为 sort / pdq_sort 叶子时的长度上限。再大 AVX2 仍有收益，但只有 SSE2 时 64 位元素会慢于插入排序
+constexpr std::size_t k_simd_sort_leaf_size_32 = 64;
+constexpr std::size_t k_simd_sort_leaf_size_64 = 32;
+
+template <typename Tp>
+constexpr std::size_t simd_sort_leaf_size()
+{
+    return sizeof(Tp) == 4 ? k_simd_sort_leaf_size_32 : k_simd_sort_leaf_size_64;
+}
+
+// 用排序网络排序 [first, last)。长度超过 simd_sort_capacity 或浮点数中有 NaN 时返回 false 且不做任何修改，
+// 由调用者退回插入排序（NaN 与填充值比较结果都为 false，排序网络可能把填充值换进结果里）。
+// 只应在 is_simd_sortable 为 true 时调用
+template <typename Tp, typename Compare>
+bool simd_small_sort(Tp* first, Tp* last, Compare&)
+{
+#if MYSTL_HAS_SIMD_SORT
+    using ops = simd_sort_ops<Tp>;
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n > simd_sort_capacity<Tp>()) return false;
+    if (n < 2) return true;
+    if (std::is_floating_point<Tp>::value) {
+        for (std::size_t i = 0; i < n; ++i)
+            if (first[i] != first[i]) return false;
+    }
+    const bool descending = is_greater_compare<Compare, Tp>::value;
+    // 一个 SSE2 寄存器就装得下时，AVX2 只会多排一倍的填充值
+    if (n > ops::sse2::width && cpu_has_avx2()) simd_avx2::small_sort<typename ops::avx2>(first, n, descending);
+    else simd_sse2::small_sort<typename ops::sse2>(first, n, descending);
+    return true;
+#else
+    (void)first;
+    (void)last;
+    return false;
+#endif
+}
+
+} // namespace detail
+} // namespace mystl
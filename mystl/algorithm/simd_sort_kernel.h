@@ -0,0 +1,81 @@
+// 双调排序网络 (bitonic sorting network) 内核
+// 不带 #pragma once：simd_sort.h 会在不同的命名空间中以不同的 MYSTL_SIMD_TARGET 包含两次，
+// 分别生成 SSE2 和 AVX2 版本。V 为对应指令集的向量操作集合（见 simd_sort.h）。
+// 内部调用用 MYSTL_SIMD_NS 限定，避免两个版本的同名模板互相混用
+
+// 对 buf[0, R * V::width) 做双调排序，R 个寄存器在编译期确定，循环可以完全展开。
+// 元素下标 i = reg * width + lane，第 (k, j) 步比较交换 i 与 i ^ j，(i & k) == 0 时升序
+template <typename V, std::size_t R>
+MYSTL_SIMD_TARGET void bitonic_sort_regs(typename V::value_type* buf)
+{
+    using reg = typename V::reg;
+    constexpr std::size_t W = V::width;
+    constexpr std::size_t M = R * W;
+
+    reg v[R];
+    for (std::size_t a = 0; a < R; ++a) v[a] = V::load(buf + a * W);
+
+    for (std::size_t k = 2; k <= M; k <<= 1) {
+        for (std::size_t j = k >> 1; j > 0; j >>= 1) {
+            if (j >= W) {
+                // 跨寄存器：同一 lane 纵向比较，方向只取决于寄存器编号
+                const std::size_t jr = j / W;
+                for (std::size_t a = 0; a < R; ++a) {
+                    const std::size_t b = a ^ jr;
+                    if (b < a) continue;
+                    reg lo = V::min(v[a], v[b]);
+                    reg hi = V::max(v[a], v[b]);
+                    const bool descending = ((a * W) & k) != 0;
+                    v[a] = descending ? hi : lo;
+                    v[b] = descending ? lo : hi;
+                }
+            } else {
+                // 寄存器内：与 lane ^ j 的元素比较，按掩码选择 min 或 max。
+                // lane 取 max 当且仅当 (lane & j) != 0 与是否降序不同
+                const reg mask_j = V::lane_mask(j);
+                for (std::size_t a = 0; a < R; ++a) {
+                    reg mask;
+                    if (k >= W) mask = ((a * W) & k) ? V::mask_not(mask_j) : mask_j;
+                    else mask = V::mask_xor(mask_j, V::lane_mask(k));
+                    reg p = V::permute_xor(v[a], j);
+                    v[a] = V::blend(V::min(v[a], p), V::max(v[a], p), mask);
+                }
+            }
+        }
+    }
+
+    for (std::size_t a = 0; a < R; ++a) V::store(buf + a * W, v[a]);
+}
+
+// 排序 data[0, n)，n 不超过 V::width * k_simd_sort_max_regs。
+// 拷贝到对齐的缓冲区并用最大值填充到 2 的幂，排序后再拷回（descending 时倒序拷回）
+template <typename V, typename Tp>
+MYSTL_SIMD_TARGET void small_sort(Tp* data, std::size_t n, bool descending)
+{
+    using value_type = typename V::value_type;
+    static_assert(sizeof(value_type) == sizeof(Tp), "element size mismatch");
+    constexpr std::size_t W = V::width;
+
+    alignas(64) value_type buf[W * k_simd_sort_max_regs];
+    std::size_t m = W;
+    while (m < n) m <<= 1;
+
+    std::memcpy(buf, data, n * sizeof(Tp));
+    for (std::size_t i = n; i < m; ++i) buf[i] = V::pad_value();
+
+    switch (m / W) {
+    case 1:  MYSTL_SIMD_NS::bitonic_sort_regs<V, 1>(buf); break;
+    case 2:  MYSTL_SIMD_NS::bitonic_sort_regs<V, 2>(buf); break;
+    case 4:  MYSTL_SIMD_NS::bitonic_sort_regs<V, 4>(buf); break;
+    case 8:  MYSTL_SIMD_NS::bitonic_sort_regs<V, 8>(buf); break;
+    case 16: MYSTL_SIMD_NS::bitonic_sort_regs<V, 16>(buf); break;
+    default: MYSTL_SIMD_NS::bitonic_sort_regs<V, 32>(buf); break;
+    }
+
+    if (!descending) {
+        std::memcpy(data, buf, n * sizeof(Tp));
+    } else {
+        for (std::size_t i = 0; i < n; ++i)
+            std::memcpy(data + i, buf + (n - 1 - i), sizeof(Tp));
+    }
+}
@@ -1,9 +1,19 @@
 #pragma once 
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
+#include "../iterator.h"
+#include "../thread_pool.h"
 #include "../utility.h"
 #include "algobase.h"
+#include "heap.h"
+#include "simd_sort.h"
 
 namespace mystl
 {
@@ -39,8 +49,13 @@ void select_sort(Iter first, Iter last, Compare comp = {})
 }
 
 // ---- 快速排序 ----
+// 教学版本：固定取 *last 为枢轴，有序/逆序输入会退化为 O(n^2) 且递归深度为 O(n)，
+// 实际使用请调用下面的 mystl::sort
+namespace detail
+{
+// 闭区间 [first, last]，以 *last 为枢轴
 template <typename Iter, typename Compare>
-Iter partition(Iter first, Iter last, Compare comp) {
+Iter quick_sort_partition(Iter first, Iter last, Compare comp) {
     while (first < last) {
         while (first < last && comp(*first, *last)) --last;
         mystl::swap(*first, *last);
@@ -49,15 +64,1359 @@ Iter partition(Iter first, Iter last, Compare comp) {
     }
     return first;
 }
+} // namespace detail
 
 template <typename Iter, typename Compare = std::less<>>
 void quick_sort(Iter first, Iter last, Compare comp = {})
 {
     if (first < last - 1) {
-        auto mid = mystl::partition(first, last - 1, comp);
+        auto mid = detail::quick_sort_partition(first, last - 1, comp);
         quick_sort(first, mid + 1, comp);
         quick_sort(mid + 1, last, comp);
     }
 }
 
+// ---- 内省排序 (introsort) ----
+namespace detail
+{
+// 小于该长度的区间交给插入排序
+constexpr std::ptrdiff_t k_insertion_sort_threshold = 16;
+// 大于该长度时用 ninther（三组中位数的中位数）选取枢轴
+constexpr std::ptrdiff_t k_ninther_threshold = 128;
+
+template <typename Iter>
+void iter_swap(Iter a, Iter b) { mystl::swap(*a, *b); }
+
+// 假定 *i 左侧某处存在不大于 *i 的元素，因此不需要边界检查
+template <typename Iter, typename Compare>
+void unguarded_linear_insert(Iter i, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*i)>;
+    value_type value = mystl::move(*i);
+    Iter prev = i;
+    --prev;
+    while (comp(value, *prev)) {
+        *i = mystl::move(*prev);
+        i = prev;
+        --prev;
+    }
+    *i = mystl::move(value);
+}
+
+template <typename Iter, typename Compare>
+void insertion_sort(Iter first, Iter last, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    if (first == last) return;
+    for (Iter i = first + 1; i != last; ++i) {
+        if (comp(*i, *first)) {
+            // 比首元素还小：整体后移一位，放到最前面
+            value_type value = mystl::move(*i);
+            for (Iter j = i; j != first; ) {
+                Iter prev = j;
+                --prev;
+                *j = mystl::move(*prev);
+                j = prev;
+            }
+            *first = mystl::move(value);
+        } else {
+            detail::unguarded_linear_insert(i, comp);
+        }
+    }
+}
+
+template <typename Iter, typename Compare>
+void unguarded_insertion_sort(Iter first, Iter last, Compare& comp)
+{
+    for (Iter i = first; i != last; ++i)
+        detail::unguarded_linear_insert(i, comp);
+}
+
+// introsort_loop 结束后每个长度不超过阈值的块都已就位，
+// 只有第一个块需要带边界检查的插入排序，其余可以无哨兵插入
+template <typename Iter, typename Compare>
+void final_insertion_sort(Iter first, Iter last, Compare& comp)
+{
+    if (last - first > k_insertion_sort_threshold) {
+        detail::insertion_sort(first, first + k_insertion_sort_threshold, comp);
+        detail::unguarded_insertion_sort(first + k_insertion_sort_threshold, last, comp);
+    } else {
+        detail::insertion_sort(first, last, comp);
+    }
+}
+
+// 返回 a, b, c 三者中位数所在的迭代器
+template <typename Iter, typename Compare>
+Iter median_of_three(Iter a, Iter b, Iter c, Compare& comp)
+{
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) return b;
+        if (comp(*a, *c)) return c;
+        return a;
+    }
+    if (comp(*a, *c)) return a;
+    if (comp(*b, *c)) return c;
+    return b;
+}
+
+// 选取枢轴并放到 *first。候选点都取自 [first + 1, last)，
+// 因此区间内一定同时存在 >= 枢轴和 <= 枢轴的元素，可作为无边界检查分区的哨兵
+template <typename Iter, typename Compare>
+void move_pivot_to_first(Iter first, Iter last, Compare& comp)
+{
+    std::ptrdiff_t len = last - first;
+    Iter mid = first + len / 2;
+    if (len > k_ninther_threshold) {
+        std::ptrdiff_t step = len / 8;
+        Iter lo = detail::median_of_three(first + 1, first + (1 + step), first + (1 + 2 * step), comp);
+        Iter md = detail::median_of_three(mid - step, mid, mid + step, comp);
+        Iter hi = detail::median_of_three(last - (1 + 2 * step), last - (1 + step), last - 1, comp);
+        detail::iter_swap(first, detail::median_of_three(lo, md, hi, comp));
+    } else {
+        detail::iter_swap(first, detail::median_of_three(first + 1, mid, last - 1, comp));
+    }
+}
+
+// Hoare 分区，枢轴位于 *pivot，返回右半部分的起点
+template <typename Iter, typename Compare>
+Iter unguarded_partition(Iter first, Iter last, Iter pivot, Compare& comp)
+{
+    while (true) {
+        while (comp(*first, *pivot)) ++first;
+        --last;
+        while (comp(*pivot, *last)) --last;
+        if (!(first < last)) return first;
+        detail::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template <typename Iter, typename Compare>
+void heap_sort(Iter first, Iter last, Compare& comp)
+{
+    mystl::make_heap(first, last, comp);
+    mystl::sort_heap(first, last, comp);
+}
+
+// 叶子区间的长度上限：元素类型和比较器支持 SIMD 排序网络时用更大的叶子，
+// 一次排序网络比多层划分 + 插入排序更快
+template <typename Iter, typename Compare>
+constexpr std::ptrdiff_t sort_leaf_threshold(std::ptrdiff_t fallback)
+{
+    using value_type = std::decay_t<decltype(*std::declval<Iter>())>;
+    if (detail::is_simd_sortable<Iter, Compare>::value)
+        return static_cast<std::ptrdiff_t>(detail::simd_sort_leaf_size<value_type>());
+    return fallback;
+}
+
+// 递归深度超过 depth_limit 时退化为堆排序，保证最坏 O(n log n)；
+// 只对较短的一侧递归、较长的一侧留在循环里，栈深度不超过 O(log n)
+template <typename Iter, typename Compare>
+void introsort_loop(Iter first, Iter last, int depth_limit, Compare& comp)
+{
+    constexpr std::ptrdiff_t leaf = detail::sort_leaf_threshold<Iter, Compare>(k_insertion_sort_threshold);
+    while (last - first > leaf) {
+        if (depth_limit == 0) {
+            detail::heap_sort(first, last, comp);
+            return;
+        }
+        --depth_limit;
+        detail::move_pivot_to_first(first, last, comp);
+        Iter cut = detail::unguarded_partition(first + 1, last, first, comp);
+        if (cut - first < last - cut) {
+            detail::introsort_loop(first, cut, depth_limit, comp);
+            first = cut;
+        } else {
+            detail::introsort_loop(cut, last, depth_limit, comp);
+            last = cut;
+        }
+    }
+    // SIMD 叶子直接就地排好；否则留给 final_insertion_sort
+    if constexpr (detail::is_simd_sortable<Iter, Compare>::value) {
+        if (!detail::simd_small_sort(first, last, comp)) detail::insertion_sort(first, last, comp);
+    }
+}
+
+inline int log2_floor(std::ptrdiff_t n)
+{
+    int k = 0;
+    for (; n > 1; n >>= 1) ++k;
+    return k;
+}
+
+} // namespace detail
+
+// 插入排序，适合很短或基本有序的区间
+template <typename Iter, typename Compare = std::less<>>
+void insertion_sort(Iter first, Iter last, Compare comp = {})
+{
+    detail::insertion_sort(first, last, comp);
+}
+
+// 堆排序，原地、最坏 O(n log n)，不稳定
+template <typename Iter, typename Compare = std::less<>>
+void heap_sort(Iter first, Iter last, Compare comp = {})
+{
+    detail::heap_sort(first, last, comp);
+}
+
+// 内省排序：ninther / 三数取中选枢轴 + 深度超限转堆排序 + 小区间插入排序
+// 最坏 O(n log n)，栈深度 O(log n)，不稳定
+template <typename Iter, typename Compare = std::less<>>
+void sort(Iter first, Iter last, Compare comp = {})
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::sort requires random access iterators");
+    const iter_difference_t<Iter> n = mystl::distance(first, last);
+    if (n < 2) return;
+    detail::introsort_loop(first, last, 2 * detail::log2_floor(n), comp);
+    if constexpr (!detail::is_simd_sortable<Iter, Compare>::value)
+        detail::final_insertion_sort(first, last, comp);
+}
+
+// 短区间排序：元素为 4 / 8 字节整数或浮点、比较器为 std::less / std::greater 且迭代器是指针时，
+// 用 AVX2 / SSE2 双调排序网络（运行时检测 CPU 选择），否则退化为插入排序
+template <typename Iter, typename Compare = std::less<>>
+void small_sort(Iter first, Iter last, Compare comp = {})
+{
+    if constexpr (detail::is_simd_sortable<Iter, Compare>::value) {
+        if (detail::simd_small_sort(first, last, comp)) return;
+    }
+    detail::insertion_sort(first, last, comp);
+}
+
+// ---- 基数排序 (LSD radix sort) ----
+namespace detail
+{
+// 小于该长度时直接用比较排序
+constexpr std::ptrdiff_t k_radix_sort_threshold = 256;
+// scatter 时提前多少个元素预取目标位置
+constexpr std::ptrdiff_t k_radix_prefetch_distance = 16;
+
+// 把 key 映射为无符号整数，且映射后的无符号序与原来的序一致
+template <typename Key, typename = void>
+struct radix_key;
+
+// 无符号整数原样使用；有符号整数翻转符号位
+template <typename Key>
+struct radix_key<Key, std::enable_if_t<std::is_integral<Key>::value && !std::is_same<Key, bool>::value>>
+{
+    using bits_type = std::make_unsigned_t<Key>;
+
+    static bits_type encode(Key key)
+    {
+        bits_type bits = static_cast<bits_type>(key);
+        if (std::is_signed<Key>::value) bits ^= bits_type(1) << (sizeof(Key) * 8 - 1);
+        return bits;
+    }
+};
+
+// IEEE 754 浮点：正数翻转符号位，负数按位取反
+// 结果顺序为 -NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN
+template <typename Key>
+struct radix_key<Key, std::enable_if_t<std::is_floating_point<Key>::value>>
+{
+    static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "radix_sort only supports float and double");
+    using bits_type = std::conditional_t<sizeof(Key) == 4, std::uint32_t, std::uint64_t>;
+
+    static bits_type encode(Key key)
+    {
+        bits_type bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        const bits_type sign = bits_type(1) << (sizeof(Key) * 8 - 1);
+        return (bits & sign) ? ~bits : (bits | sign);
+    }
+};
+
+// radix_key 支持的键: 除 bool 以外的整数，以及 float / double
+template <typename Key>
+struct is_radix_key
+    : std::integral_constant<bool, (std::is_integral<Key>::value && !std::is_same<Key, bool>::value) ||
+                                       (std::is_floating_point<Key>::value && (sizeof(Key) == 4 || sizeof(Key) == 8))> {};
+
+inline void prefetch_write(const void* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p, 1);
+#else
+    (void)p;
+#endif
+}
+
+// 按第 shift 位开始的字节把 src[0, n) 分发到 dst，offset 为各桶的起始位置（会被修改）
+template <typename Src, typename Dst, typename Encode>
+void radix_scatter(Src src, std::ptrdiff_t n, Dst dst, std::size_t* offset, unsigned shift, Encode& encode)
+{
+    std::ptrdiff_t i = 0;
+    for (; i + k_radix_prefetch_distance < n; ++i) {
+        std::size_t ahead = (encode(*(src + (i + k_radix_prefetch_distance))) >> shift) & 0xff;
+        detail::prefetch_write(&*(dst + offset[ahead]));
+        std::size_t byte = (encode(*(src + i)) >> shift) & 0xff;
+        *(dst + offset[byte]++) = mystl::move(*(src + i));
+    }
+    for (; i < n; ++i) {
+        std::size_t byte = (encode(*(src + i)) >> shift) & 0xff;
+        *(dst + offset[byte]++) = mystl::move(*(src + i));
+    }
+}
+
+// encode(elem) 返回无符号整数，按其逐字节从低到高做稳定的计数分发
+template <typename Iter, typename Encode>
+void radix_sort_impl(Iter first, Iter last, Encode encode)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    using bits_type = decltype(encode(*first));
+    constexpr unsigned passes = sizeof(bits_type);
+
+    const std::ptrdiff_t n = last - first;
+
+    // 一趟遍历统计出所有字节的直方图
+    std::size_t hist[passes][256] = {};
+    for (Iter it = first; it != last; ++it) {
+        bits_type bits = encode(*it);
+        for (unsigned p = 0; p < passes; ++p)
+            ++hist[p][(bits >> (p * 8)) & 0xff];
+    }
+
+    const bits_type first_bits = encode(*first);
+    std::unique_ptr<value_type[]> buf;
+    bool in_buf = false; // 当前数据是否位于 buf 中
+
+    for (unsigned p = 0; p < passes; ++p) {
+        std::size_t* count = hist[p];
+        // 所有 key 在该字节上都相同，这一趟不会改变顺序
+        if (count[(first_bits >> (p * 8)) & 0xff] == static_cast<std::size_t>(n)) continue;
+
+        std::size_t sum = 0;
+        for (unsigned b = 0; b < 256; ++b) {
+            std::size_t c = count[b];
+            count[b] = sum;
+            sum += c;
+        }
+
+        if (!buf) buf.reset(new value_type[n]);
+        if (in_buf) detail::radix_scatter(buf.get(), n, first, count, p * 8, encode);
+        else detail::radix_scatter(first, n, buf.get(), count, p * 8, encode);
+        in_buf = !in_buf;
+    }
+
+    if (in_buf) {
+        for (std::ptrdiff_t i = 0; i < n; ++i)
+            *(first + i) = mystl::move(buf[i]);
+    }
+}
+
+} // namespace detail
+
+// 基数排序：元素本身是整数或 float/double，按值升序，稳定
+template <typename Iter>
+void radix_sort(Iter first, Iter last)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    using key_traits = detail::radix_key<value_type>;
+    if (last - first < detail::k_radix_sort_threshold) {
+        mystl::sort(first, last, [](const value_type& a, const value_type& b) {
+            return key_traits::encode(a) < key_traits::encode(b);
+        });
+        return;
+    }
+    detail::radix_sort_impl(first, last, [](const value_type& v) { return key_traits::encode(v); });
+}
+
+// 基数排序：按 key(elem) 返回的整数或 float/double 字段升序，稳定
+// 元素需要可默认构造和移动赋值（排序时会申请同样长度的临时缓冲区）
+template <typename Iter, typename KeyFunc>
+void radix_sort(Iter first, Iter last, KeyFunc key)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    using key_type = std::decay_t<decltype(key(*first))>;
+    using key_traits = detail::radix_key<key_type>;
+    if (last - first < detail::k_radix_sort_threshold) {
+        // 插入排序是稳定的，小区间直接用它
+        auto comp = [&key](const value_type& a, const value_type& b) {
+            return key_traits::encode(key(a)) < key_traits::encode(key(b));
+        };
+        detail::insertion_sort(first, last, comp);
+        return;
+    }
+    detail::radix_sort_impl(first, last, [&key](const value_type& v) { return key_traits::encode(key(v)); });
+}
+
+// ---- 并行归并排序 ----
+namespace detail
+{
+// 长度不超过该值的子区间直接用串行 sort
+constexpr std::ptrdiff_t k_parallel_sort_cutoff = 1 << 14;
+
+template <typename Iter, typename Out>
+Out move_range(Iter first, Iter last, Out out)
+{
+    for (; first != last; ++first, ++out) *out = mystl::move(*first);
+    return out;
+}
+
+// 稳定的二路归并（相等时先取第一段），结果移动到 out
+template <typename Iter1, typename Iter2, typename Out, typename Compare>
+Out move_merge(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, Out out, Compare& comp)
+{
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) *out = mystl::move(*first2++);
+        else *out = mystl::move(*first1++);
+        ++out;
+    }
+    out = detail::move_range(first1, last1, out);
+    return detail::move_range(first2, last2, out);
+}
+
+// co-rank：归并结果的前 k 个元素中有多少个来自 a，
+// 即找 i (j = k - i) 使 a[i - 1] <= b[j] 且 b[j - 1] < a[i]，与 move_merge 的稳定性约定一致
+template <typename Iter1, typename Iter2, typename Compare>
+std::ptrdiff_t co_rank(std::ptrdiff_t k, Iter1 a, std::ptrdiff_t n1, Iter2 b, std::ptrdiff_t n2, Compare& comp)
+{
+    std::ptrdiff_t lo = k > n2 ? k - n2 : 0;
+    std::ptrdiff_t hi = k < n1 ? k : n1;
+    while (lo < hi) {
+        std::ptrdiff_t i = lo + (hi - lo) / 2;
+        std::ptrdiff_t j = k - i;
+        // b[j - 1] >= a[i]：a[i] 也应排在前 k 个里
+        if (j > 0 && !comp(*(b + (j - 1)), *(a + i))) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+// 把输出按 grain 切块，每块用 co_rank 定位两段输入的起止位置后独立归并
+template <typename Iter1, typename Iter2, typename Out, typename Compare>
+void parallel_move_merge(thread_pool& pool, Iter1 a, std::ptrdiff_t n1, Iter2 b, std::ptrdiff_t n2,
+                         Out out, std::ptrdiff_t grain, Compare& comp)
+{
+    const std::ptrdiff_t n = n1 + n2;
+    if (n <= grain) {
+        detail::move_merge(a, a + n1, b, b + n2, out, comp);
+        return;
+    }
+    task_group group(pool);
+    for (std::ptrdiff_t k0 = 0; k0 < n; k0 += grain) {
+        group.run([=, &comp] {
+            std::ptrdiff_t k1 = k0 + grain < n ? k0 + grain : n;
+            std::ptrdiff_t i0 = detail::co_rank(k0, a, n1, b, n2, comp);
+            std::ptrdiff_t i1 = detail::co_rank(k1, a, n1, b, n2, comp);
+            detail::move_merge(a + i0, a + i1, b + (k0 - i0), b + (k1 - i1), out + k0, comp);
+        });
+    }
+    group.wait();
+}
+
+// 排序 a[0, n)，into_buf 为 true 时结果放到 b[0, n)，否则留在 a 中。
+// 两个子区间的结果放在与本层相反的位置，归并时正好写回目标位置，无需额外拷贝
+template <typename Iter, typename Buf, typename Compare>
+void parallel_sort_impl(thread_pool& pool, Iter a, Buf b, std::ptrdiff_t n, bool into_buf,
+                        std::ptrdiff_t cutoff, Compare& comp)
+{
+    if (n <= cutoff) {
+        mystl::sort(a, a + n, comp);
+        if (into_buf) detail::move_range(a, a + n, b);
+        return;
+    }
+
+    const std::ptrdiff_t mid = n / 2;
+    {
+        task_group group(pool);
+        group.run([&] { detail::parallel_sort_impl(pool, a, b, mid, !into_buf, cutoff, comp); });
+        detail::parallel_sort_impl(pool, a + mid, b + mid, n - mid, !into_buf, cutoff, comp);
+        group.wait();
+    }
+
+    if (into_buf) detail::parallel_move_merge(pool, a, mid, a + mid, n - mid, b, cutoff, comp);
+    else detail::parallel_move_merge(pool, b, mid, b + mid, n - mid, a, cutoff, comp);
+}
+
+} // namespace detail
+
+// 并行归并排序：递归二分，叶子用串行 sort，两半按 co-rank 切块并行归并
+// 线程数由 pool 决定；cutoff 以下的区间不再拆分。不稳定
+// 需要与输入等长的临时缓冲区，元素需可默认构造和移动赋值；comp 会被多个线程同时调用
+template <typename Iter, typename Compare = std::less<>>
+void parallel_sort(thread_pool& pool, Iter first, Iter last, Compare comp = {},
+                   std::ptrdiff_t cutoff = detail::k_parallel_sort_cutoff)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    const std::ptrdiff_t n = last - first;
+    if (cutoff < detail::k_insertion_sort_threshold) cutoff = detail::k_insertion_sort_threshold;
+    if (pool.size() == 1 || n <= cutoff) {
+        mystl::sort(first, last, comp);
+        return;
+    }
+    std::unique_ptr<value_type[]> buf(new value_type[n]);
+    detail::parallel_sort_impl(pool, first, buf.get(), n, false, cutoff, comp);
+}
+
+// 使用默认线程池（硬件线程数）
+template <typename Iter, typename Compare = std::less<>>
+void parallel_sort(Iter first, Iter last, Compare comp = {})
+{
+    mystl::parallel_sort(thread_pool::default_pool(), first, last, comp);
+}
+
+// ---- 稳定排序 (TimSort) ----
+namespace detail
+{
+// 短于该长度的区间只做一次二分插入排序
+constexpr std::ptrdiff_t k_timsort_min_merge = 32;
+// 一方连续胜出该次数后进入 galloping 模式
+constexpr std::ptrdiff_t k_timsort_min_gallop = 7;
+
+// 归并用的临时缓冲区，通过 Alloc 申请未初始化的空间，按需增长
+template <typename Tp, typename Alloc>
+class merge_buffer
+{
+public:
+    using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
+    using alloc_traits   = std::allocator_traits<allocator_type>;
+
+    explicit merge_buffer(const Alloc& alloc) : allocator_(alloc) {}
+
+    merge_buffer(const merge_buffer&) = delete;
+    merge_buffer& operator=(const merge_buffer&) = delete;
+
+    ~merge_buffer()
+    {
+        clear();
+        if (data_) alloc_traits::deallocate(allocator_, data_, capacity_);
+    }
+
+    // 把 [first, first + n) 移动构造到缓冲区开头
+    template <typename Iter>
+    Tp* move_in(Iter first, std::ptrdiff_t n)
+    {
+        reserve(static_cast<std::size_t>(n));
+        for (std::ptrdiff_t i = 0; i < n; ++i, ++first)
+            alloc_traits::construct(allocator_, data_ + i, mystl::move(*first));
+        constructed_ = static_cast<std::size_t>(n);
+        return data_;
+    }
+
+    // 销毁 move_in 构造的元素（此时它们都已被移走）
+    void clear()
+    {
+        for (std::size_t i = 0; i < constructed_; ++i)
+            alloc_traits::destroy(allocator_, data_ + i);
+        constructed_ = 0;
+    }
+
+private:
+    void reserve(std::size_t n)
+    {
+        if (n <= capacity_) return;
+        std::size_t new_cap = capacity_ * 2 > n ? capacity_ * 2 : n;
+        if (data_) alloc_traits::deallocate(allocator_, data_, capacity_);
+        data_ = nullptr;
+        capacity_ = 0;
+        data_ = alloc_traits::allocate(allocator_, new_cap);
+        capacity_ = new_cap;
+    }
+
+    allocator_type allocator_;
+    Tp* data_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t constructed_ = 0;
+};
+
+// 在有序的 a[0, len) 中找 key 的最左插入位置 k：a[k - 1] < key <= a[k]
+// 从 hint 开始按 1, 3, 7, 15... 指数跨步，再在最后一段内二分
+template <typename Tp, typename Iter, typename Compare>
+std::ptrdiff_t gallop_left(const Tp& key, Iter a, std::ptrdiff_t len, std::ptrdiff_t hint, Compare& comp)
+{
+    std::ptrdiff_t last_ofs = 0;
+    std::ptrdiff_t ofs = 1;
+    if (comp(*(a + hint), key)) {
+        // a[hint] < key：向右跨步，直到 a[hint + last_ofs] < key <= a[hint + ofs]
+        const std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && comp(*(a + (hint + ofs)), key)) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    } else {
+        // key <= a[hint]：向左跨步，直到 a[hint - ofs] < key <= a[hint - last_ofs]
+        const std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && !comp(*(a + (hint - ofs)), key)) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+    // 此时 a[last_ofs] < key <= a[ofs]，在 (last_ofs, ofs] 内二分
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t m = last_ofs + ((ofs - last_ofs) >> 1);
+        if (comp(*(a + m), key)) last_ofs = m + 1;
+        else ofs = m;
+    }
+    return ofs;
+}
+
+// 在有序的 a[0, len) 中找 key 的最右插入位置 k：a[k - 1] <= key < a[k]
+template <typename Tp, typename Iter, typename Compare>
+std::ptrdiff_t gallop_right(const Tp& key, Iter a, std::ptrdiff_t len, std::ptrdiff_t hint, Compare& comp)
+{
+    std::ptrdiff_t last_ofs = 0;
+    std::ptrdiff_t ofs = 1;
+    if (comp(key, *(a + hint))) {
+        // key < a[hint]：向左跨步，直到 a[hint - ofs] <= key < a[hint - last_ofs]
+        const std::ptrdiff_t max_ofs = hint + 1;
+        while (ofs < max_ofs && comp(key, *(a + (hint - ofs)))) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        std::ptrdiff_t tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    } else {
+        // a[hint] <= key：向右跨步，直到 a[hint + last_ofs] <= key < a[hint + ofs]
+        const std::ptrdiff_t max_ofs = len - hint;
+        while (ofs < max_ofs && !comp(key, *(a + (hint + ofs)))) {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+    ++last_ofs;
+    while (last_ofs < ofs) {
+        std::ptrdiff_t m = last_ofs + ((ofs - last_ofs) >> 1);
+        if (comp(key, *(a + m))) ofs = m;
+        else last_ofs = m + 1;
+    }
+    return ofs;
+}
+
+// TimSort：识别自然有序段 (run)，短 run 用二分插入排序补齐到 min_run，
+// 按栈不变式合并相邻 run，合并时一方连续胜出则切换到 galloping 模式
+// 所有下标都相对 base_，避免构造越界迭代器
+template <typename Iter, typename Compare, typename Alloc>
+class timsort
+{
+public:
+    using value_type = std::decay_t<decltype(*std::declval<Iter>())>;
+
+    timsort(Iter base, Compare& comp, const Alloc& alloc) : base_(base), comp_(comp), buffer_(alloc) {}
+
+    void sort(std::ptrdiff_t lo, std::ptrdiff_t hi)
+    {
+        std::ptrdiff_t remaining = hi - lo;
+        if (remaining < 2) return;
+
+        if (remaining < k_timsort_min_merge) {
+            std::ptrdiff_t run_len = count_run_and_make_ascending(lo, hi);
+            binary_sort(lo, hi, lo + run_len);
+            return;
+        }
+
+        const std::ptrdiff_t min_run = min_run_length(remaining);
+        do {
+            std::ptrdiff_t run_len = count_run_and_make_ascending(lo, hi);
+            if (run_len < min_run) {
+                std::ptrdiff_t force = remaining < min_run ? remaining : min_run;
+                binary_sort(lo, lo + force, lo + run_len);
+                run_len = force;
+            }
+            push_run(lo, run_len);
+            merge_collapse();
+            lo += run_len;
+            remaining -= run_len;
+        } while (remaining != 0);
+
+        merge_force_collapse();
+    }
+
+private:
+    value_type& at(std::ptrdiff_t i) { return *(base_ + i); }
+
+    // 取 n 的高 6 位，低位有 1 则加一，使 n / min_run 接近 2 的幂
+    static std::ptrdiff_t min_run_length(std::ptrdiff_t n)
+    {
+        std::ptrdiff_t r = 0;
+        while (n >= k_timsort_min_merge) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // 返回从 lo 开始的 run 长度；严格递减的 run 原地翻转（严格才能保持稳定）
+    std::ptrdiff_t count_run_and_make_ascending(std::ptrdiff_t lo, std::ptrdiff_t hi)
+    {
+        std::ptrdiff_t run_hi = lo + 1;
+        if (run_hi == hi) return 1;
+
+        if (comp_(at(run_hi++), at(lo))) {
+            while (run_hi < hi && comp_(at(run_hi), at(run_hi - 1))) ++run_hi;
+            for (std::ptrdiff_t i = lo, j = run_hi - 1; i < j; ++i, --j)
+                mystl::swap(at(i), at(j));
+        } else {
+            while (run_hi < hi && !comp_(at(run_hi), at(run_hi - 1))) ++run_hi;
+        }
+        return run_hi - lo;
+    }
+
+    // [lo, start) 已有序，把 [start, hi) 逐个二分插入
+    void binary_sort(std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t start)
+    {
+        if (start == lo) ++start;
+        for (; start < hi; ++start) {
+            value_type pivot = mystl::move(at(start));
+            std::ptrdiff_t left = lo;
+            std::ptrdiff_t right = start;
+            while (left < right) {
+                std::ptrdiff_t mid = left + ((right - left) >> 1);
+                if (comp_(pivot, at(mid))) right = mid;
+                else left = mid + 1;
+            }
+            for (std::ptrdiff_t i = start; i > left; --i)
+                at(i) = mystl::move(at(i - 1));
+            at(left) = mystl::move(pivot);
+        }
+    }
+
+    void push_run(std::ptrdiff_t base, std::ptrdiff_t len)
+    {
+        run_base_[stack_size_] = base;
+        run_len_[stack_size_] = len;
+        ++stack_size_;
+    }
+
+    // 维持栈不变式 len[i-2] > len[i-1] + len[i] 且 len[i-1] > len[i]
+    // （同时检查 i-3 处，修复了原始 TimSort 不变式可能被破坏的问题）
+    void merge_collapse()
+    {
+        while (stack_size_ > 1) {
+            std::ptrdiff_t n = stack_size_ - 2;
+            if ((n > 0 && run_len_[n - 1] <= run_len_[n] + run_len_[n + 1])
+                || (n > 1 && run_len_[n - 2] <= run_len_[n - 1] + run_len_[n])) {
+                if (run_len_[n - 1] < run_len_[n + 1]) --n;
+            } else if (run_len_[n] > run_len_[n + 1]) {
+                break;
+            }
+            merge_at(n);
+        }
+    }
+
+    void merge_force_collapse()
+    {
+        while (stack_size_ > 1) {
+            std::ptrdiff_t n = stack_size_ - 2;
+            if (n > 0 && run_len_[n - 1] < run_len_[n + 1]) --n;
+            merge_at(n);
+        }
+    }
+
+    // 合并栈中第 i 和 i + 1 个 run
+    void merge_at(std::ptrdiff_t i)
+    {
+        std::ptrdiff_t base1 = run_base_[i];
+        std::ptrdiff_t len1 = run_len_[i];
+        std::ptrdiff_t base2 = run_base_[i + 1];
+        std::ptrdiff_t len2 = run_len_[i + 1];
+
+        run_len_[i] = len1 + len2;
+        if (i == stack_size_ - 3) {
+            run_base_[i + 1] = run_base_[i + 2];
+            run_len_[i + 1] = run_len_[i + 2];
+        }
+        --stack_size_;
+
+        // run1 中不大于 run2 首元素的前缀已经就位
+        std::ptrdiff_t k = detail::gallop_right(at(base2), base_ + base1, len1, 0, comp_);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+
+        // run2 中不小于 run1 末元素的后缀也已经就位
+        len2 = detail::gallop_left(at(base1 + len1 - 1), base_ + base2, len2, len2 - 1, comp_);
+        if (len2 == 0) return;
+
+        // 把较短的一段移入缓冲区
+        if (len1 <= len2) merge_lo(base1, len1, base2, len2);
+        else merge_hi(base1, len1, base2, len2);
+        buffer_.clear();
+    }
+
+    // 从前往后合并，run1 较短并移入缓冲区
+    void merge_lo(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2)
+    {
+        value_type* tmp = buffer_.move_in(base_ + base1, len1);
+        std::ptrdiff_t cursor1 = 0;     // tmp 中的下标
+        std::ptrdiff_t cursor2 = base2; // 相对 base_
+        std::ptrdiff_t dest = base1;
+
+        at(dest++) = mystl::move(at(cursor2++));
+        if (--len2 == 0) {
+            move_out(tmp + cursor1, len1, dest);
+            return;
+        }
+        if (len1 == 1) {
+            move_within(cursor2, len2, dest);
+            at(dest + len2) = mystl::move(tmp[cursor1]);
+            return;
+        }
+
+        std::ptrdiff_t min_gallop = min_gallop_;
+        while (true) {
+            std::ptrdiff_t count1 = 0; // run1 连续胜出次数
+            std::ptrdiff_t count2 = 0; // run2 连续胜出次数
+
+            // 普通逐个比较模式
+            do {
+                if (comp_(at(cursor2), tmp[cursor1])) {
+                    at(dest++) = mystl::move(at(cursor2++));
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 0) goto done;
+                } else {
+                    at(dest++) = mystl::move(tmp[cursor1++]);
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 1) goto done;
+                }
+            } while ((count1 | count2) < min_gallop);
+
+            // galloping 模式：直接找出一方能连续输出多少个
+            do {
+                count1 = detail::gallop_right(at(cursor2), tmp + cursor1, len1, 0, comp_);
+                if (count1 != 0) {
+                    move_out(tmp + cursor1, count1, dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) goto done;
+                }
+                at(dest++) = mystl::move(at(cursor2++));
+                if (--len2 == 0) goto done;
+
+                count2 = detail::gallop_left(tmp[cursor1], base_ + cursor2, len2, 0, comp_);
+                if (count2 != 0) {
+                    move_within(cursor2, count2, dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) goto done;
+                }
+                at(dest++) = mystl::move(tmp[cursor1++]);
+                if (--len1 == 1) goto done;
+                --min_gallop;
+            } while (count1 >= k_timsort_min_gallop || count2 >= k_timsort_min_gallop);
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2; // 离开 galloping 模式的惩罚
+        }
+
+    done:
+        min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+        if (len1 == 1) {
+            move_within(cursor2, len2, dest);
+            at(dest + len2) = mystl::move(tmp[cursor1]);
+        } else if (len1 > 1) {
+            move_out(tmp + cursor1, len1, dest);
+        }
+        // len1 == 0 只会在 comp 不满足严格弱序时出现，此时不再移动
+    }
+
+    // 从后往前合并，run2 较短并移入缓冲区
+    void merge_hi(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2)
+    {
+        value_type* tmp = buffer_.move_in(base_ + base2, len2);
+        std::ptrdiff_t cursor1 = base1 + len1 - 1; // 相对 base_
+        std::ptrdiff_t cursor2 = len2 - 1;         // tmp 中的下标
+        std::ptrdiff_t dest = base2 + len2 - 1;
+
+        at(dest--) = mystl::move(at(cursor1--));
+        if (--len1 == 0) {
+            move_out(tmp, len2, dest - (len2 - 1));
+            return;
+        }
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            move_within_backward(cursor1 + 1, len1, dest + 1);
+            at(dest) = mystl::move(tmp[cursor2]);
+            return;
+        }
+
+        std::ptrdiff_t min_gallop = min_gallop_;
+        while (true) {
+            std::ptrdiff_t count1 = 0;
+            std::ptrdiff_t count2 = 0;
+
+            do {
+                if (comp_(tmp[cursor2], at(cursor1))) {
+                    at(dest--) = mystl::move(at(cursor1--));
+                    ++count1;
+                    count2 = 0;
+                    if (--len1 == 0) goto done;
+                } else {
+                    at(dest--) = mystl::move(tmp[cursor2--]);
+                    ++count2;
+                    count1 = 0;
+                    if (--len2 == 1) goto done;
+                }
+            } while ((count1 | count2) < min_gallop);
+
+            do {
+                count1 = len1 - detail::gallop_right(tmp[cursor2], base_ + base1, len1, len1 - 1, comp_);
+                if (count1 != 0) {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    move_within_backward(cursor1 + 1, count1, dest + 1);
+                    if (len1 == 0) goto done;
+                }
+                at(dest--) = mystl::move(tmp[cursor2--]);
+                if (--len2 == 1) goto done;
+
+                count2 = len2 - detail::gallop_left(at(cursor1), tmp, len2, len2 - 1, comp_);
+                if (count2 != 0) {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    move_out(tmp + (cursor2 + 1), count2, dest + 1);
+                    if (len2 <= 1) goto done;
+                }
+                at(dest--) = mystl::move(at(cursor1--));
+                if (--len1 == 0) goto done;
+                --min_gallop;
+            } while (count1 >= k_timsort_min_gallop || count2 >= k_timsort_min_gallop);
+
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;
+        }
+
+    done:
+        min_gallop_ = min_gallop < 1 ? 1 : min_gallop;
+        if (len2 == 1) {
+            dest -= len1;
+            cursor1 -= len1;
+            move_within_backward(cursor1 + 1, len1, dest + 1);
+            at(dest) = mystl::move(tmp[cursor2]);
+        } else if (len2 > 1) {
+            move_out(tmp, len2, dest - (len2 - 1));
+        }
+    }
+
+    // 缓冲区 src[0, n) -> base_[dest, dest + n)
+    void move_out(value_type* src, std::ptrdiff_t n, std::ptrdiff_t dest)
+    {
+        for (std::ptrdiff_t i = 0; i < n; ++i) at(dest + i) = mystl::move(src[i]);
+    }
+
+    // base_[src, src + n) -> base_[dest, dest + n)，dest <= src，从前往后搬
+    void move_within(std::ptrdiff_t src, std::ptrdiff_t n, std::ptrdiff_t dest)
+    {
+        for (std::ptrdiff_t i = 0; i < n; ++i) at(dest + i) = mystl::move(at(src + i));
+    }
+
+    // base_[src, src + n) -> base_[dest, dest + n)，dest >= src，从后往前搬
+    void move_within_backward(std::ptrdiff_t src, std::ptrdiff_t n, std::ptrdiff_t dest)
+    {
+        for (std::ptrdiff_t i = n; i > 0; --i) at(dest + i - 1) = mystl::move(at(src + i - 1));
+    }
+
+private:
+    Iter base_;
+    Compare& comp_;
+    merge_buffer<value_type, Alloc> buffer_;
+    std::ptrdiff_t min_gallop_ = k_timsort_min_gallop;
+
+    // run 长度至少按斐波那契速度增长，85 层足以覆盖 64 位长度
+    std::ptrdiff_t run_base_[85];
+    std::ptrdiff_t run_len_[85];
+    std::ptrdiff_t stack_size_ = 0;
+};
+
+} // namespace detail
+
+// 稳定排序 (TimSort)：相等元素保持原有顺序
+// 基本有序的输入接近 O(n)，最坏 O(n log n)；临时缓冲区最多为 n / 2 个元素，通过 alloc 申请，
+// 可传入容器的 get_allocator() 让缓冲区与容器使用同一个分配器
+template <typename Iter, typename Compare, typename Alloc>
+void stable_sort(Iter first, Iter last, Compare comp, const Alloc& alloc)
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::stable_sort requires random access iterators");
+    detail::timsort<Iter, Compare, Alloc> sorter(first, comp, alloc);
+    sorter.sort(0, mystl::distance(first, last));
+}
+
+template <typename Iter, typename Compare = std::less<>>
+void stable_sort(Iter first, Iter last, Compare comp = {})
+{
+    mystl::stable_sort(first, last, comp, std::allocator<iter_value_t<Iter>>());
+}
+
+// ---- 块划分 (block partition) ----
+namespace detail
+{
+constexpr std::size_t k_partition_block_size = 64;
+constexpr std::size_t k_cacheline_size = 64;
+
+// 批量交换左侧 offsets_l 与右侧 offsets_r 记录的错位元素。
+// 两侧数量相等时逐对交换；否则用一次循环移位，每个元素只移动一次
+template <typename Iter>
+void swap_offsets(Iter first, Iter last, const unsigned char* offsets_l, const unsigned char* offsets_r,
+                  std::size_t num, bool use_swaps)
+{
+    using value_type = std::decay_t<decltype(*first)>;
+    if (use_swaps) {
+        for (std::size_t i = 0; i < num; ++i)
+            detail::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+    } else if (num > 0) {
+        Iter l = first + offsets_l[0];
+        Iter r = last - offsets_r[0];
+        value_type tmp(mystl::move(*l));
+        *l = mystl::move(*r);
+        for (std::size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = mystl::move(*l);
+            r = last - offsets_r[i];
+            *l = mystl::move(*r);
+        }
+        *r = mystl::move(tmp);
+    }
+}
+
+// 无分支块划分：满足 pred 的元素移到前面，返回分界点。
+// 左右两端各扫描一块（64 个元素），只把比较结果累加到偏移量缓冲区里（num += pred(x)），
+// 扫描循环没有依赖数据的分支；之后再按偏移量成批交换错位的元素
+template <typename Iter, typename Pred>
+Iter block_partition(Iter first, Iter last, Pred& pred)
+{
+    alignas(k_cacheline_size) unsigned char offsets_l_storage[k_partition_block_size];
+    alignas(k_cacheline_size) unsigned char offsets_r_storage[k_partition_block_size];
+    unsigned char* offsets_l = offsets_l_storage;
+    unsigned char* offsets_r = offsets_r_storage;
+
+    Iter offsets_l_base = first;
+    Iter offsets_r_base = last;
+    std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (first < last) {
+        // 某一侧的错位元素用完了才扫描该侧的下一块；剩余不足两块时按需切分
+        std::size_t num_unknown = last - first;
+        std::size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+        std::size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+        if (left_split >= k_partition_block_size) {
+            for (std::size_t i = 0; i < k_partition_block_size;) {
+                offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !pred(*first); ++first;
+                offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !pred(*first); ++first;
+                offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !pred(*first); ++first;
+                offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !pred(*first); ++first;
+            }
+        } else {
+            for (std::size_t i = 0; i < left_split;) {
+                offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !pred(*first); ++first;
+            }
+        }
+
+        if (right_split >= k_partition_block_size) {
+            for (std::size_t i = 0; i < k_partition_block_size;) {
+                offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += pred(*--last);
+                offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += pred(*--last);
+                offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += pred(*--last);
+                offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += pred(*--last);
+            }
+        } else {
+            for (std::size_t i = 0; i < right_split;) {
+                offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += pred(*--last);
+            }
+        }
+
+        std::size_t num = num_l < num_r ? num_l : num_r;
+        detail::swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                             num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+            start_l = 0;
+            offsets_l_base = first;
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            offsets_r_base = last;
+        }
+    }
+
+    // 至多一侧还有未配对的错位元素，把它们换到分界点的另一侧
+    if (num_l) {
+        offsets_l += start_l;
+        while (num_l--) detail::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+        first = last;
+    }
+    if (num_r) {
+        offsets_r += start_r;
+        while (num_r--) {
+            detail::iter_swap(offsets_r_base - offsets_r[num_r], first);
+            ++first;
+        }
+    }
+    return first;
+}
+
+} // namespace detail
+
+// 划分：满足 pred 的元素移到前面，返回第一个不满足 pred 的位置。不稳定
+// 随机访问迭代器使用无分支块划分，前向迭代器逐个交换
+template <typename Iter, typename Pred>
+Iter partition(Iter first, Iter last, Pred pred)
+{
+    static_assert(is_forward_iterator<Iter>::value, "mystl::partition requires forward iterators");
+    if constexpr (is_random_access_iterator<Iter>::value) {
+        return detail::block_partition(first, last, pred);
+    } else {
+        while (first != last && pred(*first)) ++first;
+        if (first == last) return first;
+        for (Iter it = mystl::next(first); it != last; ++it) {
+            if (pred(*it)) {
+                detail::iter_swap(first, it);
+                ++first;
+            }
+        }
+        return first;
+    }
+}
+
+// ---- 模式消除快速排序 (pdqsort) ----
+namespace detail
+{
+constexpr std::ptrdiff_t k_pdq_insertion_sort_threshold = 24;
+// partial_insertion_sort 最多移动的元素个数，超过就放弃
+constexpr std::ptrdiff_t k_pdq_partial_insertion_sort_limit = 8;
+
+// 比较器是内置的大小比较且元素是算术类型时，比较本身很便宜，适合无分支划分
+template <typename Compare, typename Tp>
+struct is_branchless_sortable
+    : std::integral_constant<bool, std::is_arithmetic<Tp>::value && (
+          std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<Tp>>::value
+          || std::is_same<Compare, std::greater<>>::value || std::is_same<Compare, std::greater<Tp>>::value)>
+{};
+
+template <typename Iter, typename Compare>
+void sort2(Iter a, Iter b, Compare& comp)
+{
+    if (comp(*b, *a)) detail::iter_swap(a, b);
+}
+
+template <typename Iter, typename Compare>
+void sort3(Iter a, Iter b, Iter c, Compare& comp)
+{
+    detail::sort2(a, b, comp);
+    detail::sort2(b, c, comp);
+    detail::sort2(a, b, comp);
+}
+
+// 插入排序，但移动次数超过上限就放弃并返回 false。用于检测 "几乎有序" 的区间
+template <typename Iter, typename Compare>
+bool partial_insertion_sort(Iter begin, Iter end, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*begin)>;
+    if (begin == end) return true;
+
+    std::ptrdiff_t limit = 0;
+    for (Iter cur = begin + 1; cur != end; ++cur) {
+        Iter sift = cur;
+        Iter sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            value_type tmp = mystl::move(*sift);
+            do {
+                *sift = mystl::move(*sift_1);
+                --sift;
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = mystl::move(tmp);
+            limit += cur - sift;
+        }
+        if (limit > k_pdq_partial_insertion_sort_limit) return false;
+    }
+    return true;
+}
+
+// 以 *begin 为枢轴划分，< 枢轴的在左，>= 枢轴的在右，返回枢轴最终位置以及区间是否本来就已划分好。
+// 调用前保证 [begin + 1, end) 中存在 >= 枢轴的元素（三数取中的结果），第一次扫描不需要边界检查
+template <bool Branchless, typename Iter, typename Compare>
+std::pair<Iter, bool> pdq_partition_right(Iter begin, Iter end, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*begin)>;
+    value_type pivot(mystl::move(*begin));
+    Iter first = begin;
+    Iter last = end;
+
+    // 找到左侧第一个 >= 枢轴、右侧第一个 < 枢轴的元素
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    // 两个指针一开始就交错，说明没有任何元素需要交换
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        detail::iter_swap(first, last);
+        ++first;
+        if (Branchless) {
+            auto less_than_pivot = [&](const value_type& x) { return comp(x, pivot); };
+            first = detail::block_partition(first, last, less_than_pivot);
+        } else {
+            while (true) {
+                while (comp(*first, pivot)) ++first;
+                while (!comp(*--last, pivot)) {}
+                if (!(first < last)) break;
+                detail::iter_swap(first, last);
+                ++first;
+            }
+        }
+    }
+
+    Iter pivot_pos = first - 1;
+    *begin = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return std::pair<Iter, bool>(pivot_pos, already_partitioned);
+}
+
+// 与 pdq_partition_right 相反：<= 枢轴的放左边。
+// 当枢轴等于左侧相邻区间的最大值时使用，一次把所有等于枢轴的元素排除掉，重复值多时退化为线性
+template <typename Iter, typename Compare>
+Iter pdq_partition_left(Iter begin, Iter end, Compare& comp)
+{
+    using value_type = std::decay_t<decltype(*begin)>;
+    value_type pivot(mystl::move(*begin));
+    Iter first = begin;
+    Iter last = end;
+
+    while (comp(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {}
+    } else {
+        while (!comp(pivot, *++first)) {}
+    }
+
+    while (first < last) {
+        detail::iter_swap(first, last);
+        while (comp(pivot, *--last)) {}
+        while (!comp(pivot, *++first)) {}
+    }
+
+    Iter pivot_pos = last;
+    *begin = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pivot_pos;
+}
+
+// leftmost 为 false 时 *(begin - 1) 不大于区间内任何元素，可作为哨兵
+template <bool Branchless, typename Iter, typename Compare>
+void pdq_sort_loop(Iter begin, Iter end, Compare& comp, int bad_allowed, bool leftmost = true)
+{
+    while (true) {
+        const std::ptrdiff_t size = end - begin;
+
+        if constexpr (detail::is_simd_sortable<Iter, Compare>::value) {
+            if (size <= detail::sort_leaf_threshold<Iter, Compare>(0) && detail::simd_small_sort(begin, end, comp))
+                return;
+        }
+        if (size < k_pdq_insertion_sort_threshold) {
+            if (leftmost) detail::insertion_sort(begin, end, comp);
+            else detail::unguarded_insertion_sort(begin, end, comp);
+            return;
+        }
+
+        // 三数取中或 ninther，枢轴放到 *begin
+        const std::ptrdiff_t s2 = size / 2;
+        if (size > k_ninther_threshold) {
+            detail::sort3(begin, begin + s2, end - 1, comp);
+            detail::sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            detail::sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            detail::sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            detail::iter_swap(begin, begin + s2);
+        } else {
+            detail::sort3(begin + s2, begin, end - 1, comp);
+        }
+
+        // 枢轴等于左边区间的最大值：等于枢轴的元素都已就位，只需继续处理 > 枢轴的部分
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = detail::pdq_partition_left(begin, end, comp) + 1;
+            continue;
+        }
+
+        std::pair<Iter, bool> part = detail::pdq_partition_right<Branchless>(begin, end, comp);
+        Iter pivot_pos = part.first;
+        const bool already_partitioned = part.second;
+
+        const std::ptrdiff_t l_size = pivot_pos - begin;
+        const std::ptrdiff_t r_size = end - (pivot_pos + 1);
+        const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            // 坏划分次数用完，转堆排序保证 O(n log n)
+            if (--bad_allowed == 0) {
+                detail::heap_sort(begin, end, comp);
+                return;
+            }
+
+            // 交换几个固定位置上的元素，打破可能导致坏划分的输入模式
+            if (l_size >= k_pdq_insertion_sort_threshold) {
+                detail::iter_swap(begin, begin + l_size / 4);
+                detail::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                if (l_size > k_ninther_threshold) {
+                    detail::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                    detail::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                    detail::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    detail::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+            if (r_size >= k_pdq_insertion_sort_threshold) {
+                detail::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                detail::iter_swap(end - 1, end - r_size / 4);
+                if (r_size > k_ninther_threshold) {
+                    detail::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    detail::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    detail::iter_swap(end - 2, end - (1 + r_size / 4));
+                    detail::iter_swap(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        } else if (already_partitioned
+                   && detail::partial_insertion_sort(begin, pivot_pos, comp)
+                   && detail::partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            // 划分时没有发生交换，且两侧用少量插入就排好了：整体已有序
+            return;
+        }
+
+        // 递归左侧，右侧留在循环中
+        detail::pdq_sort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+} // namespace detail
+
+// 模式消除快速排序 (pattern-defeating quicksort)
+// 有序 / 逆序 / 重复值多的输入接近 O(n)，对抗性输入靠打乱和堆排序兜底保证 O(n log n)。不稳定
+// 算术类型配合 std::less / std::greater 时使用无分支块划分
+template <typename Iter, typename Compare = std::less<>>
+void pdq_sort(Iter first, Iter last, Compare comp = {})
+{
+    static_assert(is_random_access_iterator<Iter>::value, "mystl::pdq_sort requires random access iterators");
+    using value_type = iter_value_t<Iter>;
+    const iter_difference_t<Iter> n = mystl::distance(first, last);
+    if (n < 2) return;
+    detail::pdq_sort_loop<detail::is_branchless_sortable<Compare, value_type>::value>(
+        first, last, comp, detail::log2_floor(n));
+}
+
 } // namespace mystl
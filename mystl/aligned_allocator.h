@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "type_traits.h"
+
+namespace mystl
+{
+
+// 按 Align 字节对齐的分配器，用于 SIMD 数据 (AVX2 为 32，AVX-512 / 缓存行为 64)。
+// 申请的字节数向上取整到 Align 的倍数；声明了 alignment 成员，mystl::vector 据此把容量取整到
+// Align / sizeof(Tp) 个元素（一个 SIMD 宽度）的倍数，末尾不足一个宽度的部分也可以整块读写
+template <typename Tp, std::size_t Align = 64>
+class aligned_allocator
+{
+    static_assert(Align >= alignof(Tp) && (Align & (Align - 1)) == 0, "Align must be a power of two not less than alignof(Tp)");
+
+public:
+    using value_type = Tp;
+    using size_type  = std::size_t;
+
+    static constexpr std::size_t alignment = Align;
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, Align>; };
+
+    aligned_allocator() noexcept = default;
+    template <typename U>
+    aligned_allocator(const aligned_allocator<U, Align>&) noexcept {}
+
+    Tp* allocate(size_type n)
+    {
+        if (n == 0) return nullptr;
+        return static_cast<Tp*>(::operator new(round_up_bytes(n), std::align_val_t(Align)));
+    }
+
+    void deallocate(Tp* p, size_type n) noexcept
+    {
+        if (p) ::operator delete(p, round_up_bytes(n), std::align_val_t(Align));
+    }
+
+    template <typename U>
+    friend bool operator==(const aligned_allocator&, const aligned_allocator<U, Align>&) noexcept { return true; }
+    template <typename U>
+    friend bool operator!=(const aligned_allocator&, const aligned_allocator<U, Align>&) noexcept { return false; }
+
+private:
+    static size_type round_up_bytes(size_type n) { return (n * sizeof(Tp) + Align - 1) / Align * Align; }
+};
+
+// 元素个数 n 向上取整到 Align 字节的倍数后的个数，要求 Align 是 sizeof(Tp) 的整数倍
+template <typename Tp, std::size_t Align>
+constexpr std::size_t padded_count(std::size_t n)
+{
+    static_assert(Align % sizeof(Tp) == 0, "padded_count requires Align to be a multiple of sizeof(Tp)");
+    constexpr std::size_t lanes = Align / sizeof(Tp);
+    return (n + lanes - 1) / lanes * lanes;
+}
+
+// 把 [size(), padded_count(size())) 的填充区写成 value（一般为 0），SIMD 循环随后可以按整块处理尾部。
+// 要求容器的容量已按 Align 取整（使用 aligned_allocator 的 mystl::vector 满足），填充区的元素可平凡构造
+template <std::size_t Align, typename Vec>
+void fill_padding(Vec& v, const typename Vec::value_type& value = typename Vec::value_type())
+{
+    using value_type = typename Vec::value_type;
+    static_assert(std::is_trivially_copyable<value_type>::value, "fill_padding requires a trivially copyable element type");
+    value_type* p = v.data();
+    for (std::size_t i = v.size(), e = padded_count<value_type, Align>(v.size()); i < e; ++i) p[i] = value;
+}
+
+} // namespace mystl
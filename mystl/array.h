@@ -4,13 +4,20 @@
 #include <stdexcept>
 
 #include "algorithm/algobase.h"
+#include "type_traits.h"
 
 namespace mystl
 {
 
-template <typename Tp, std::size_t N>
+// Align 为数据的对齐字节数，默认即 Tp 自身的对齐。Align 大于 alignof(Tp) 且是 sizeof(Tp) 的整数倍时
+// (如 array<float, 100, 32>)，存储区额外补齐到 Align 字节的倍数：padded_size 个元素，
+// SIMD 循环可以整块处理尾部。聚合初始化 array<float, 5, 32> a = {...} 时填充区为 0；
+// size() / begin() / end() / fill / swap 都只涉及前 N 个元素
+template <typename Tp, std::size_t N, std::size_t Align = alignof(Tp)>
 struct array
 {
+    static_assert(Align >= alignof(Tp) && (Align & (Align - 1)) == 0, "Align must be a power of two not less than alignof(Tp)");
+
 public:
     using value_type      = Tp;
     using size_type       = size_t;
@@ -22,7 +29,10 @@ public:
     using iterator        = pointer;
     using const_iterator  = const_pointer;
 
-    value_type elems_[N];
+    static constexpr size_type padded_size =
+        Align > alignof(Tp) && Align % sizeof(Tp) == 0 ? (N * sizeof(Tp) + Align - 1) / Align * Align / sizeof(Tp) : N;
+
+    alignas(Align) value_type elems_[padded_size];
 
     // ========== 容量 ==========
     constexpr size_type size() const noexcept { return N; };
@@ -43,6 +53,9 @@ public:
         else throw std::out_of_range("mystl::array out of range.");
     }
 
+    pointer data() noexcept { return elems_; }
+    const_pointer data() const noexcept { return elems_; }
+
     iterator begin() noexcept { return elems_; }
     const_iterator begin() const noexcept { return elems_; }
     iterator end() noexcept { return elems_ + N; }
@@ -60,4 +73,7 @@ public:
             mystl::swap(elems_[i], other.elems_[i]);
     } 
 };
+
+template <typename Tp, std::size_t N, std::size_t Align>
+struct is_trivially_relocatable<array<Tp, N, Align>> : is_trivially_relocatable<Tp> {};
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <iostream>
 #include <cstring>     // For std::strlen, std::memcpy, etc.
 #include <memory>
+#include <vector>
+#include "algorithm/search.h"
+#include "algorithm/simd_search.h"
+#include "memory_resource.h"
 #include "vector.h"
 
 namespace mystl
@@ -13,6 +17,15 @@ class basic_string;
 using string = basic_string<char>;
 using wstring = basic_string<wchar_t>;
 
+namespace pmr
+{
+template<typename CharT, typename Traits = std::char_traits<CharT>>
+using basic_string = mystl::basic_string<CharT, Traits, polymorphic_allocator<CharT>>;
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+} // namespace pmr
+
 template<typename CharT, typename Traits, typename Alloc>
 class basic_string
 {
@@ -97,11 +110,22 @@ private:
         }
     }
 
-    size_type kmp_search(const basic_string& patt, size_type pos)
+    // char + std::char_traits<char> 时字符相等就是字节相等，可以直接用 SIMD 按字节查找
+    static constexpr bool byte_search =
+        std::is_same<CharT, char>::value && std::is_same<Traits, std::char_traits<char>>::value;
+
+    // 带 pattern_size() 的搜索器可以直接判断模式是否为空，其余的按搜索器自己的结果
+    template <typename Searcher>
+    static auto empty_pattern(const Searcher& s, int) -> decltype(s.pattern_size() == 0) { return s.pattern_size() == 0; }
+    template <typename Searcher>
+    static bool empty_pattern(const Searcher&, long) { return false; }
+
+    // 其他字符类型用 KMP，1 <= m <= n
+    static size_type kmp_search(const_pointer str, size_type n, const_pointer patt, size_type m)
     {
-        std::vector<int> lps(patt.size(), 0);
-        for (size_type i = 1, len = 0; i < patt.size();) {
-            if (patt[i] == patt[len]) {
+        std::vector<size_type> lps(m, 0);
+        for (size_type i = 1, len = 0; i < m;) {
+            if (traits_type::eq(patt[i], patt[len])) {
                 lps[i++] = ++len;
             } else if (len != 0) {
                 len = lps[len - 1];
@@ -109,12 +133,12 @@ private:
                 lps[i++] = 0;
             }
         }
-        size_type i = pos;
+        size_type i = 0;
         size_type j = 0;
-        while (i < size_) {
-            if (data_[i] == patt[j]) { 
+        while (i < n) {
+            if (traits_type::eq(str[i], patt[j])) {
                 ++i; ++j;
-                if (j == patt.size()) return i - j;
+                if (j == m) return i - j;
             }
             else if (j > 0) { j = lps[j - 1]; }
             else { ++i; }
@@ -122,7 +146,40 @@ private:
         return npos;
     }
 
-    
+    // [pos, size_) 中 s[0, count) 第一次出现的位置
+    size_type search_forward(const_pointer s, size_type pos, size_type count) const
+    {
+        if (pos > size_ || count > size_ - pos) return npos;
+        if (count == 0) return pos;
+        const_pointer str = get_current_data();
+        size_type r;
+        if constexpr (byte_search) {
+            r = detail::simd_find(str + pos, size_ - pos, s, count);
+            if (r == detail::k_simd_npos) return npos;
+        } else {
+            r = kmp_search(str + pos, size_ - pos, s, count);
+            if (r == npos) return npos;
+        }
+        return pos + r;
+    }
+
+    // 起点不超过 pos 的最后一次出现
+    size_type search_backward(const_pointer s, size_type pos, size_type count) const
+    {
+        if (count > size_) return npos;
+        const size_type last = std::min(pos, size_ - count);  // 最后一个允许的起点
+        if (count == 0) return last;
+        const_pointer str = get_current_data();
+        if constexpr (byte_search) {
+            const size_type r = detail::simd_rfind(str, last + count, s, count);
+            return r == detail::k_simd_npos ? npos : r;
+        } else {
+            for (size_type i = last + 1; i-- > 0;) {
+                if (traits_type::compare(str + i, s, count) == 0) return i;
+            }
+            return npos;
+        }
+    }
 
 public:
     // ========== Constructors, Destructor, Assignment ==========
@@ -131,18 +188,29 @@ public:
         set_short_size(0);
     }
 
-    basic_string(const_pointer str, size_type len)
+    explicit basic_string(const allocator_type& alloc) : allocator_(alloc)
+    {
+        set_short_size(0);
+    }
+
+    basic_string(const_pointer str, size_type len, const allocator_type& alloc = allocator_type()) : allocator_(alloc)
     {
         construct_from_char_ptr(str, len);
     }
 
-    basic_string(const_pointer str)
+    basic_string(const_pointer str, const allocator_type& alloc = allocator_type()) : allocator_(alloc)
     {
         size_type len = traits_type::length(str);
         construct_from_char_ptr(str, len);
     }
 
     basic_string(const basic_string& other)
+        : allocator_(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.allocator_))
+    {
+        construct_from_char_ptr(other.get_current_data(), other.size_);
+    }
+
+    basic_string(const basic_string& other, const allocator_type& alloc) : allocator_(alloc)
     {
         construct_from_char_ptr(other.get_current_data(), other.size_);
     }
@@ -159,6 +227,24 @@ public:
         other.set_short_size(0);
     }
 
+    // 指定分配器的移动构造：分配器不相等时 (如来自不同的 pmr 资源) 不能接管对方的内存，只能拷贝
+    basic_string(basic_string&& other, const allocator_type& alloc) : allocator_(alloc)
+    {
+        if (other.is_short() || allocator_ == other.allocator_) {
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            if (other.is_short()) {
+                traits_type::copy(sso_buf_, other.sso_buf_, other.size_ + 1);
+            } else {
+                data_ = other.data_;
+                other.data_ = nullptr;
+            }
+            other.set_short_size(0);
+        } else {
+            construct_from_char_ptr(other.get_current_data(), other.size_);
+        }
+    }
+
     ~basic_string()
     {
         deallocate_long();
@@ -179,15 +265,28 @@ public:
         return *this;
     }
 
-    basic_string& operator=(basic_string&& other) noexcept
+    // 分配器不传播且可能不相等时 (如 pmr) 要拷贝内容，可能抛出 bad_alloc，与 vector 相同只在其余情况下 noexcept
+    basic_string& operator=(basic_string&& other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+                                                           std::allocator_traits<allocator_type>::is_always_equal::value)
     {
         if (this != &other)
         {
+            // 分配器不随移动赋值传播且与对方不相等时，对方的内存不能由本对象释放，只能拷贝内容
+            if constexpr (!std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                if (!other.is_short() && !(allocator_ == other.allocator_)) {
+                    clear();
+                    append(other.get_current_data(), other.size_);
+                    return *this;
+                }
+            }
+
             deallocate_long();
 
             size_ = other.size_;
             capacity_ = other.capacity_;
-            allocator_ = std::move(other.allocator_);
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                allocator_ = std::move(other.allocator_);
+            }
 
             if (other.is_short()) {
                 traits_type::copy(sso_buf_, other.sso_buf_, other.size_ + 1);
@@ -201,6 +300,8 @@ public:
         return *this;
     }
 
+    allocator_type get_allocator() const { return allocator_; }
+
     // ========== Iterators ==========
     iterator begin() noexcept { return get_current_data(); }
     const_iterator begin() const noexcept { return get_current_data(); }
@@ -241,7 +342,7 @@ public:
 
     void reserve(size_type new_cap)
     {
-        if (new_cap < capacity_) return;
+        if (new_cap <= capacity_) return;
 
         pointer new_data = allocator_.allocate(new_cap + 1);
         pointer old_data = get_current_data();
@@ -268,6 +369,25 @@ public:
         get_current_data()[size_] = value_type();
     }
 
+    // 与 resize 相同，但新增的字符不写入，由调用者随后直接写入 data()
+    void resize_for_overwrite(size_type new_size)
+    {
+        if (new_size > size_) smart_grow(new_size - size_);
+        size_ = new_size;
+        get_current_data()[size_] = value_type();
+    }
+
+    // 扩容到至少 n 个字符，调用 op(data(), n) 写入内容，op 返回最终长度 (不超过 n)，与 C++23 的 std 版本相同。
+    // 调用 op 时 [size(), n) 的内容不确定；op 抛出异常时长度不变
+    template <typename Op>
+    void resize_and_overwrite(size_type n, Op op)
+    {
+        if (n > size_) smart_grow(n - size_);
+        pointer p = get_current_data();
+        size_ = static_cast<size_type>(std::move(op)(p, n));
+        p[size_] = value_type();
+    }
+
     basic_string substr(size_type begin = 0, size_type len = -1)
     {
         const_pointer pBegin;
@@ -280,11 +400,71 @@ public:
         return basic_string(pBegin, len);
     }
 
-    size_type find(const basic_string& patt, size_type pos = 0)
+    // ========== Search ==========
+    // 与 std::basic_string 语义相同；char 字符串用 SIMD 比较首尾字符筛选候选再 memcmp (见 algorithm/simd_search.h)
+    size_type find(const basic_string& patt, size_type pos = 0) const
+    {
+        return search_forward(patt.get_current_data(), pos, patt.size());
+    }
+    size_type find(const_pointer s, size_type pos, size_type count) const { return search_forward(s, pos, count); }
+    size_type find(const_pointer s, size_type pos = 0) const { return search_forward(s, pos, traits_type::length(s)); }
+    size_type find(value_type ch, size_type pos = 0) const
     {
-        return kmp_search(patt, pos);
+        if (pos >= size_) return npos;
+        const_pointer str = get_current_data();
+        const_pointer hit = traits_type::find(str + pos, size_ - pos, ch);
+        return hit ? static_cast<size_type>(hit - str) : npos;
     }
 
+    // 用预先构造好的搜索器 (mystl::searcher、kmp_searcher 等) 查找，同一个模式反复查找时不重复预处理
+    template <typename Searcher,
+              typename = std::enable_if_t<std::is_invocable<const Searcher&, const_pointer, const_pointer>::value>>
+    size_type find(const Searcher& pattern_searcher, size_type pos = 0) const
+    {
+        if (pos > size_) return npos;
+        // 空模式匹配在 pos，pos == size() 时无法与“没有匹配”区分，与 find(const basic_string&) 一样直接返回 pos
+        if (empty_pattern(pattern_searcher, 0)) return pos;
+        const_pointer str = get_current_data();
+        const_pointer hit = pattern_searcher(str + pos, str + size_).first;
+        return hit == str + size_ ? npos : static_cast<size_type>(hit - str);
+    }
+
+    size_type rfind(const basic_string& patt, size_type pos = npos) const
+    {
+        return search_backward(patt.get_current_data(), pos, patt.size());
+    }
+    size_type rfind(const_pointer s, size_type pos, size_type count) const { return search_backward(s, pos, count); }
+    size_type rfind(const_pointer s, size_type pos = npos) const { return search_backward(s, pos, traits_type::length(s)); }
+    size_type rfind(value_type ch, size_type pos = npos) const { return search_backward(&ch, pos, 1); }
+
+    size_type find_first_of(const_pointer s, size_type pos, size_type count) const
+    {
+        if (pos >= size_ || count == 0) return npos;
+        const_pointer str = get_current_data();
+        if constexpr (byte_search) {
+            const size_type r = detail::simd_find_first_of(str + pos, size_ - pos, s, count);
+            return r == detail::k_simd_npos ? npos : pos + r;
+        } else {
+            for (size_type i = pos; i < size_; ++i) {
+                if (traits_type::find(s, count, str[i])) return i;
+            }
+            return npos;
+        }
+    }
+    size_type find_first_of(const basic_string& set, size_type pos = 0) const
+    {
+        return find_first_of(set.get_current_data(), pos, set.size());
+    }
+    size_type find_first_of(const_pointer s, size_type pos = 0) const
+    {
+        return find_first_of(s, pos, traits_type::length(s));
+    }
+    size_type find_first_of(value_type ch, size_type pos = 0) const { return find(ch, pos); }
+
+    bool contains(const basic_string& patt) const { return find(patt) != npos; }
+    bool contains(const_pointer s) const { return find(s) != npos; }
+    bool contains(value_type ch) const { return find(ch) != npos; }
+
     // ========== Modifiers ==========
     void clear() noexcept
     {
@@ -336,6 +516,10 @@ public:
     }
 };
 
+// 短字符串存放在对象内部的 union 中，按 capacity_ 判断而不是保存指向自身的指针，可以按字节搬动
+template<typename CharT, typename Traits, typename Alloc>
+struct is_trivially_relocatable<basic_string<CharT, Traits, Alloc>> : is_trivially_relocatable<Alloc> {};
+
 // ========== Non-member functions ==========
 template<typename CharT, typename Traits, typename Alloc>
 basic_string<CharT, Traits, Alloc> operator<<(std::ostream& os, const basic_string<CharT, Traits, Alloc>& str)
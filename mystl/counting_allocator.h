@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "memory.h"
+#include "utility.h"
+
+namespace mystl
+{
+
+// ---- 分配统计 ----
+// 某一时刻的统计值
+struct allocation_snapshot
+{
+    // 第 i 档统计大小在 (2^(i-1), 2^i] 字节内的分配，最后一档统计更大的分配
+    static constexpr std::size_t k_histogram_buckets = 32;
+
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+    std::size_t bytes = 0;            // 累计分配的字节数
+    std::size_t live_bytes = 0;       // 当前未释放的字节数
+    std::size_t peak_live_bytes = 0;  // live_bytes 的最大值
+    std::size_t histogram[k_histogram_buckets] = {};
+};
+
+// 每个标签 (Tag 类型) 一份计数器，多个线程可以同时使用同一个标签。
+// 次数、字节数和大小分布按线程分片，只有所属线程写入 (普通的 load + store，没有原子读改写)，
+// 读取时把所有分片加起来；存活字节数和峰值需要全局一致，是仅有的两个共享原子量。
+// 分片在线程第一次使用该标签时创建，线程退出后保留 (其中的计数仍然有效)
+class allocation_stats
+{
+public:
+    static constexpr std::size_t k_histogram_buckets = allocation_snapshot::k_histogram_buckets;
+
+    struct shard
+    {
+        std::atomic<std::size_t> allocations{0};
+        std::atomic<std::size_t> deallocations{0};
+        std::atomic<std::size_t> bytes{0};
+        std::atomic<std::size_t> histogram[k_histogram_buckets] = {};
+    };
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<shard>> shards_;
+    allocation_snapshot baseline_;  // reset() 时的累计值，快照中减去
+    alignas(64) std::atomic<std::size_t> live_bytes_{0};
+    std::atomic<std::size_t> peak_live_bytes_{0};
+
+    // 分片只有一个写者，不需要读改写
+    static void bump(std::atomic<std::size_t>& c, std::size_t n) noexcept
+    {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    allocation_snapshot totals_locked() const
+    {
+        allocation_snapshot t;
+        for (const auto& sh : shards_) {
+            t.allocations += sh->allocations.load(std::memory_order_relaxed);
+            t.deallocations += sh->deallocations.load(std::memory_order_relaxed);
+            t.bytes += sh->bytes.load(std::memory_order_relaxed);
+            for (std::size_t b = 0; b < k_histogram_buckets; ++b) t.histogram[b] += sh->histogram[b].load(std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+public:
+    static std::size_t bucket_of(std::size_t n) noexcept
+    {
+        if (n <= 1) return 0;
+        const std::size_t b = 64 - static_cast<std::size_t>(__builtin_clzll(static_cast<unsigned long long>(n - 1)));
+        return b < k_histogram_buckets ? b : k_histogram_buckets - 1;
+    }
+
+    shard* new_shard()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shards_.push_back(std::make_unique<shard>());
+        return shards_.back().get();
+    }
+
+    void record_allocate(shard& sh, std::size_t n) noexcept
+    {
+        bump(sh.allocations, 1);
+        bump(sh.bytes, n);
+        bump(sh.histogram[bucket_of(n)], 1);
+        const std::size_t live = live_bytes_.fetch_add(n, std::memory_order_relaxed) + n;
+        std::size_t peak = peak_live_bytes_.load(std::memory_order_relaxed);
+        while (live > peak && !peak_live_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    void record_deallocate(shard& sh, std::size_t n) noexcept
+    {
+        bump(sh.deallocations, 1);
+        live_bytes_.fetch_sub(n, std::memory_order_relaxed);
+    }
+
+    allocation_snapshot snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        allocation_snapshot t = totals_locked();
+        t.allocations -= baseline_.allocations;
+        t.deallocations -= baseline_.deallocations;
+        t.bytes -= baseline_.bytes;
+        for (std::size_t b = 0; b < k_histogram_buckets; ++b) t.histogram[b] -= baseline_.histogram[b];
+        t.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+        t.peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+        return t;
+    }
+
+    // 清零累计值；live_bytes 仍对应着未释放的内存，保留不变，峰值从当前值重新开始
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        baseline_ = totals_locked();
+        peak_live_bytes_.store(live_bytes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+// 所有用到过的标签，按第一次使用的顺序登记，用于输出报告
+class allocation_registry
+{
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, allocation_stats*>> entries_;
+
+    allocation_registry() = default;
+
+public:
+    static allocation_registry& instance()
+    {
+        static allocation_registry registry;
+        return registry;
+    }
+
+    void add(std::string name, allocation_stats* stats)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.emplace_back(std::move(name), stats);
+    }
+
+    template <typename Func>
+    void for_each(Func func) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& e : entries_) func(e.first, *e.second);
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& e : entries_) e.second->reset();
+    }
+};
+
+// 标签 Tag 对应的计数器，第一次调用时登记，名字取 Tag 的类型名
+template <typename Tag>
+allocation_stats& allocation_stats_for()
+{
+    static allocation_stats& stats = [] () -> allocation_stats& {
+        static allocation_stats s;
+        allocation_registry::instance().add(mystl::type_name<Tag>(), &s);
+        return s;
+    }();
+    return stats;
+}
+
+namespace detail
+{
+// 当前线程在 Tag 上的分片
+template <typename Tag>
+allocation_stats::shard& local_allocation_shard()
+{
+    thread_local allocation_stats::shard* sh = nullptr;
+    if (!sh) sh = allocation_stats_for<Tag>().new_shard();
+    return *sh;
+}
+} // namespace detail
+
+// 常用的标签，按容器类型区分
+struct default_alloc_tag {};
+struct vector_alloc_tag {};
+struct deque_alloc_tag {};
+struct string_alloc_tag {};
+struct shared_ptr_alloc_tag {};
+
+// 计数分配器：把分配转交给 Alloc (默认 std::allocator)，同时把次数、字节数、存活字节数峰值和
+// 大小分布记到 Tag 的计数器中。rebind 保留 Tag，deque 的 map、allocate_shared 的控制块也计入同一个标签。
+// Alloc 声明的 alignment、reallocate 原样转发，包装 aligned_allocator / page_allocator 时容器行为不变
+template <typename Tp, typename Tag = default_alloc_tag, typename Alloc = std::allocator<Tp>>
+class counting_allocator
+{
+    using inner_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
+
+    inner_type inner_;
+
+public:
+    using value_type = Tp;
+    using size_type  = std::size_t;
+    using tag_type   = Tag;
+
+    static constexpr std::size_t alignment = detail::allocator_alignment<inner_type>::value;
+
+    using propagate_on_container_copy_assignment = typename std::allocator_traits<inner_type>::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment = typename std::allocator_traits<inner_type>::propagate_on_container_move_assignment;
+    using propagate_on_container_swap            = typename std::allocator_traits<inner_type>::propagate_on_container_swap;
+    using is_always_equal                        = typename std::allocator_traits<inner_type>::is_always_equal;
+
+    template <typename U>
+    struct rebind { using other = counting_allocator<U, Tag, Alloc>; };
+
+    counting_allocator() = default;
+    explicit counting_allocator(const inner_type& inner) : inner_(inner) {}
+    template <typename U>
+    counting_allocator(const counting_allocator<U, Tag, Alloc>& other) noexcept : inner_(other.inner()) {}
+
+    static allocation_stats& stats() { return allocation_stats_for<Tag>(); }
+
+    Tp* allocate(size_type n)
+    {
+        Tp* p = inner_.allocate(n);
+        stats().record_allocate(detail::local_allocation_shard<Tag>(), n * sizeof(Tp));
+        return p;
+    }
+
+    void deallocate(Tp* p, size_type n) noexcept
+    {
+        stats().record_deallocate(detail::local_allocation_shard<Tag>(), n * sizeof(Tp));
+        inner_.deallocate(p, n);
+    }
+
+    // 只有 Alloc 提供 reallocate 时才存在，记为一次释放加一次分配
+    template <typename A = inner_type, typename = std::enable_if_t<detail::has_reallocate<A>::value>>
+    Tp* reallocate(Tp* p, size_type old_n, size_type new_n)
+    {
+        Tp* q = inner_.reallocate(p, old_n, new_n);
+        allocation_stats::shard& sh = detail::local_allocation_shard<Tag>();
+        if (p) stats().record_deallocate(sh, old_n * sizeof(Tp));
+        if (q) stats().record_allocate(sh, new_n * sizeof(Tp));
+        return q;
+    }
+
+    const inner_type& inner() const noexcept { return inner_; }
+
+    counting_allocator select_on_container_copy_construction() const
+    {
+        return counting_allocator(std::allocator_traits<inner_type>::select_on_container_copy_construction(inner_));
+    }
+
+    template <typename U>
+    friend bool operator==(const counting_allocator& a, const counting_allocator<U, Tag, Alloc>& b) noexcept
+    {
+        return a.inner() == b.inner();
+    }
+    template <typename U>
+    friend bool operator!=(const counting_allocator& a, const counting_allocator<U, Tag, Alloc>& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
+template <typename Tp, typename Tag, typename Alloc>
+struct is_trivially_relocatable<counting_allocator<Tp, Tag, Alloc>> : is_trivially_relocatable<Alloc> {};
+
+// ---- 报告 ----
+// 每个标签一行：分配 / 释放次数、累计字节、当前存活字节、峰值，下一行是非空的大小分档
+inline void print_allocation_report(std::ostream& os = std::cout)
+{
+    os << std::left << std::setw(32) << "tag" << std::right << std::setw(12) << "allocs" << std::setw(12) << "frees"
+       << std::setw(14) << "bytes" << std::setw(12) << "live" << std::setw(12) << "peak" << '\n';
+    allocation_registry::instance().for_each([&os](const std::string& name, const allocation_stats& stats) {
+        const allocation_snapshot s = stats.snapshot();
+        os << std::left << std::setw(32) << name << std::right << std::setw(12) << s.allocations << std::setw(12)
+           << s.deallocations << std::setw(14) << s.bytes << std::setw(12) << s.live_bytes << std::setw(12)
+           << s.peak_live_bytes << '\n';
+        os << "    sizes:";
+        for (std::size_t b = 0; b < allocation_snapshot::k_histogram_buckets; ++b) {
+            if (s.histogram[b] == 0) continue;
+            if (b + 1 == allocation_snapshot::k_histogram_buckets) os << " >" << (std::size_t(1) << (b - 1)) << ':' << s.histogram[b];
+            else os << " <=" << (std::size_t(1) << b) << ':' << s.histogram[b];
+        }
+        os << '\n';
+    });
+}
+
+inline void reset_allocation_stats() { allocation_registry::instance().reset(); }
+
+} // namespace mystl
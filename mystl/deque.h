@@ -1,10 +1,15 @@
 #pragma once
 
+#include <iostream>
 #include <memory>
 #include <utility>
 
 #include <cassert>
 
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+
 namespace mystl
 {
 
@@ -14,12 +19,15 @@ static constexpr size_t MYSTL_DEQUE_BUFFER_NUM = 4;
 template <typename Tp>
 struct deque_iterator
 {
-    using self            = deque_iterator;
-    using value_type      = Tp;
-    using size_type       = size_t;
-    using pointer         = Tp *;
-    using reference       = Tp &;
-    using difference_type = std::ptrdiff_t;
+    using self              = deque_iterator;
+    using iterator_category = random_access_iterator_tag;
+    using value_type        = Tp;
+    using size_type         = size_t;
+    using pointer           = Tp *;
+    using reference         = Tp &;
+    using difference_type   = std::ptrdiff_t;
+
+    static constexpr difference_type buffer_size = static_cast<difference_type>(MYSTL_DEQUE_BUFFER_SIZE);
 
     pointer cur_;     // 当前元素
     pointer first_;   // 当前 buffer 的起始
@@ -30,8 +38,9 @@ struct deque_iterator
     deque_iterator(pointer cur, pointer first, pointer last, pointer* node)
         :cur_(cur), first_(first), last_(last), node_(node) {}
 
-    reference operator*() { return *cur_; }
-    pointer operator->() { return cur_; }
+    reference operator*() const { return *cur_; }
+    pointer operator->() const { return cur_; }
+    reference operator[](difference_type i) const { return *(*this + i); }
 
     self& operator++()
     {
@@ -67,35 +76,43 @@ struct deque_iterator
         return temp;
     }
 
-    self& operator+=(size_type i)
+    // 目标仍在当前 buffer 内时直接移动指针，否则按 buffer 大小换算出要跨过的节点数（向下取整）
+    self& operator+=(difference_type n)
     {
-        size_type offset = i > 0 ? i + (cur_ - first_) : i - (last_ - cur_);
-
-        if (offset > -MYSTL_DEQUE_BUFFER_SIZE && offset < MYSTL_DEQUE_BUFFER_SIZE) {
-            cur_ += i;
+        const difference_type offset = n + (cur_ - first_);
+        if (offset >= 0 && offset < buffer_size) {
+            cur_ += n;
         } else {
-            size_type node_offset = offset / MYSTL_DEQUE_BUFFER_SIZE;
-            size_type buf_offset = offset % MYSTL_DEQUE_BUFFER_SIZE;
+            const difference_type node_offset = offset > 0 ? offset / buffer_size
+                                                           : -((-offset - 1) / buffer_size) - 1;
             set_node(node_ + node_offset);
-            cur_ = i > 0 ? first_ + buf_offset : last_ - buf_offset - 1;
+            cur_ = first_ + (offset - node_offset * buffer_size);
         }
         return *this;
     }
 
-    self& operator-=(size_type i) { return *this += -i; }
+    self& operator-=(difference_type n) { return *this += -n; }
 
-    self operator+(size_type i) { self temp = *this; return temp += i; }
-    self operator-(size_type i) const  { self temp = *this; return temp -= i; }
+    self operator+(difference_type n) const { self temp = *this; return temp += n; }
+    self operator-(difference_type n) const { self temp = *this; return temp -= n; }
+    friend self operator+(difference_type n, const self& it) { return it + n; }
 
     friend difference_type
     operator-(const self& x, const self& y) noexcept
     {
-        return static_cast<difference_type>(x.node_ - y.node_) * MYSTL_DEQUE_BUFFER_SIZE
+        return static_cast<difference_type>(x.node_ - y.node_) * buffer_size
             + (x.cur_ - x.first_) - (y.cur_ - y.first_); 
     }
 
     friend bool operator==(const self& x, const self& y) { return x.cur_ == y.cur_; }
     friend bool operator!=(const self& x, const self& y) { return x.cur_ != y.cur_; }
+    friend bool operator<(const self& x, const self& y)
+    {
+        return x.node_ == y.node_ ? x.cur_ < y.cur_ : x.node_ < y.node_;
+    }
+    friend bool operator>(const self& x, const self& y) { return y < x; }
+    friend bool operator<=(const self& x, const self& y) { return !(y < x); }
+    friend bool operator>=(const self& x, const self& y) { return !(x < y); }
 
     void set_node(pointer* new_node)
     {
@@ -139,7 +156,13 @@ public:
         allocate_map_and_nodes(0);
     }
 
-    deque(size_type n, const_reference elem) : map_(nullptr), map_size_(0), sz_(n)
+    explicit deque(const allocator_type& alloc) : map_(nullptr), map_size_(0), sz_(0), allocator_(alloc)
+    {
+        allocate_map_and_nodes(0);
+    }
+
+    deque(size_type n, const_reference elem, const allocator_type& alloc = allocator_type())
+        : map_(nullptr), map_size_(0), sz_(n), allocator_(alloc)
     {
         allocate_map_and_nodes(n);
 
@@ -149,27 +172,62 @@ public:
     }
 
     deque(const deque& other)
+        : deque(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.allocator_)) {}
+
+    // 指定分配器的拷贝 / 移动构造：pmr 容器嵌套时 (pmr::vector<pmr::deque<T>>) 外层按 uses-allocator 规则调用
+    deque(const deque& other, const allocator_type& alloc)
+        : map_(nullptr), map_size_(0), sz_(other.sz_), allocator_(alloc)
     {
-        create_map_and_node(other.size());
-        std::uninitialized_copy(other.begin(), other.end(), start_);
+        allocate_map_and_nodes(other.sz_);
+        iterator src = other.start_;
+        for (iterator it = start_; it != finish_; ++it, ++src) {
+            std::allocator_traits<allocator_type>::construct(allocator_, it.cur_, *src);
+        }
     }
 
     deque(deque&& other) noexcept
         : map_(other.map_), map_size_(other.map_size_),
-        start_(other.start_), finish_(other.finish_),
+        start_(other.start_), finish_(other.finish_), sz_(other.sz_),
         allocator_(std::move(other.allocator_))
     {
         other.map_ = nullptr;
         other.map_size_ = 0;
+        other.sz_ = 0;
+    }
+
+    // 分配器相等时接管对方的内存，否则在自己的分配器上逐个移动元素
+    deque(deque&& other, const allocator_type& alloc)
+        : map_(nullptr), map_size_(0), sz_(0), allocator_(alloc)
+    {
+        if (allocator_ == other.allocator_) {
+            map_ = other.map_;
+            map_size_ = other.map_size_;
+            start_ = other.start_;
+            finish_ = other.finish_;
+            sz_ = other.sz_;
+            other.map_ = nullptr;
+            other.map_size_ = 0;
+            other.sz_ = 0;
+            return;
+        }
+        sz_ = other.sz_;
+        allocate_map_and_nodes(sz_);
+        iterator src = other.start_;
+        for (iterator it = start_; it != finish_; ++it, ++src) {
+            std::allocator_traits<allocator_type>::construct(allocator_, it.cur_, std::move(*src));
+        }
     }
 
     ~deque()
     {
         if (map_) {
+            for (iterator it = start_; it != finish_; ++it) {
+                std::allocator_traits<allocator_type>::destroy(allocator_, it.cur_);
+            }
             for (size_type i = 0; i < map_size_; ++i) {
                 deallocate_buffer(map_[i]);
             }
-            delete[] map_;
+            deallocate_map(map_, map_size_);
         }
     }
 
@@ -183,7 +241,12 @@ public: // private
 
     void deallocate_buffer(pointer buf) { if (buf) allocator_.deallocate(buf, MYSTL_DEQUE_BUFFER_SIZE); }
 
-    pointer* allocate_map(size_type map_size) { return new pointer[map_size]; }
+    // map 也从同一个分配器 (rebind 到 pointer) 申请，pmr 资源下整个 deque 不经过 operator new
+    using map_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<pointer>;
+
+    pointer* allocate_map(size_type map_size) { return map_allocator_type(allocator_).allocate(map_size); }
+
+    void deallocate_map(pointer* map, size_type map_size) { map_allocator_type(allocator_).deallocate(map, map_size); }
 
     void allocate_map_and_nodes(size_type n);
 
@@ -197,6 +260,8 @@ public: // private
     void reallocate_map_front(size_type add_num);
 
 public:
+    allocator_type get_allocator() const { return allocator_; }
+
     // ========== 迭代 ==========
     iterator begin() { return start_; }
     const_iterator begin() const { return start_; }
@@ -279,6 +344,10 @@ public:
     void printf_struct() const;
 };
 
+// map 和 buffer 都在堆上，迭代器也只指向堆内存
+template <typename Tp, typename Alloc>
+struct is_trivially_relocatable<deque<Tp, Alloc>> : is_trivially_relocatable<Alloc> {};
+
 template <typename Tp, typename Alloc>
 void deque<Tp, Alloc>::allocate_map_and_nodes(size_type n)
 {
@@ -314,7 +383,7 @@ void deque<Tp, Alloc>::reallocate_map(size_type add_num, bool add_at_front)
     const size_type start_offset = start_.node_ - map_;
     const size_type node_n = node_num();
 
-    delete[] map_;
+    deallocate_map(map_, map_size_);
 
     map_size_ = new_map_size;
     map_ = new_map;
@@ -340,7 +409,7 @@ void deque<Tp, Alloc>::reallocate_map_back(size_type add_num)
     const size_type start_offset = start_.node_ - map_;
     const size_type node_n = finish_.node_ - start_.node_;
 
-    delete[] map_;
+    deallocate_map(map_, map_size_);
 
     map_size_ = new_map_size;
     map_ = new_map;
@@ -368,7 +437,7 @@ void deque<Tp, Alloc>::reallocate_map_front(size_type add_num)
     const size_type start_offset = start_.node_ - map_;
     const size_type node_n = finish_.node_ - start_.node_;
 
-    delete[] map_;
+    deallocate_map(map_, map_size_);
 
     map_size_ = new_map_size;
     map_ = new_map;
@@ -388,7 +457,8 @@ template <typename Tp, typename Alloc>
 template <typename... Args>
 void deque<Tp, Alloc>::construct_back(Args &&...args)
 {
-    if (finish_.node_ == map_ + map_size_) reallocate_map_back(1);
+    // finish_ 走到最后一个 buffer 的末尾时 ++ 会读 map 之外的节点，先在后面补一个 buffer
+    if (finish_.cur_ + 1 == finish_.last_ && finish_.node_ + 1 == map_ + map_size_) reallocate_map_back(1);
     std::allocator_traits<allocator_type>::construct(allocator_, &(*(finish_++)), std::forward<Args>(args)...);
     ++sz_;
 }
@@ -403,7 +473,7 @@ template <typename Tp, typename Alloc>
 template <typename... Args>
 void deque<Tp, Alloc>::construct_front(Args &&...args)
 {
-    if (start_.node_ == map_) reallocate_map_front(1);
+    if (start_.cur_ == start_.first_ && start_.node_ == map_) reallocate_map_front(1);
     std::allocator_traits<allocator_type>::construct(allocator_, &(*(--start_)), std::forward<Args>(args)...);
     ++sz_;
 }
@@ -443,4 +513,10 @@ void deque<Tp, Alloc>::printf_struct() const
     std::cout << "@printf_struct end" << std::endl;
 }
 
+namespace pmr
+{
+template <typename Tp>
+using deque = mystl::deque<Tp, polymorphic_allocator<Tp>>;
+} // namespace pmr
+
 } // namespace mystl
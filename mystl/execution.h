@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "thread_pool.h"
+
+// 提示编译器循环各次迭代之间没有依赖，可以向量化
+#if defined(__clang__)
+#define MYSTL_SIMD_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define MYSTL_SIMD_LOOP _Pragma("GCC ivdep")
+#else
+#define MYSTL_SIMD_LOOP
+#endif
+
+namespace mystl
+{
+namespace execution
+{
+
+// 执行策略，对应 std::execution：
+// seq       逐个元素顺序执行
+// unseq     单线程，内层循环允许向量化（元素访问函数之间不能有同步）
+// par       分块交给线程池并行执行
+// par_unseq 分块并行 + 块内向量化
+struct sequenced_policy {};
+struct unsequenced_policy {};
+
+// 并行策略可以指定线程池、分块粒度，以及是否要求确定性的归约顺序：
+//   mystl::execution::par.on(pool).grain(1 << 16).deterministic()
+// 默认块数随线程数变化，浮点归约的结果可能随线程数不同而有细微差别；
+// deterministic() 固定按 grain 分块并按块序合并，结果只取决于输入，与线程数和调度无关
+template <bool Vectorize>
+class basic_parallel_policy
+{
+public:
+    static constexpr bool vectorize = Vectorize;
+    static constexpr std::ptrdiff_t default_grain = 1 << 14;
+
+    constexpr basic_parallel_policy() = default;
+
+    basic_parallel_policy on(thread_pool& pool) const
+    {
+        basic_parallel_policy p = *this;
+        p.pool_ = &pool;
+        return p;
+    }
+
+    constexpr basic_parallel_policy grain(std::ptrdiff_t n) const
+    {
+        basic_parallel_policy p = *this;
+        p.grain_ = n > 0 ? n : 1;
+        return p;
+    }
+
+    constexpr basic_parallel_policy deterministic(bool value = true) const
+    {
+        basic_parallel_policy p = *this;
+        p.deterministic_ = value;
+        return p;
+    }
+
+    thread_pool& pool() const { return pool_ ? *pool_ : thread_pool::default_pool(); }
+    constexpr std::ptrdiff_t grain_size() const { return grain_; }
+    constexpr bool is_deterministic() const { return deterministic_; }
+
+private:
+    thread_pool* pool_ = nullptr;
+    std::ptrdiff_t grain_ = default_grain;
+    bool deterministic_ = false;
+};
+
+using parallel_policy = basic_parallel_policy<false>;
+using parallel_unsequenced_policy = basic_parallel_policy<true>;
+
+inline constexpr sequenced_policy seq{};
+inline constexpr unsequenced_policy unseq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+
+} // namespace execution
+
+template <typename Tp>
+struct is_execution_policy : std::false_type {};
+
+template <> struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+template <> struct is_execution_policy<execution::unsequenced_policy> : std::true_type {};
+template <bool Vectorize> struct is_execution_policy<execution::basic_parallel_policy<Vectorize>> : std::true_type {};
+
+template <typename Tp>
+inline constexpr bool is_execution_policy_v = is_execution_policy<std::decay_t<Tp>>::value;
+
+} // namespace mystl
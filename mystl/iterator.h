@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace mystl
+{
+
+// ---- 迭代器类别 ----
+// 标签直接使用标准库的类型，mystl 的迭代器声明类别后同样可以交给 std 的算法；
+// contiguous 在 C++17 中没有对应的标准标签，自己定义一个派生自 random_access 的
+using input_iterator_tag         = std::input_iterator_tag;
+using output_iterator_tag        = std::output_iterator_tag;
+using forward_iterator_tag       = std::forward_iterator_tag;
+using bidirectional_iterator_tag = std::bidirectional_iterator_tag;
+using random_access_iterator_tag = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+using contiguous_iterator_tag    = std::contiguous_iterator_tag;
+#else
+struct contiguous_iterator_tag : random_access_iterator_tag {};
+#endif
+
+// ---- iterator_traits ----
+// 迭代器类型声明了五个成员类型时才有定义，否则为空，可以用于 SFINAE
+namespace detail
+{
+template <typename Iter, typename = void>
+struct iterator_traits_base {};
+
+template <typename Iter>
+struct iterator_traits_base<Iter, std::void_t<typename Iter::iterator_category, typename Iter::value_type,
+                                              typename Iter::difference_type, typename Iter::pointer,
+                                              typename Iter::reference>>
+{
+    using iterator_category = typename Iter::iterator_category;
+    using value_type        = typename Iter::value_type;
+    using difference_type   = typename Iter::difference_type;
+    using pointer           = typename Iter::pointer;
+    using reference         = typename Iter::reference;
+};
+} // namespace detail
+
+template <typename Iter>
+struct iterator_traits : detail::iterator_traits_base<Iter> {};
+
+// 原生指针（vector / array / basic_string 的迭代器）是连续迭代器
+template <typename Tp>
+struct iterator_traits<Tp*>
+{
+    using iterator_category = contiguous_iterator_tag;
+    using value_type        = std::remove_cv_t<Tp>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = Tp*;
+    using reference         = Tp&;
+};
+
+template <typename Iter>
+using iterator_category_t = typename iterator_traits<Iter>::iterator_category;
+
+template <typename Iter>
+using iter_value_t = typename iterator_traits<Iter>::value_type;
+
+template <typename Iter>
+using iter_difference_t = typename iterator_traits<Iter>::difference_type;
+
+namespace detail
+{
+template <typename Iter, typename Tag, typename = void>
+struct has_iterator_category : std::false_type {};
+
+template <typename Iter, typename Tag>
+struct has_iterator_category<Iter, Tag, std::void_t<iterator_category_t<Iter>>>
+    : std::is_convertible<iterator_category_t<Iter>, Tag> {};
+} // namespace detail
+
+template <typename Iter>
+struct is_input_iterator : detail::has_iterator_category<Iter, input_iterator_tag> {};
+
+template <typename Iter>
+struct is_forward_iterator : detail::has_iterator_category<Iter, forward_iterator_tag> {};
+
+template <typename Iter>
+struct is_bidirectional_iterator : detail::has_iterator_category<Iter, bidirectional_iterator_tag> {};
+
+template <typename Iter>
+struct is_random_access_iterator : detail::has_iterator_category<Iter, random_access_iterator_tag> {};
+
+template <typename Iter>
+struct is_contiguous_iterator : detail::has_iterator_category<Iter, contiguous_iterator_tag> {};
+
+template <typename Iter>
+inline constexpr bool is_random_access_iterator_v = is_random_access_iterator<Iter>::value;
+
+// ---- distance / advance / next / prev ----
+// 按类别分派：随机访问迭代器 O(1)，其余逐个移动
+namespace detail
+{
+template <typename Iter>
+iter_difference_t<Iter> distance(Iter first, Iter last, input_iterator_tag)
+{
+    iter_difference_t<Iter> n = 0;
+    for (; first != last; ++first) ++n;
+    return n;
+}
+
+template <typename Iter>
+iter_difference_t<Iter> distance(Iter first, Iter last, random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template <typename Iter, typename Distance>
+void advance(Iter& it, Distance n, input_iterator_tag)
+{
+    for (; n > 0; --n) ++it;
+}
+
+template <typename Iter, typename Distance>
+void advance(Iter& it, Distance n, bidirectional_iterator_tag)
+{
+    if (n >= 0) {
+        for (; n > 0; --n) ++it;
+    } else {
+        for (; n < 0; ++n) --it;
+    }
+}
+
+template <typename Iter, typename Distance>
+void advance(Iter& it, Distance n, random_access_iterator_tag)
+{
+    it += static_cast<iter_difference_t<Iter>>(n);
+}
+} // namespace detail
+
+template <typename Iter>
+iter_difference_t<Iter> distance(Iter first, Iter last)
+{
+    return detail::distance(first, last, iterator_category_t<Iter>());
+}
+
+// 输入 / 前向迭代器的 n 必须非负
+template <typename Iter, typename Distance>
+void advance(Iter& it, Distance n)
+{
+    detail::advance(it, n, iterator_category_t<Iter>());
+}
+
+template <typename Iter>
+Iter next(Iter it, iter_difference_t<Iter> n = 1)
+{
+    mystl::advance(it, n);
+    return it;
+}
+
+template <typename Iter>
+Iter prev(Iter it, iter_difference_t<Iter> n = 1)
+{
+    static_assert(is_bidirectional_iterator<Iter>::value, "mystl::prev requires a bidirectional iterator");
+    mystl::advance(it, -n);
+    return it;
+}
+
+} // namespace mystl
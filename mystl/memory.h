@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "type_traits.h"
+
+namespace mystl
+{
+
+// std::allocator 没有状态，但拷贝构造函数不是平凡的
+template <typename Tp>
+struct is_trivially_relocatable<std::allocator<Tp>> : std::true_type {};
+
+// ---- 重定位 ----
+// 把元素从一处搬到另一处并结束旧位置上对象的生命期。
+// 可平凡重定位的类型整块 memcpy / memmove，其余逐个“移动构造 + 析构”
+
+// [first, first + n) 搬到未初始化且不重叠的 dest
+template <typename Alloc, typename Tp>
+void uninitialized_relocate_n(Alloc& alloc, Tp* first, std::size_t n, Tp* dest)
+{
+    if constexpr (is_trivially_relocatable<Tp>::value) {
+        if (n) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(Tp));
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            std::allocator_traits<Alloc>::construct(alloc, dest + i, std::move_if_noexcept(first[i]));
+            std::allocator_traits<Alloc>::destroy(alloc, first + i);
+        }
+    }
+}
+
+// 同一块缓冲区内把 [first, first + n) 整体搬到 dest，两段可以重叠。只用于可平凡重定位的类型
+template <typename Tp>
+void relocate_overlapping_n(Tp* first, std::size_t n, Tp* dest)
+{
+    static_assert(is_trivially_relocatable<Tp>::value, "relocate_overlapping_n requires a trivially relocatable type");
+    if (n) std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(Tp));
+}
+
+// ---- 批量构造 ----
+// 在未初始化的 dest 上构造 n 个元素；构造中途抛出异常时析构已构造的部分再抛出
+
+// 从 first 开始拷贝 n 个元素，返回读完之后的迭代器。源是同类型的指针且元素可平凡拷贝时整块 memcpy
+template <typename Alloc, typename Iter, typename Tp>
+Iter uninitialized_copy_n(Alloc& alloc, Iter first, std::size_t n, Tp* dest)
+{
+    if constexpr (std::is_pointer<Iter>::value && std::is_same<std::remove_cv_t<std::remove_pointer_t<Iter>>, Tp>::value &&
+                  std::is_trivially_copyable<Tp>::value) {
+        if (n) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(Tp));
+        return first + n;
+    } else {
+        std::size_t i = 0;
+        try {
+            for (; i < n; ++i, ++first) std::allocator_traits<Alloc>::construct(alloc, dest + i, *first);
+        } catch (...) {
+            for (std::size_t j = 0; j < i; ++j) std::allocator_traits<Alloc>::destroy(alloc, dest + j);
+            throw;
+        }
+        return first;
+    }
+}
+
+template <typename Alloc, typename Tp>
+void uninitialized_fill_n(Alloc& alloc, Tp* dest, std::size_t n, const Tp& value)
+{
+    std::size_t i = 0;
+    try {
+        for (; i < n; ++i) std::allocator_traits<Alloc>::construct(alloc, dest + i, value);
+    } catch (...) {
+        for (std::size_t j = 0; j < i; ++j) std::allocator_traits<Alloc>::destroy(alloc, dest + j);
+        throw;
+    }
+}
+
+// 分配器是否提供 reallocate(p, old_n, new_n)：按字节保留原有内容地调整空间大小（如 page_allocator 的 mremap）。
+// 只对可平凡重定位的元素使用
+namespace detail
+{
+template <typename Alloc, typename = void>
+struct has_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+                                 std::declval<typename Alloc::value_type*>(), std::size_t(), std::size_t()))>>
+    : std::true_type {};
+} // namespace detail
+
+// 分配器的对齐字节数：声明了 alignment 成员（如 aligned_allocator）时取该值，否则为元素自身的对齐。
+// round_up_capacity 把容量取整到 alignment / sizeof(value_type) 个元素的倍数，不能整除时不取整
+namespace detail
+{
+template <typename Alloc, typename = void>
+struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename Alloc::value_type)> {};
+
+template <typename Alloc>
+struct allocator_alignment<Alloc, std::void_t<decltype(Alloc::alignment)>>
+    : std::integral_constant<std::size_t, Alloc::alignment> {};
+
+template <typename Alloc>
+constexpr std::size_t round_up_capacity(std::size_t n)
+{
+    constexpr std::size_t align = allocator_alignment<Alloc>::value;
+    constexpr std::size_t elem = sizeof(typename Alloc::value_type);
+    constexpr std::size_t lanes = align > elem && align % elem == 0 ? align / elem : 1;
+    return (n + lanes - 1) / lanes * lanes;
+}
+} // namespace detail
+
+// ---- 扩容策略 ----
+// 容器满了以后由 next_capacity(capacity, elem_size) 给出新的容量，返回值必须大于 capacity
+struct growth_double
+{
+    static std::size_t next_capacity(std::size_t capacity, std::size_t) { return capacity == 0 ? 1 : capacity * 2; }
+};
+
+// 1.5 倍：释放掉的旧块累计起来有机会被后续扩容复用，代价是扩容次数多一些
+struct growth_1_5x
+{
+    static std::size_t next_capacity(std::size_t capacity, std::size_t) { return capacity < 2 ? capacity + 1 : capacity + capacity / 2; }
+};
+
+// 按页增长：不足 ChunkBytes 时翻倍，之后每次固定增加 ChunkBytes，字节数按 4KB 页取整。
+// 多出来的空间不超过 ChunkBytes；配合可以 mremap 的分配器，扩容不拷贝，次数多一些也不要紧
+template <std::size_t ChunkBytes = std::size_t(2) << 20>
+struct growth_pages
+{
+    static_assert(ChunkBytes % 4096 == 0, "growth_pages requires a whole number of pages");
+
+    static std::size_t next_capacity(std::size_t capacity, std::size_t elem_size)
+    {
+        const std::size_t bytes = capacity * elem_size;
+        std::size_t want = bytes == 0 ? elem_size : bytes < ChunkBytes ? bytes * 2 : bytes + ChunkBytes;
+        want = (want + 4095) / 4096 * 4096;
+        return want / elem_size;
+    }
+};
+
+} // namespace mystl
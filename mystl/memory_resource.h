@@ -0,0 +1,439 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mystl
+{
+namespace pmr
+{
+
+// ---- 多态内存资源 ----
+// 接口与 C++17 的 std::pmr 相同：容器统一使用 polymorphic_allocator，具体从哪里拿内存由运行时
+// 传入的 memory_resource 决定，同一个容器类型可以用堆、请求级的 arena 或内存池
+
+class memory_resource
+{
+public:
+    static constexpr std::size_t max_align = alignof(std::max_align_t);
+
+    virtual ~memory_resource() = default;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = max_align) { return do_allocate(bytes, alignment); }
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment = max_align) { do_deallocate(p, bytes, alignment); }
+    bool is_equal(const memory_resource& other) const noexcept { return do_is_equal(other); }
+
+protected:
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept { return &a == &b || a.is_equal(b); }
+inline bool operator!=(const memory_resource& a, const memory_resource& b) noexcept { return !(a == b); }
+
+namespace detail
+{
+// operator new / delete，对齐要求超过默认值时用带 align_val_t 的版本
+class new_delete_resource_impl : public memory_resource
+{
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) return ::operator new(bytes);
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) ::operator delete(p, bytes);
+        else ::operator delete(p, bytes, std::align_val_t(alignment));
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// 任何分配都抛出 bad_alloc，作为上游可以保证不会落到堆上
+class null_memory_resource_impl : public memory_resource
+{
+protected:
+    void* do_allocate(std::size_t, std::size_t) override { throw std::bad_alloc(); }
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+} // namespace detail
+
+inline memory_resource* new_delete_resource() noexcept
+{
+    static detail::new_delete_resource_impl resource;
+    return &resource;
+}
+
+inline memory_resource* null_memory_resource() noexcept
+{
+    static detail::null_memory_resource_impl resource;
+    return &resource;
+}
+
+namespace detail
+{
+inline std::atomic<memory_resource*>& default_resource()
+{
+    static std::atomic<memory_resource*> resource{new_delete_resource()};
+    return resource;
+}
+} // namespace detail
+
+inline memory_resource* get_default_resource() noexcept { return detail::default_resource().load(); }
+
+// 返回原来的默认资源；传入 nullptr 时恢复为 new_delete_resource()
+inline memory_resource* set_default_resource(memory_resource* r) noexcept
+{
+    return detail::default_resource().exchange(r ? r : new_delete_resource());
+}
+
+// ---- monotonic_buffer_resource ----
+// 只分配不回收的 arena：每次分配只是移动指针，deallocate 什么也不做，release() 或析构时一次性归还上游。
+// 当前块用完后向上游申请一块更大的（每次翻倍）。可以先给一块调用者提供的缓冲区（如栈上的数组），
+// 请求规模可预估时整个请求都不需要 malloc
+class monotonic_buffer_resource : public memory_resource
+{
+    // 从上游申请的块，头部记录块信息并串成链表
+    struct chunk
+    {
+        chunk* next;
+        std::size_t bytes;
+    };
+
+    static constexpr std::size_t k_default_size = 1024;
+
+    memory_resource* upstream_;
+    void* initial_buffer_ = nullptr;
+    std::size_t initial_size_ = 0;
+    std::size_t first_chunk_size_;
+    std::size_t next_size_;
+    void* cur_ = nullptr;
+    std::size_t left_ = 0;
+    chunk* chunks_ = nullptr;
+
+public:
+    explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), first_chunk_size_(k_default_size), next_size_(k_default_size) {}
+
+    explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), first_chunk_size_(initial_size ? initial_size : 1), next_size_(first_chunk_size_) {}
+
+    monotonic_buffer_resource(void* buffer, std::size_t size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), initial_buffer_(buffer), initial_size_(size),
+          first_chunk_size_(size ? size * 2 : k_default_size), next_size_(first_chunk_size_), cur_(buffer), left_(size) {}
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    ~monotonic_buffer_resource() override { release(); }
+
+    // 把所有从上游申请的块还回去，重新从初始缓冲区开始分配
+    void release()
+    {
+        while (chunks_) {
+            chunk* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->bytes, max_align);
+            chunks_ = next;
+        }
+        cur_ = initial_buffer_;
+        left_ = initial_size_;
+        next_size_ = first_chunk_size_;
+    }
+
+    memory_resource* upstream_resource() const { return upstream_; }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (void* p = take(bytes, alignment)) return p;
+        new_chunk(bytes + alignment);
+        return take(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    void* take(std::size_t bytes, std::size_t alignment)
+    {
+        void* p = cur_;
+        std::size_t space = left_;
+        if (!cur_ || !std::align(alignment, bytes, p, space)) return nullptr;
+        cur_ = static_cast<char*>(p) + bytes;
+        left_ = space - bytes;
+        return p;
+    }
+
+    void new_chunk(std::size_t min_bytes)
+    {
+        std::size_t bytes = sizeof(chunk) + (next_size_ > min_bytes ? next_size_ : min_bytes);
+        void* mem = upstream_->allocate(bytes, max_align);
+        chunks_ = ::new (mem) chunk{chunks_, bytes};
+        cur_ = chunks_ + 1;
+        left_ = bytes - sizeof(chunk);
+        next_size_ = bytes * 2;
+    }
+};
+
+// ---- 内存池 ----
+struct pool_options
+{
+    std::size_t max_blocks_per_chunk = 0;         // 每次向上游申请的块最多包含多少个内存块，0 为默认值
+    std::size_t largest_required_pool_block = 0;  // 超过这个大小的请求直接交给上游，0 为默认值
+};
+
+// 按 2 的幂分档 (8, 16, 32, ..., largest_required_pool_block)，每档一条空闲链表。
+// 链表空了就向上游申请一个包含若干内存块的大块，块数逐次翻倍直到 max_blocks_per_chunk。
+// deallocate 把内存块挂回空闲链表，release() 或析构时才还给上游。
+// 超过最大档位或对齐要求超过 max_align 的请求直接交给上游。不加锁，只能在一个线程中使用
+class unsynchronized_pool_resource : public memory_resource
+{
+    static constexpr std::size_t k_min_block = 8;
+    static constexpr std::size_t k_default_largest_block = 4096;
+    static constexpr std::size_t k_max_largest_block = std::size_t(1) << 20;
+    static constexpr std::size_t k_default_blocks_per_chunk = 1024;
+    static constexpr std::size_t k_max_chunk_bytes = std::size_t(256) << 10;
+
+    // 每个大块末尾的记录，串成链表以便 release
+    struct chunk_footer
+    {
+        chunk_footer* next;
+        void* base;
+        std::size_t bytes;
+    };
+
+    struct free_block { free_block* next; };
+
+    struct pool
+    {
+        std::size_t block_size;
+        std::size_t next_blocks;
+        free_block* free_list = nullptr;
+        chunk_footer* chunks = nullptr;
+    };
+
+    struct large_block
+    {
+        void* p;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    memory_resource* upstream_;
+    pool_options options_;
+    std::vector<pool> pools_;
+    std::vector<large_block> large_;
+
+public:
+    unsynchronized_pool_resource() : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+    explicit unsynchronized_pool_resource(memory_resource* upstream) : unsynchronized_pool_resource(pool_options(), upstream) {}
+    explicit unsynchronized_pool_resource(const pool_options& opts) : unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+    unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream) : upstream_(upstream), options_(opts)
+    {
+        if (options_.max_blocks_per_chunk == 0) options_.max_blocks_per_chunk = k_default_blocks_per_chunk;
+        if (options_.largest_required_pool_block == 0) options_.largest_required_pool_block = k_default_largest_block;
+        if (options_.largest_required_pool_block > k_max_largest_block) options_.largest_required_pool_block = k_max_largest_block;
+        std::size_t size = k_min_block;
+        while (size < options_.largest_required_pool_block) size *= 2;
+        options_.largest_required_pool_block = size;
+        for (std::size_t s = k_min_block; s <= size; s *= 2) pools_.push_back(pool{s, 1});
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override { release(); }
+
+    // 把所有内存还给上游，包括仍在使用中的
+    void release()
+    {
+        for (pool& p : pools_) {
+            while (p.chunks) {
+                chunk_footer* next = p.chunks->next;
+                upstream_->deallocate(p.chunks->base, p.chunks->bytes, max_align);
+                p.chunks = next;
+            }
+            p.free_list = nullptr;
+            p.next_blocks = 1;
+        }
+        for (const large_block& b : large_) upstream_->deallocate(b.p, b.bytes, b.alignment);
+        large_.clear();
+    }
+
+    memory_resource* upstream_resource() const { return upstream_; }
+    pool_options options() const { return options_; }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if (is_large(bytes, alignment)) {
+            void* p = upstream_->allocate(bytes, alignment);
+            large_.push_back(large_block{p, bytes, alignment});
+            return p;
+        }
+        pool& p = pools_[pool_index(bytes, alignment)];
+        if (!p.free_list) refill(p);
+        free_block* b = p.free_list;
+        p.free_list = b->next;
+        return b;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        if (is_large(bytes, alignment)) {
+            for (std::size_t i = large_.size(); i-- > 0;) {
+                if (large_[i].p == ptr) {
+                    upstream_->deallocate(ptr, bytes, alignment);
+                    large_[i] = large_.back();
+                    large_.pop_back();
+                    return;
+                }
+            }
+            return;
+        }
+        pool& p = pools_[pool_index(bytes, alignment)];
+        p.free_list = ::new (ptr) free_block{p.free_list};
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    bool is_large(std::size_t bytes, std::size_t alignment) const
+    {
+        return bytes > options_.largest_required_pool_block || alignment > max_align;
+    }
+
+    // 内存块大小是 2 的幂且不小于对齐，大块按 max_align 对齐，块内偏移都是块大小的整数倍
+    static std::size_t pool_index(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t size = bytes > alignment ? bytes : alignment;
+        std::size_t index = 0;
+        for (std::size_t s = k_min_block; s < size; s *= 2) ++index;
+        return index;
+    }
+
+    void refill(pool& p)
+    {
+        std::size_t blocks = p.next_blocks;
+        std::size_t bytes = blocks * p.block_size + sizeof(chunk_footer);
+        char* base = static_cast<char*>(upstream_->allocate(bytes, max_align));
+        p.chunks = ::new (base + blocks * p.block_size) chunk_footer{p.chunks, base, bytes};
+        for (std::size_t i = blocks; i-- > 0;) p.free_list = ::new (base + i * p.block_size) free_block{p.free_list};
+
+        std::size_t next = blocks * 2;
+        if (next > options_.max_blocks_per_chunk) next = options_.max_blocks_per_chunk;
+        if (next * p.block_size > k_max_chunk_bytes) next = blocks;
+        p.next_blocks = next;
+    }
+};
+
+// 与 unsynchronized_pool_resource 相同，每次分配 / 释放加一把互斥锁，可以在多个线程间共享
+class synchronized_pool_resource : public memory_resource
+{
+    std::mutex mutex_;
+    unsynchronized_pool_resource pool_;
+
+public:
+    synchronized_pool_resource() = default;
+    explicit synchronized_pool_resource(memory_resource* upstream) : pool_(upstream) {}
+    explicit synchronized_pool_resource(const pool_options& opts) : pool_(opts) {}
+    synchronized_pool_resource(const pool_options& opts, memory_resource* upstream) : pool_(opts, upstream) {}
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pool_.release();
+    }
+
+    memory_resource* upstream_resource() const { return pool_.upstream_resource(); }
+    pool_options options() const { return pool_.options(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pool_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pool_.deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// ---- polymorphic_allocator ----
+// 只保存一个 memory_resource 指针。construct 按 uses-allocator 规则构造元素：元素类型声明了
+// allocator_type (mystl 的 vector / deque / string 都是) 时把自己传给元素的构造函数，
+// 嵌套容器 (pmr::vector<pmr::string>) 因此也从同一个资源分配。
+// 与 std 一样不能赋值：容器移动赋值时不会把资源一起带过去，资源不同时逐个移动元素
+template <typename Tp = std::byte>
+class polymorphic_allocator
+{
+    memory_resource* resource_;
+
+public:
+    using value_type = Tp;
+
+    polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+    polymorphic_allocator(memory_resource* r) noexcept : resource_(r) {}
+    polymorphic_allocator(const polymorphic_allocator&) = default;
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+    Tp* allocate(std::size_t n) { return static_cast<Tp*>(resource_->allocate(n * sizeof(Tp), alignof(Tp))); }
+    void deallocate(Tp* p, std::size_t n) { resource_->deallocate(p, n * sizeof(Tp), alignof(Tp)); }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        if constexpr (!std::uses_allocator<U, polymorphic_allocator>::value) {
+            ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible<U, std::allocator_arg_t, const polymorphic_allocator&, Args&&...>::value) {
+            ::new (static_cast<void*>(p)) U(std::allocator_arg, *this, std::forward<Args>(args)...);
+        } else {
+            static_assert(std::is_constructible<U, Args&&..., const polymorphic_allocator&>::value,
+                          "type uses polymorphic_allocator but has no allocator-extended constructor");
+            ::new (static_cast<void*>(p)) U(std::forward<Args>(args)..., *this);
+        }
+    }
+
+    template <typename U>
+    void destroy(U* p) { p->~U(); }
+
+    // 拷贝容器时新容器使用默认资源，而不是被拷贝容器的资源
+    polymorphic_allocator select_on_container_copy_construction() const { return polymorphic_allocator(); }
+
+    memory_resource* resource() const noexcept { return resource_; }
+
+    template <typename U>
+    friend bool operator==(const polymorphic_allocator& a, const polymorphic_allocator<U>& b) noexcept
+    {
+        return *a.resource() == *b.resource();
+    }
+    template <typename U>
+    friend bool operator!=(const polymorphic_allocator& a, const polymorphic_allocator<U>& b) noexcept
+    {
+        return !(a == b);
+    }
+};
+
+} // namespace pmr
+} // namespace mystl
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYSTL_HAS_MMAP 1
+#else
+#define MYSTL_HAS_MMAP 0
+#endif
+
+#include "memory.h"
+
+#if MYSTL_HAS_MMAP
+
+namespace mystl
+{
+
+namespace detail
+{
+// 文件开头的 64 字节：魔数、元素大小、元素个数。元素从第 64 字节开始
+struct alignas(64) mmap_vector_header
+{
+    char magic[8];
+    std::uint64_t elem_size;
+    std::uint64_t size;
+};
+
+constexpr char k_mmap_vector_magic[8] = {'M', 'Y', 'S', 'T', 'L', 'M', 'V', '1'};
+
+[[noreturn]] inline void throw_errno(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+} // namespace detail
+
+// 存放在内存映射文件中的 vector，元素必须可平凡拷贝。
+// 打开文件只需 mmap，不读取内容，页在第一次访问时才从 page cache / 磁盘换入，所以打开是 O(1) 的；
+// 扩容按 Growth (与 vector 相同) 计算新容量，ftruncate 扩展文件后 mremap 扩展映射，不拷贝已有数据。
+// 元素个数写在文件头中，修改直接落到 page cache，进程退出或崩溃都不会丢失；
+// flush() 调用 msync 等待写回磁盘，作为掉电时的持久化点。迭代器是裸指针，扩容后失效
+template <typename Tp, typename Growth = growth_double>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable<Tp>::value, "mmap_vector requires a trivially copyable element type");
+    static_assert(alignof(Tp) <= sizeof(detail::mmap_vector_header), "mmap_vector does not support over-aligned types");
+
+public:
+    using value_type      = Tp;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = pointer;
+    using const_iterator  = const_pointer;
+
+    enum class open_mode { open_or_create, create_new, open_existing };
+
+private:
+    static constexpr size_type k_header_bytes = sizeof(detail::mmap_vector_header);
+
+    int fd_ = -1;
+    void* map_ = nullptr;
+    size_type map_bytes_ = 0;
+    size_type capacity_ = 0;
+
+public:
+    mmap_vector() noexcept = default;
+
+    explicit mmap_vector(const std::string& path, open_mode mode = open_mode::open_or_create) { open(path, mode); }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    mmap_vector(mmap_vector&& other) noexcept
+        : fd_(other.fd_), map_(other.map_), map_bytes_(other.map_bytes_), capacity_(other.capacity_)
+    {
+        other.fd_ = -1;
+        other.map_ = nullptr;
+        other.map_bytes_ = 0;
+        other.capacity_ = 0;
+    }
+
+    mmap_vector& operator=(mmap_vector&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            std::swap(fd_, other.fd_);
+            std::swap(map_, other.map_);
+            std::swap(map_bytes_, other.map_bytes_);
+            std::swap(capacity_, other.capacity_);
+        }
+        return *this;
+    }
+
+    ~mmap_vector() { close(); }
+
+    // ========== 打开 / 关闭 ==========
+    // 新文件写入文件头；已有文件检查魔数和元素大小，不一致时抛出 std::runtime_error
+    void open(const std::string& path, open_mode mode = open_mode::open_or_create)
+    {
+        close();
+        int flags = O_RDWR | O_CLOEXEC;
+        if (mode == open_mode::open_or_create) flags |= O_CREAT;
+        if (mode == open_mode::create_new) flags |= O_CREAT | O_EXCL;
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) detail::throw_errno("mystl::mmap_vector: open");
+
+        try {
+            struct stat st;
+            if (::fstat(fd_, &st) != 0) detail::throw_errno("mystl::mmap_vector: fstat");
+            size_type bytes = static_cast<size_type>(st.st_size);
+            const bool fresh = bytes == 0;
+            if (fresh) {
+                bytes = file_bytes_for(0);
+                if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) detail::throw_errno("mystl::mmap_vector: ftruncate");
+            } else if (bytes < k_header_bytes) {
+                throw std::runtime_error("mystl::mmap_vector: file too small");
+            }
+            map_file(bytes);
+            if (fresh) {
+                detail::mmap_vector_header* h = header();
+                std::memcpy(h->magic, detail::k_mmap_vector_magic, sizeof(h->magic));
+                h->elem_size = sizeof(Tp);
+                h->size = 0;
+            } else {
+                const detail::mmap_vector_header* h = header();
+                if (std::memcmp(h->magic, detail::k_mmap_vector_magic, sizeof(h->magic)) != 0)
+                    throw std::runtime_error("mystl::mmap_vector: bad magic");
+                if (h->elem_size != sizeof(Tp)) throw std::runtime_error("mystl::mmap_vector: element size mismatch");
+                if (h->size > capacity_) throw std::runtime_error("mystl::mmap_vector: size exceeds file length");
+            }
+        } catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    // 解除映射并关闭文件，不等待写回磁盘
+    void close() noexcept
+    {
+        if (map_) ::munmap(map_, map_bytes_);
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+        map_ = nullptr;
+        map_bytes_ = 0;
+        capacity_ = 0;
+    }
+
+    bool is_open() const noexcept { return map_ != nullptr; }
+
+    // 等待文件头和所有元素写回磁盘
+    void flush()
+    {
+        if (map_ && ::msync(map_, map_bytes_, MS_SYNC) != 0) detail::throw_errno("mystl::mmap_vector: msync");
+    }
+
+    // ========== 元素访问 ==========
+    reference at(size_type pos)
+    {
+        if (pos < size()) return data()[pos];
+        throw std::out_of_range("mystl::mmap_vector out of range.");
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos < size()) return data()[pos];
+        throw std::out_of_range("mystl::mmap_vector out of range.");
+    }
+
+    reference operator[](size_type pos) { return data()[pos]; }
+    const_reference operator[](size_type pos) const { return data()[pos]; }
+
+    reference front() { return data()[0]; }
+    const_reference front() const { return data()[0]; }
+    reference back() { return data()[size() - 1]; }
+    const_reference back() const { return data()[size() - 1]; }
+
+    pointer data() noexcept { return map_ ? reinterpret_cast<pointer>(static_cast<char*>(map_) + k_header_bytes) : nullptr; }
+    const_pointer data() const noexcept
+    {
+        return map_ ? reinterpret_cast<const_pointer>(static_cast<const char*>(map_) + k_header_bytes) : nullptr;
+    }
+
+    // ========== 迭代器 ==========
+    iterator begin() noexcept { return data(); }
+    const_iterator begin() const noexcept { return data(); }
+    iterator end() noexcept { return data() + size(); }
+    const_iterator end() const noexcept { return data() + size(); }
+
+    // ========== 容量 ==========
+    size_type size() const noexcept { return map_ ? static_cast<size_type>(header()->size) : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    void reserve(size_type n)
+    {
+        check_open();
+        if (n > capacity_) remap(file_bytes_for(n));
+    }
+
+    // 把文件截短到刚好容纳 size() 个元素 (按页取整)
+    void shrink_to_fit()
+    {
+        const size_type bytes = file_bytes_for(size());
+        if (bytes < map_bytes_) remap(bytes);
+    }
+
+    // 新增的元素值初始化 (清零)
+    void resize(size_type n)
+    {
+        const size_type old = size();
+        if (n > capacity_) grow_to(n);
+        if (n > old) std::memset(static_cast<void*>(data() + old), 0, (n - old) * sizeof(Tp));
+        if (map_) set_size(n);
+    }
+
+    // ========== 修改 ==========
+    void push_back(const value_type& value)
+    {
+        const size_type n = size();
+        if (n == capacity_) {
+            value_type tmp(value);  // value 可能是本容器中的元素，扩容前先拷贝出来
+            grow_to(n + 1);
+            data()[n] = tmp;
+        } else {
+            data()[n] = value;
+        }
+        set_size(n + 1);
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        // 与 push_back 相同，args 可能引用本容器中的元素，mremap 可能移动映射，先构造出来再扩容
+        value_type tmp(std::forward<Args>(args)...);
+        const size_type n = size();
+        if (n == capacity_) grow_to(n + 1);
+        ::new (static_cast<void*>(data() + n)) value_type(tmp);
+        set_size(n + 1);
+    }
+
+    void pop_back() { if (size() > 0) set_size(size() - 1); }
+
+    void clear() noexcept { if (map_) set_size(0); }
+
+private:
+    detail::mmap_vector_header* header() const noexcept { return static_cast<detail::mmap_vector_header*>(map_); }
+
+    void set_size(size_type n) noexcept { header()->size = n; }
+
+    // 没有打开文件时 fd_ 为 -1，不检查的话扩容会报出令人费解的 ftruncate 错误
+    void check_open() const
+    {
+        if (!map_) throw std::runtime_error("mystl::mmap_vector: not open");
+    }
+
+    // 容纳 n 个元素的文件长度，按页取整；多出来的整页都算作容量
+    static size_type file_bytes_for(size_type n)
+    {
+        const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        const size_type bytes = k_header_bytes + n * sizeof(Tp);
+        return (bytes + page - 1) / page * page;
+    }
+
+    void map_file(size_type bytes)
+    {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) detail::throw_errno("mystl::mmap_vector: mmap");
+        map_ = p;
+        map_bytes_ = bytes;
+        capacity_ = (bytes - k_header_bytes) / sizeof(Tp);
+    }
+
+    void grow_to(size_type min_n)
+    {
+        check_open();
+        size_type n = Growth::next_capacity(capacity_, sizeof(Tp));
+        if (n < min_n) n = min_n;
+        remap(file_bytes_for(n));
+    }
+
+    // 先调整文件长度再调整映射；Linux 上用 mremap，内核只改页表，其他平台重新 mmap
+    void remap(size_type bytes)
+    {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) detail::throw_errno("mystl::mmap_vector: ftruncate");
+#if defined(__linux__)
+        void* p = ::mremap(map_, map_bytes_, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) detail::throw_errno("mystl::mmap_vector: mremap");
+        map_ = p;
+        map_bytes_ = bytes;
+        capacity_ = (bytes - k_header_bytes) / sizeof(Tp);
+#else
+        ::munmap(map_, map_bytes_);
+        map_ = nullptr;
+        map_file(bytes);
+#endif
+    }
+};
+
+} // namespace mystl
+
+#endif // MYSTL_HAS_MMAP
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MYSTL_HAS_MREMAP 1
+#else
+#define MYSTL_HAS_MREMAP 0
+#endif
+
+namespace mystl
+{
+
+namespace detail
+{
+// 小于该字节数的块走 malloc，大块直接向内核申请匿名页
+constexpr std::size_t k_page_alloc_threshold = std::size_t(1) << 20;
+
+inline bool is_page_block(std::size_t bytes) { return MYSTL_HAS_MREMAP && bytes >= k_page_alloc_threshold; }
+
+#if MYSTL_HAS_MREMAP
+inline std::size_t page_size()
+{
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+inline std::size_t round_up_pages(std::size_t bytes)
+{
+    const std::size_t page = detail::page_size();
+    return (bytes + page - 1) / page * page;
+}
+
+inline void* page_map(std::size_t bytes)
+{
+    void* p = ::mmap(nullptr, detail::round_up_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    return p;
+}
+
+inline void page_unmap(void* p, std::size_t bytes) { ::munmap(p, detail::round_up_pages(bytes)); }
+
+// 内核只修改页表：原地放得下就原地扩展，否则把页整体换到新的虚拟地址，都不拷贝数据
+inline void* page_remap(void* p, std::size_t old_bytes, std::size_t new_bytes)
+{
+    void* q = ::mremap(p, detail::round_up_pages(old_bytes), detail::round_up_pages(new_bytes), MREMAP_MAYMOVE);
+    if (q == MAP_FAILED) throw std::bad_alloc();
+    return q;
+}
+#else
+inline void* page_map(std::size_t) { throw std::bad_alloc(); }
+inline void page_unmap(void*, std::size_t) {}
+inline void* page_remap(void*, std::size_t, std::size_t) { throw std::bad_alloc(); }
+#endif
+
+inline void* malloc_or_throw(std::size_t bytes)
+{
+    void* p = std::malloc(bytes);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+} // namespace detail
+
+// 页分配器：大块（>= 1MB）用匿名 mmap，小块用 malloc。
+// 额外提供 reallocate：两端都是大块时用 mremap 调整大小，不拷贝、也不会同时占用新旧两份内存。
+// mystl::vector 检测到分配器有 reallocate 且元素可平凡重定位时，扩容直接调用它。
+// 非 Linux 平台上全部走 malloc / realloc
+template <typename Tp>
+class page_allocator
+{
+    static_assert(alignof(Tp) <= alignof(std::max_align_t), "page_allocator does not support over-aligned types");
+
+public:
+    using value_type = Tp;
+    using size_type  = std::size_t;
+
+    template <typename U>
+    struct rebind { using other = page_allocator<U>; };
+
+    page_allocator() noexcept = default;
+    template <typename U>
+    page_allocator(const page_allocator<U>&) noexcept {}
+
+    Tp* allocate(size_type n)
+    {
+        if (n == 0) return nullptr;
+        const size_type bytes = n * sizeof(Tp);
+        return static_cast<Tp*>(detail::is_page_block(bytes) ? detail::page_map(bytes) : detail::malloc_or_throw(bytes));
+    }
+
+    void deallocate(Tp* p, size_type n) noexcept
+    {
+        if (!p) return;
+        const size_type bytes = n * sizeof(Tp);
+        if (detail::is_page_block(bytes)) detail::page_unmap(p, bytes);
+        else std::free(p);
+    }
+
+    // 把 p 处 old_n 个元素的空间调整为 new_n 个，前 min(old_n, new_n) 个元素按字节保留。
+    // 只能用于可平凡重定位的元素
+    Tp* reallocate(Tp* p, size_type old_n, size_type new_n)
+    {
+        if (!p) return allocate(new_n);
+        if (new_n == 0) {
+            deallocate(p, old_n);
+            return nullptr;
+        }
+        const size_type old_bytes = old_n * sizeof(Tp);
+        const size_type new_bytes = new_n * sizeof(Tp);
+        const bool old_page = detail::is_page_block(old_bytes);
+        const bool new_page = detail::is_page_block(new_bytes);
+        if (old_page && new_page) return static_cast<Tp*>(detail::page_remap(p, old_bytes, new_bytes));
+        if (!old_page && !new_page) {
+            void* q = std::realloc(p, new_bytes);
+            if (!q) throw std::bad_alloc();
+            return static_cast<Tp*>(q);
+        }
+        // 跨越阈值时只能拷贝一次
+        Tp* q = allocate(new_n);
+        std::memcpy(static_cast<void*>(q), static_cast<const void*>(p), old_bytes < new_bytes ? old_bytes : new_bytes);
+        deallocate(p, old_n);
+        return q;
+    }
+
+    template <typename U>
+    friend bool operator==(const page_allocator&, const page_allocator<U>&) noexcept { return true; }
+    template <typename U>
+    friend bool operator!=(const page_allocator&, const page_allocator<U>&) noexcept { return false; }
+};
+
+} // namespace mystl
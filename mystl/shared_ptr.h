@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <utility>
 
+#include "type_traits.h"
 #include "utility.h"
 
 namespace mystl
@@ -51,7 +53,7 @@ private:
 public:
     template<typename... Args>
     explicit ctrl_block_inplace(Args&&... args) {
-        new (storage_) T(forward<Args>(args)...);
+        new (storage_) T(mystl::forward<Args>(args)...);
         constructed_ = true;
     }
 
@@ -69,6 +71,42 @@ public:
     }
 };
 
+// allocate_shared 使用的控制块：对象和控制块一次分配，内存来自 Alloc，
+// 控制块中保存一份重新绑定的分配器，最后一个引用释放时用它析构并归还自己
+template<typename T, typename Alloc>
+class ctrl_block_alloc : public ctrl_block_base
+{
+public:
+    using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<ctrl_block_alloc>;
+
+private:
+    block_allocator alloc_;
+    alignas(T) unsigned char storage_[sizeof(T)];
+    bool constructed_{false};
+
+public:
+    template<typename... Args>
+    explicit ctrl_block_alloc(const Alloc& alloc, Args&&... args) : alloc_(alloc) {
+        new (storage_) T(mystl::forward<Args>(args)...);
+        constructed_ = true;
+    }
+
+    T *get_ptr() { return reinterpret_cast<T *>(storage_); }
+
+    void destroy_object() override {
+        if (constructed_) {
+            get_ptr()->~T();
+            constructed_ = false;
+        }
+    }
+
+    void destroy_ctrl_block() override {
+        block_allocator alloc(std::move(alloc_));
+        this->~ctrl_block_alloc();
+        std::allocator_traits<block_allocator>::deallocate(alloc, this, 1);
+    }
+};
+
 inline void incref_shared(ctrl_block_base* cb) {
     if (cb) cb->shared_count_.fetch_add(1, std::memory_order_relaxed);
 }
@@ -207,6 +245,9 @@ private:
 
     template <typename U, typename... Args>
     friend shared_ptr<U> make_shared(Args&&...args);
+
+    template <typename U, typename Alloc, typename... Args>
+    friend shared_ptr<U> allocate_shared(const Alloc& alloc, Args&&...args);
 };
 
 template<typename Tp>
@@ -300,6 +341,13 @@ public:
     }
 };
 
+// 只保存对象指针和控制块指针，引用计数在控制块中，搬动不需要改计数
+template <typename Tp>
+struct is_trivially_relocatable<shared_ptr<Tp>> : std::true_type {};
+
+template <typename Tp>
+struct is_trivially_relocatable<weak_ptr<Tp>> : std::true_type {};
+
 template<typename Tp>
 shared_ptr<Tp>::shared_ptr(const weak_ptr<Tp>& wp)
     : ptr_(nullptr), ctrl_block_(nullptr) {
@@ -318,4 +366,20 @@ shared_ptr<Tp> make_shared(Args&&... args) {
     return shared_ptr<Tp>(cb->get_ptr(), cb);
 }
 
+// 与 make_shared 相同，但控制块和对象的内存由 alloc 分配
+template <typename Tp, typename Alloc, typename... Args>
+shared_ptr<Tp> allocate_shared(const Alloc& alloc, Args&&... args) {
+    using block = detail::ctrl_block_alloc<Tp, Alloc>;
+    using traits = std::allocator_traits<typename block::block_allocator>;
+    typename block::block_allocator a(alloc);
+    block *cb = traits::allocate(a, 1);
+    try {
+        new (cb) block(alloc, std::forward<Args>(args)...);
+    } catch (...) {
+        traits::deallocate(a, cb, 1);
+        throw;
+    }
+    return shared_ptr<Tp>(cb->get_ptr(), cb);
+}
+
 } // mystl
\ No newline at end of file
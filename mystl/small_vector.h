@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+
+#include "memory.h"
+
+namespace mystl
+{
+
+// 带内联缓冲区的 vector：不超过 N 个元素时存放在对象内部，不申请堆内存；
+// 超过 N 个元素后与 mystl::vector 一样按 2 倍扩容到 allocator 申请的空间。
+// 接口与 mystl::vector 相同。shrink_to_fit 在元素个数回到 N 以内时搬回内联缓冲区。
+// 代价：对象本身多占 N * sizeof(Tp) 字节；移动内联存储的对象需要逐个移动元素，不能只交换指针
+template <typename Tp, size_t N, typename Alloc = std::allocator<Tp>>
+class small_vector
+{
+    static_assert(N > 0, "small_vector requires N > 0, use mystl::vector instead");
+
+public:
+    using value_type      = Tp;
+    using allocator_type  = Alloc;
+    using size_type       = size_t;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+    using pointer         = value_type *;
+    using const_pointer   = const value_type *;
+
+    using iterator        = pointer;
+    using const_iterator  = const_pointer;
+
+    static constexpr size_type inline_capacity = N;
+
+private:
+    size_type size_;
+    size_type capacity_;
+    pointer data_;      // 指向 inline_ 或堆上的空间
+    allocator_type allocator_;
+    alignas(Tp) unsigned char inline_[N * sizeof(Tp)];
+
+public:
+    // ========== Constructors / Destructor ==========
+    small_vector() noexcept : size_(0), capacity_(N), data_(inline_data()) {}
+
+    explicit small_vector(size_type n) : small_vector()
+    {
+        reserve(n);
+        for (; size_ < n; ++size_)
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_);
+    }
+
+    small_vector(std::initializer_list<value_type> ilist) : small_vector()
+    {
+        reserve(ilist.size());
+        for (const auto& val : ilist)
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_++, val);
+    }
+
+    small_vector(const small_vector& other) : small_vector()
+    {
+        reserve(other.size_);
+        for (; size_ < other.size_; ++size_)
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_, other.data_[size_]);
+    }
+
+    // 对方在堆上时直接接管指针；在内联缓冲区时只能逐个移动元素
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<Tp>::value)
+        : small_vector()
+    {
+        steal(other);
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release();
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (; size_ < other.size_; ++size_)
+                std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_, other.data_[size_]);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<Tp>::value)
+    {
+        if (this != &other) {
+            clear();
+            release();
+            data_ = inline_data();
+            capacity_ = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_; }
+
+    // ========== 元素访问 ==========
+    reference at(size_type pos)
+    {
+        if (pos < size_) return data_[pos];
+        else throw std::out_of_range("mystl::small_vector out of range.");
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos < size_) return data_[pos];
+        else throw std::out_of_range("mystl::small_vector out of range.");
+    }
+
+    reference operator[](size_type i) { return data_[i]; }
+    const_reference operator[](size_type i) const { return data_[i]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    iterator data() { return data_; }
+
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator data() const { return data_; }
+
+    // ========== 容量 ==========
+    // 扩容，reserve 只能扩容；n 不超过 N 时什么也不做
+    void reserve(size_type n)
+    {
+        if (n <= capacity_) return;
+        pointer new_data = allocator_.allocate(n);
+        relocate(new_data);
+        release();
+        capacity_ = n;
+        data_ = new_data;
+    }
+
+    // 元素个数不超过 N 时搬回内联缓冲区并释放堆内存，否则收缩到恰好 size() 的堆空间
+    void shrink_to_fit()
+    {
+        if (is_inline() || size_ == capacity_) return;
+        pointer new_data = size_ <= N ? inline_data() : allocator_.allocate(size_);
+        relocate(new_data);
+        release();
+        capacity_ = size_ <= N ? N : size_;
+        data_ = new_data;
+    }
+
+    void resize(size_type n)
+    {
+        reserve(n);
+        for (size_type i = size_; i < n; ++i)
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + i);
+        for (size_type i = n; i < size_; ++i)
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+        size_ = n;
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // 元素是否存放在内联缓冲区中
+    bool is_inline() const { return data_ == inline_data(); }
+
+    // ========== 修改器 ==========
+private:
+    pointer inline_data() { return reinterpret_cast<pointer>(inline_); }
+    const_pointer inline_data() const { return reinterpret_cast<const_pointer>(inline_); }
+
+    // args 可能引用本容器中的元素 (v.push_back(v[0]))：扩容时先在新空间中构造新元素，再搬移旧元素
+    template<typename... Args>
+    void construct_at_back(Args&&... args)
+    {
+        if (size_ < capacity_) {
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+            return;
+        }
+        const size_type new_cap = capacity_ * 2;
+        pointer new_data = allocator_.allocate(new_cap);
+        try {
+            std::allocator_traits<allocator_type>::construct(allocator_, new_data + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_data, new_cap);
+            throw;
+        }
+        relocate(new_data);
+        release();
+        capacity_ = new_cap;
+        data_ = new_data;
+        ++size_;
+    }
+
+    void grow() { reserve(capacity_ * 2); }
+
+    // 把全部元素移动到 dst 并析构原位置的元素，不改变 size_
+    void relocate(pointer dst) { mystl::uninitialized_relocate_n(allocator_, data_, size_, dst); }
+
+    // 释放堆上的空间（如果有），不析构元素
+    void release()
+    {
+        if (!is_inline()) allocator_.deallocate(data_, capacity_);
+    }
+
+    // 要求 *this 为空且使用内联缓冲区
+    void steal(small_vector& other)
+    {
+        if (other.is_inline()) {
+            for (; size_ < other.size_; ++size_)
+                std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_, std::move(other.data_[size_]));
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+public:
+    // 添加一个数据
+    void push_back(const value_type& val) { construct_at_back(val); }
+
+    // 移动添加一个数据
+    void push_back(value_type&& val) { construct_at_back(std::move(val)); }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args) { construct_at_back(std::forward<Args>(args)...); }
+
+    template<typename... Args>
+    void insert(size_type pos, Args&&... args)
+    {
+        if (pos > size_) return;
+
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            // 与 mystl::vector::insert 相同：先构造到临时空间，再整体后移、按字节搬入
+            alignas(value_type) unsigned char buf[sizeof(value_type)];
+            pointer tmp = reinterpret_cast<pointer>(buf);
+            std::allocator_traits<allocator_type>::construct(allocator_, tmp, std::forward<Args>(args)...);
+            if (size_ == capacity_) {
+                try {
+                    grow();
+                } catch (...) {
+                    std::allocator_traits<allocator_type>::destroy(allocator_, tmp);
+                    throw;
+                }
+            }
+            mystl::relocate_overlapping_n(data_ + pos, size_ - pos, data_ + pos + 1);
+            mystl::uninitialized_relocate_n(allocator_, tmp, 1, data_ + pos);
+            ++size_;
+            return;
+        }
+
+        // args 可能引用本容器中的元素，扩容和后移都会把它变成被移走的对象，先构造出临时对象
+        value_type tmp(std::forward<Args>(args)...);
+        if (size_ == capacity_) grow();
+
+        for (size_type i = size_; i > pos; --i){
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + i, std::move_if_noexcept(data_[i - 1]));
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i - 1);
+        }
+
+        std::allocator_traits<allocator_type>::construct(allocator_, data_ + pos, std::move(tmp));
+        ++size_;
+    }
+
+    // 删除一个数据
+    void erase(size_type pos)
+    {
+        if (pos >= size_) return;
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + pos);
+            mystl::relocate_overlapping_n(data_ + pos + 1, size_ - pos - 1, data_ + pos);
+            --size_;
+            return;
+        }
+        if (pos + 1 < size_) {
+            std::move(data_ + pos + 1, data_ + size_, data_ + pos);
+        }
+        std::allocator_traits<allocator_type>::destroy(allocator_, data_ + size_ - 1);
+        --size_;
+    }
+
+    void pop_back()
+    {
+        if (size_ > 0)
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + --size_);
+    }
+
+    void clear()
+    {
+        for (size_type i = 0; i < size_; ++i){
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+        }
+        size_ = 0;
+    }
+
+};
+
+} // namespace mystl
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aligned_allocator.h"
+#include "algorithm/sort.h"
+#include "iterator.h"
+#include "span.h"
+#include "vector.h"
+
+namespace mystl
+{
+
+// 结构体数组 (SoA)：记录的每个字段存放在各自连续的列中。
+// 热循环只扫描一两个字段时只读取这些列，不会把整条记录的其余字段一起带进缓存。
+// 每一列是使用 aligned_allocator<F, 64> 的 mystl::vector，扩容、平凡重定位都沿用 vector 的实现；
+// 列首按 64 字节对齐，容量是一个 SIMD 宽度的整数倍，column<I>() 可以直接交给 SIMD 内核。
+// 按行访问返回由各字段引用组成的 tuple（代理引用），不存在真正的记录对象
+template <typename... Fields>
+class soa_vector
+{
+    static_assert(sizeof...(Fields) > 0, "soa_vector requires at least one field");
+
+public:
+    static constexpr std::size_t column_alignment = 64;
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using value_type      = std::tuple<Fields...>;
+    using reference       = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <bool Const>
+    class row_iterator;
+
+    using iterator       = row_iterator<false>;
+    using const_iterator = row_iterator<true>;
+
+private:
+    using indices = std::index_sequence_for<Fields...>;
+
+    std::tuple<vector<Fields, aligned_allocator<Fields, column_alignment>>...> columns_;
+
+public:
+    soa_vector() = default;
+
+    // ========== 容量 ==========
+    size_type size() const noexcept { return std::get<0>(columns_).size(); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // 各列容量的最小值
+    size_type capacity() const noexcept { return capacity_impl(indices{}); }
+
+    // reserve 只改变容量，中途抛出异常时各列长度仍然一致，capacity() 取各列的最小值
+    void reserve(size_type n) { for_each_column([n](auto& col) { col.reserve(n); }); }
+    void shrink_to_fit() { for_each_column([](auto& col) { col.shrink_to_fit(); }); }
+    // 某一列扩大失败时，已经扩大的列缩回原来的长度，各列长度保持一致
+    void resize(size_type n) { resize_columns(n, indices{}); }
+    void clear() noexcept { for_each_column([](auto& col) { col.clear(); }); }
+
+    // ========== 按行访问 ==========
+    reference operator[](size_type i) { return row(i, indices{}); }
+    const_reference operator[](size_type i) const { return row(i, indices{}); }
+
+    reference at(size_type i)
+    {
+        if (i < size()) return (*this)[i];
+        throw std::out_of_range("mystl::soa_vector out of range.");
+    }
+
+    const_reference at(size_type i) const
+    {
+        if (i < size()) return (*this)[i];
+        throw std::out_of_range("mystl::soa_vector out of range.");
+    }
+
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // ========== 按列访问 ==========
+    template <std::size_t I>
+    span<field_type<I>> column() { return span<field_type<I>>(std::get<I>(columns_).data(), size()); }
+
+    template <std::size_t I>
+    span<const field_type<I>> column() const { return span<const field_type<I>>(std::get<I>(columns_).data(), size()); }
+
+    // 把第 I 列 [size(), 补齐到 64 字节的长度) 的填充区写成 value，SIMD 循环随后可以整块处理尾部
+    template <std::size_t I>
+    void fill_padding(const field_type<I>& value = field_type<I>())
+    {
+        mystl::fill_padding<column_alignment>(std::get<I>(columns_), value);
+    }
+
+    // ========== 修改 ==========
+    // 每个参数构造一个字段。某一列构造失败时，已经追加的列回滚，各列长度保持一致
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "soa_vector::emplace_back takes one argument per field");
+        emplace_columns(indices{}, std::forward<Args>(args)...);
+    }
+
+    void push_back(const value_type& rec) { push_tuple(rec, indices{}); }
+    void push_back(value_type&& rec) { push_tuple(std::move(rec), indices{}); }
+
+    void pop_back() { for_each_column([](auto& col) { col.pop_back(); }); }
+
+    // ========== 排序 ==========
+    // 新的第 i 行是原来的第 perm[i] 行，perm 必须是 [0, size()) 的一个排列。
+    // 每一列单独按 perm 收集到新的列中，列与列之间互不干扰
+    template <typename Perm>
+    void apply_permutation(const Perm& perm)
+    {
+        for_each_column([&perm](auto& col) {
+            using column_t = std::remove_reference_t<decltype(col)>;
+            using field_t = typename column_t::value_type;
+            column_t tmp;
+            if constexpr (std::is_trivially_copyable<field_t>::value) {
+                tmp.resize_for_overwrite(col.size());
+                for (size_type i = 0; i < col.size(); ++i) tmp[i] = col[perm[i]];
+            } else {
+                tmp.reserve(col.size());
+                for (size_type i = 0; i < col.size(); ++i) tmp.emplace_back(std::move(col[perm[i]]));
+            }
+            col = std::move(tmp);
+        });
+    }
+
+    // 按第 I 列排序，键相等的行保持原来的相对顺序。
+    // 只对 (键, 行号) 排序得到排列，然后逐列重排，不搬动整条记录
+    template <std::size_t I, typename Compare = std::less<>>
+    void sort_by(Compare comp = {})
+    {
+        apply_permutation(sorted_permutation<I>(comp));
+    }
+
+    // 按整行排序，comp 接受两个 const_reference
+    template <typename Compare>
+    void sort(Compare comp)
+    {
+        vector<size_type> perm(size());
+        for (size_type i = 0; i < perm.size(); ++i) perm[i] = i;
+        mystl::sort(perm.begin(), perm.end(), [this, &comp](size_type a, size_type b) {
+            if (comp((*this)[a], (*this)[b])) return true;
+            return !comp((*this)[b], (*this)[a]) && a < b;
+        });
+        apply_permutation(perm);
+    }
+
+    // 按第 I 列排序后的排列 (不修改容器)
+    template <std::size_t I, typename Compare = std::less<>>
+    vector<size_type> sorted_permutation(Compare comp = {}) const
+    {
+        const auto& key = std::get<I>(columns_);
+        vector<size_type> perm(size());
+        if constexpr (std::is_arithmetic<field_type<I>>::value) {
+            // 键是数值时拷贝出 (键, 行号) 连续排序，避免按行号间接访问键列
+            // 升序且键是 radix_sort 支持的类型时用稳定的基数排序；bool、long double 和其他比较器
+            // 用比较排序并以行号决定相等键的先后
+            vector<std::pair<field_type<I>, size_type>> keyed(size());
+            for (size_type i = 0; i < keyed.size(); ++i) keyed[i] = {key[i], i};
+            if constexpr (detail::is_radix_key<field_type<I>>::value &&
+                          (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<field_type<I>>>::value)) {
+                mystl::radix_sort(keyed.begin(), keyed.end(), [](const auto& kv) { return kv.first; });
+            } else {
+                mystl::sort(keyed.begin(), keyed.end(), [&comp](const auto& a, const auto& b) {
+                    if (comp(a.first, b.first)) return true;
+                    return !comp(b.first, a.first) && a.second < b.second;
+                });
+            }
+            for (size_type i = 0; i < keyed.size(); ++i) perm[i] = keyed[i].second;
+        } else {
+            for (size_type i = 0; i < perm.size(); ++i) perm[i] = i;
+            mystl::sort(perm.begin(), perm.end(), [&key, &comp](size_type a, size_type b) {
+                if (comp(key[a], key[b])) return true;
+                return !comp(key[b], key[a]) && a < b;
+            });
+        }
+        return perm;
+    }
+
+private:
+    template <typename Func>
+    void for_each_column(Func func)
+    {
+        std::apply([&func](auto&... col) { (func(col), ...); }, columns_);
+    }
+
+    template <std::size_t... I>
+    size_type capacity_impl(std::index_sequence<I...>) const noexcept
+    {
+        size_type cap = std::get<0>(columns_).capacity();
+        ((cap = std::get<I>(columns_).capacity() < cap ? std::get<I>(columns_).capacity() : cap), ...);
+        return cap;
+    }
+
+    template <std::size_t... I>
+    reference row(size_type i, std::index_sequence<I...>) { return reference(std::get<I>(columns_)[i]...); }
+
+    template <std::size_t... I>
+    const_reference row(size_type i, std::index_sequence<I...>) const { return const_reference(std::get<I>(columns_)[i]...); }
+
+    template <std::size_t... I, typename... Args>
+    void emplace_columns(std::index_sequence<I...>, Args&&... args)
+    {
+        std::size_t done = 0;
+        try {
+            ((std::get<I>(columns_).emplace_back(std::forward<Args>(args)), ++done), ...);
+        } catch (...) {
+            ((I < done ? std::get<I>(columns_).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... I>
+    void resize_columns(size_type n, std::index_sequence<I...>)
+    {
+        const size_type old = size();
+        std::size_t done = 0;
+        try {
+            ((std::get<I>(columns_).resize(n), ++done), ...);
+        } catch (...) {
+            ((I < done ? std::get<I>(columns_).resize(old) : void()), ...);
+            throw;
+        }
+    }
+
+    template <typename Tuple, std::size_t... I>
+    void push_tuple(Tuple&& rec, std::index_sequence<I...>)
+    {
+        emplace_columns(indices{}, std::get<I>(std::forward<Tuple>(rec))...);
+    }
+
+public:
+    // 行迭代器，解引用得到代理引用 (tuple of references)。
+    // 与 vector<bool> 一样不是真正的随机访问迭代器，不能交给 std::sort，排序请用 sort / sort_by
+    template <bool Const>
+    class row_iterator
+    {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+        owner* vec_;
+        size_type i_;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = soa_vector::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::conditional_t<Const, soa_vector::const_reference, soa_vector::reference>;
+        using pointer           = void;
+
+        row_iterator() : vec_(nullptr), i_(0) {}
+        row_iterator(owner* vec, size_type i) : vec_(vec), i_(i) {}
+
+        reference operator*() const { return (*vec_)[i_]; }
+        reference operator[](difference_type n) const { return (*vec_)[i_ + n]; }
+        size_type index() const { return i_; }
+
+        row_iterator& operator++() { ++i_; return *this; }
+        row_iterator operator++(int) { row_iterator t = *this; ++i_; return t; }
+        row_iterator& operator--() { --i_; return *this; }
+        row_iterator operator--(int) { row_iterator t = *this; --i_; return t; }
+        row_iterator& operator+=(difference_type n) { i_ += n; return *this; }
+        row_iterator& operator-=(difference_type n) { i_ -= n; return *this; }
+        row_iterator operator+(difference_type n) const { return row_iterator(vec_, i_ + n); }
+        row_iterator operator-(difference_type n) const { return row_iterator(vec_, i_ - n); }
+        friend row_iterator operator+(difference_type n, const row_iterator& it) { return it + n; }
+        friend difference_type operator-(const row_iterator& a, const row_iterator& b)
+        {
+            return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+        }
+
+        friend bool operator==(const row_iterator& a, const row_iterator& b) { return a.i_ == b.i_; }
+        friend bool operator!=(const row_iterator& a, const row_iterator& b) { return a.i_ != b.i_; }
+        friend bool operator<(const row_iterator& a, const row_iterator& b) { return a.i_ < b.i_; }
+        friend bool operator>(const row_iterator& a, const row_iterator& b) { return b.i_ < a.i_; }
+        friend bool operator<=(const row_iterator& a, const row_iterator& b) { return !(b.i_ < a.i_); }
+        friend bool operator>=(const row_iterator& a, const row_iterator& b) { return !(a.i_ < b.i_); }
+    };
+};
+
+// 只包含各列的 vector，各列可以按字节搬动时整体也可以
+template <typename... Fields>
+struct is_trivially_relocatable<soa_vector<Fields...>>
+    : std::conjunction<is_trivially_relocatable<vector<Fields, aligned_allocator<Fields, 64>>>...> {};
+
+} // namespace mystl
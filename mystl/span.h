@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace mystl
+{
+
+// 连续内存的非拥有视图 (C++20 std::span 的动态长度版本)，迭代器是裸指针
+template <typename Tp>
+class span
+{
+public:
+    using element_type    = Tp;
+    using value_type      = std::remove_cv_t<Tp>;
+    using size_type       = std::size_t;
+    using pointer         = Tp*;
+    using reference       = Tp&;
+    using iterator        = pointer;
+
+    constexpr span() noexcept : data_(nullptr), size_(0) {}
+    constexpr span(pointer data, size_type size) noexcept : data_(data), size_(size) {}
+
+    // span<T> 可以转换为 span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], Tp (*)[]>::value>>
+    constexpr span(const span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr pointer data() const noexcept { return data_; }
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type size_bytes() const noexcept { return size_ * sizeof(Tp); }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr reference operator[](size_type i) const { return data_[i]; }
+    constexpr reference front() const { return data_[0]; }
+    constexpr reference back() const { return data_[size_ - 1]; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    constexpr span first(size_type n) const { return span(data_, n); }
+    constexpr span last(size_type n) const { return span(data_ + size_ - n, n); }
+    constexpr span subspan(size_type offset, size_type n) const { return span(data_ + offset, n); }
+    constexpr span subspan(size_type offset) const { return span(data_ + offset, size_ - offset); }
+
+private:
+    pointer data_;
+    size_type size_;
+};
+
+} // namespace mystl
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mystl
+{
+
+// 工作窃取线程池
+// 每个工作线程有自己的任务队列：自己从队尾取（LIFO，缓存友好），
+// 空闲时从别的队列队首偷（FIFO，偷到的往往是更大的任务）。
+// thread_pool(n) 只创建 n - 1 个后台线程，调用 task_group::wait 的线程作为第 n 个参与者，
+// 因此 thread_pool(1) 会在 wait 中串行执行所有任务。
+class thread_pool
+{
+public:
+    using task_type = std::function<void()>;
+
+    explicit thread_pool(std::size_t threads = hardware_threads())
+        : threads_(std::max<std::size_t>(threads, 1)), queues_(threads_)
+    {
+        for (std::size_t i = 0; i < threads_; ++i)
+            queues_[i] = std::make_unique<work_queue>();
+        for (std::size_t i = 1; i < threads_; ++i)
+            workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    // 参与计算的线程数（含调用 wait 的线程）
+    std::size_t size() const noexcept { return threads_; }
+
+    // 工作线程提交到自己的队列，外部线程轮流提交到各个队列
+    void submit(task_type task)
+    {
+        std::size_t index = current_index();
+        if (index == npos)
+            index = next_queue_.fetch_add(1, std::memory_order_relaxed) % threads_;
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    // 取一个任务执行：先看自己的队列，再去偷别人的。没有任务时返回 false
+    bool try_run_one()
+    {
+        std::size_t self = current_index();
+        std::size_t start = self == npos ? 0 : self;
+        task_type task;
+        if (self != npos && pop_back(self, task)) {
+            run(task);
+            return true;
+        }
+        for (std::size_t k = 0; k < threads_; ++k) {
+            std::size_t victim = (start + k) % threads_;
+            if (victim != self && steal_front(victim, task)) {
+                run(task);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 进程级默认线程池，线程数为硬件并发数
+    static thread_pool& default_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    static std::size_t hardware_threads()
+    {
+        return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct work_queue
+    {
+        std::mutex mutex;
+        std::deque<task_type> tasks;
+    };
+
+    // 记录当前线程属于哪个线程池的哪个队列
+    struct worker_info
+    {
+        const thread_pool* pool = nullptr;
+        std::size_t index = npos;
+    };
+
+    static worker_info& this_worker()
+    {
+        static thread_local worker_info info;
+        return info;
+    }
+
+    std::size_t current_index() const
+    {
+        const worker_info& info = this_worker();
+        return info.pool == this ? info.index : npos;
+    }
+
+    bool pop_back(std::size_t index, task_type& task)
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        auto& q = queues_[index]->tasks;
+        if (q.empty()) return false;
+        task = std::move(q.back());
+        q.pop_back();
+        return true;
+    }
+
+    bool steal_front(std::size_t index, task_type& task)
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        auto& q = queues_[index]->tasks;
+        if (q.empty()) return false;
+        task = std::move(q.front());
+        q.pop_front();
+        return true;
+    }
+
+    void run(task_type& task)
+    {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+        task();
+    }
+
+    void worker_loop(std::size_t index)
+    {
+        this_worker() = {this, index};
+        while (true) {
+            if (try_run_one()) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleep_cv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stop_ && queued_.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+
+private:
+    std::size_t threads_;
+    std::vector<std::unique_ptr<work_queue>> queues_; // queues_[0] 属于调用 wait 的外部线程
+    std::vector<std::thread> workers_;
+
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> next_queue_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+};
+
+// 一组 fork-join 任务：run 派生子任务，wait 等待全部完成。
+// 等待期间当前线程会帮忙执行池中的任务，因此可以在任务内部递归使用而不会死锁。
+// 子任务抛出的第一个异常会在 wait 中重新抛出。
+class task_group
+{
+public:
+    explicit task_group(thread_pool& pool = thread_pool::default_pool()) : pool_(pool) {}
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    ~task_group()
+    {
+        if (pending_.load(std::memory_order_acquire) > 0) wait_all();
+    }
+
+    template <typename Func>
+    void run(Func&& func)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, f = std::forward<Func>(func)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            pending_.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    void wait()
+    {
+        wait_all();
+        if (error_) {
+            std::exception_ptr e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    thread_pool& pool() noexcept { return pool_; }
+
+private:
+    void wait_all()
+    {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.try_run_one()) std::this_thread::yield();
+        }
+    }
+
+    thread_pool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+} // namespace mystl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 namespace mystl
 {
 template <typename T>
@@ -15,4 +17,14 @@ struct remove_reference<T&&> { using type = T; };
 
 template <typename T>
 using remove_reference_t = typename remove_reference<T>::type;
-}
\ No newline at end of file
+
+// 可平凡重定位：把对象按字节拷贝到新地址、且不再对旧地址调用析构，等价于“移动构造 + 析构旧对象”。
+// 默认只有可平凡拷贝的类型满足；不保存指向自身的指针的类型（mystl 的智能指针、string、vector 等）
+// 在各自的头文件中特化为 true。自定义类型满足条件时可以自行特化：
+//   template <> struct mystl::is_trivially_relocatable<MyType> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+}
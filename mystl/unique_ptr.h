@@ -1,5 +1,6 @@
 #pragma once
 
+#include "type_traits.h"
 #include "utility.h"
 
 namespace mystl
@@ -81,6 +82,9 @@ private:
     Tp *data_;
 };
 
+template <typename Tp, typename Deleter>
+struct is_trivially_relocatable<unique_ptr<Tp, Deleter>> : is_trivially_relocatable<Deleter> {};
+
 template <typename Tp, typename... Arg>
 unique_ptr<Tp> make_unique(Arg&&... arg) {
     return unique_ptr<Tp>(new Tp(forward<Arg>(arg)...));
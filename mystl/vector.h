@@ -3,13 +3,22 @@
 #include <algorithm>
 #include <initializer_list>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
 #include <stdexcept>
 
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+
 namespace mystl
 {
 
-template <typename Tp, typename Alloc = std::allocator<Tp>>
+// Growth 为扩容策略（见 memory.h）。分配器提供 reallocate 且元素可平凡重定位时，
+// reserve / shrink_to_fit 直接调用它调整空间（page_allocator 的大块用 mremap，不拷贝）。
+// 分配器声明了 alignment（aligned_allocator）时容量总是一个 SIMD 宽度的整数倍
+template <typename Tp, typename Alloc = std::allocator<Tp>, typename Growth = growth_double>
 class vector
 {
 public:
@@ -35,16 +44,24 @@ public:
     // Default constructor
     vector() noexcept : size_(0), capacity_(0), data_(nullptr) {}
 
+    explicit vector(const allocator_type& alloc) noexcept : size_(0), capacity_(0), data_(nullptr), allocator_(alloc) {}
+
     // Fill constructor (n default-initialized elements)
-    explicit vector(size_type n) : size_(n), capacity_(n), data_(nullptr)
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : size_(n), capacity_(detail::round_up_capacity<Alloc>(n)), data_(nullptr), allocator_(alloc)
     {
         data_ = allocator_.allocate(capacity_);
         for (size_t i = 0; i < size_; ++i)
             std::allocator_traits<allocator_type>::construct(allocator_, data_ + i);
     }
 
-    vector(std::initializer_list<value_type> ilist)
-        : size_(ilist.size()), capacity_(ilist.size()), data_(nullptr)
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) : vector(alloc) { assign(n, value); }
+
+    template <typename Iter, typename = std::enable_if_t<is_input_iterator<Iter>::value>>
+    vector(Iter first, Iter last, const allocator_type& alloc = allocator_type()) : vector(alloc) { assign(first, last); }
+
+    vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : size_(ilist.size()), capacity_(detail::round_up_capacity<Alloc>(ilist.size())), data_(nullptr), allocator_(alloc)
     {
         data_ = allocator_.allocate(capacity_);
         size_type i = 0;
@@ -54,7 +71,10 @@ public:
 
     // 拷贝构造
     vector(const vector & other)
-        : size_(other.size_), capacity_(other.capacity_), data_(nullptr)
+        : vector(other, std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.allocator_)) {}
+
+    vector(const vector & other, const allocator_type& alloc)
+        : size_(other.size_), capacity_(other.capacity_), data_(nullptr), allocator_(alloc)
     {
         data_ = allocator_.allocate(capacity_);
         for (size_type i = 0; i < size_; ++i)
@@ -62,13 +82,25 @@ public:
     }
 
     vector(vector && other) noexcept
-        : size_(other.size_), capacity_(other.capacity_), data_(other.data_)
+        : size_(other.size_), capacity_(other.capacity_), data_(other.data_), allocator_(std::move(other.allocator_))
     {
         other.size_ = 0;
         other.capacity_ = 0;
         other.data_ = nullptr;
     }
 
+    // 指定分配器的移动构造：分配器不相等时 (如来自不同的 pmr 资源) 不能接管对方的内存，逐个移动元素
+    vector(vector && other, const allocator_type& alloc) : size_(0), capacity_(0), data_(nullptr), allocator_(alloc)
+    {
+        if (allocator_ == other.allocator_) {
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(data_, other.data_);
+        } else {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
     ~vector()
     {
         clear();
@@ -81,7 +113,7 @@ public:
         if (this != &other) {
             clear();
             if (capacity_ < other.capacity_) {
-                allocator_.deallocate(data_, capacity_);
+                if (data_) allocator_.deallocate(data_, capacity_);
                 capacity_ = other.capacity_;
                 data_ = allocator_.allocate(capacity_);
             }
@@ -93,12 +125,22 @@ public:
         return *this;
     }
 
-    // 移动赋值
-    vector& operator=(vector && other) noexcept
+    // 移动赋值。分配器不随移动赋值传播且与对方不相等时 (pmr)，对方的内存不能由本容器释放，逐个移动元素
+    vector& operator=(vector && other) noexcept(std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value ||
+                                                std::allocator_traits<allocator_type>::is_always_equal::value)
     {
         if (this != &other) {
+            if constexpr (!std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                if (!(allocator_ == other.allocator_)) {
+                    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    return *this;
+                }
+            }
             clear();
-            allocator_.deallocate(data_, capacity_);
+            if (data_) allocator_.deallocate(data_, capacity_);
+            if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                allocator_ = std::move(other.allocator_);
+            }
             capacity_ = other.capacity_;
             size_ = other.size_;
             data_ = other.data_;
@@ -109,6 +151,35 @@ public:
         return *this;
     }
 
+    // 与 std 一样，[first, last) 不能指向本容器。前向迭代器先求出元素个数，最多分配一次；
+    // 单遍的输入迭代器只能逐个追加
+    template <typename Iter, typename = std::enable_if_t<is_input_iterator<Iter>::value>>
+    void assign(Iter first, Iter last)
+    {
+        clear();
+        if constexpr (is_forward_iterator<Iter>::value) {
+            const size_type m = static_cast<size_type>(mystl::distance(first, last));
+            reserve(m);
+            mystl::uninitialized_copy_n(allocator_, first, m, data_);
+            size_ = m;
+        } else {
+            for (; first != last; ++first) emplace_back(*first);
+        }
+    }
+
+    void assign(size_type n, const value_type& value)
+    {
+        value_type tmp(value);  // value 可能是本容器中的元素
+        clear();
+        reserve(n);
+        mystl::uninitialized_fill_n(allocator_, data_, n, tmp);
+        size_ = n;
+    }
+
+    void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    allocator_type get_allocator() const { return allocator_; }
+
     // ========== 元素访问 ==========
     reference at(size_type pos)
     {
@@ -138,11 +209,14 @@ public:
     void reserve(size_type n)
     {
         if (n <= capacity_) return;
-        pointer new_data = allocator_.allocate(n);
-        for (size_type i = 0; i < size_; ++i){
-            std::allocator_traits<allocator_type>::construct(allocator_, new_data + i, std::move_if_noexcept(data_[i]));
-            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+        n = detail::round_up_capacity<Alloc>(n);
+        if constexpr (detail::has_reallocate<allocator_type>::value && is_trivially_relocatable<value_type>::value) {
+            data_ = allocator_.reallocate(data_, capacity_, n);
+            capacity_ = n;
+            return;
         }
+        pointer new_data = allocator_.allocate(n);
+        mystl::uninitialized_relocate_n(allocator_, data_, size_, new_data);
         if(data_) allocator_.deallocate(data_, capacity_);
         capacity_ = n;
         data_ = new_data;
@@ -150,14 +224,17 @@ public:
 
     void shrink_to_fit()
     {
-        if (size_ == capacity_) return;
-        pointer new_data = allocator_.allocate(size_);
-        for (size_type i = 0; i < size_; ++i) {
-            std::allocator_traits<allocator_type>::construct(allocator_, new_data + i, std::move_if_noexcept(data_[i]));
-            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+        const size_type n = detail::round_up_capacity<Alloc>(size_);
+        if (n == capacity_) return;
+        if constexpr (detail::has_reallocate<allocator_type>::value && is_trivially_relocatable<value_type>::value) {
+            data_ = allocator_.reallocate(data_, capacity_, n);
+            capacity_ = n;
+            return;
         }
+        pointer new_data = allocator_.allocate(n);
+        mystl::uninitialized_relocate_n(allocator_, data_, size_, new_data);
         allocator_.deallocate(data_, capacity_);
-        capacity_ = size_;
+        capacity_ = n;
         data_ = new_data;
     }
 
@@ -171,6 +248,31 @@ public:
         size_ = n;
     }
 
+    // 与 resize 相同，但新增的元素只做默认初始化：char、int、POD 结构体等不写任何值，
+    // 由调用者随后直接写入 data()，例如 read(fd, v.data(), n)。扩容按 Growth 放大，反复调用是均摊 O(1) 的
+    void resize_for_overwrite(size_type n)
+    {
+        if (n > capacity_) reserve(std::max(Growth::next_capacity(capacity_, sizeof(value_type)), n));
+        if constexpr (!std::is_trivially_default_constructible<value_type>::value) {
+            for (size_type i = size_; i < n; ++i)
+                ::new (static_cast<void*>(data_ + i)) value_type;
+        }
+        for (size_type i = n; i < size_; ++i)
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+        size_ = n;
+    }
+
+    // 扩容到至少 n 个元素，调用 op(data(), n) 写入内容，op 返回最终的元素个数 (不超过 n)。
+    // 调用 op 时 [size(), n) 未初始化，只能用于可平凡默认构造和析构的类型；op 抛出异常时 size() 不变
+    template <typename Op>
+    void resize_and_overwrite(size_type n, Op op)
+    {
+        static_assert(std::is_trivially_default_constructible<value_type>::value && std::is_trivially_destructible<value_type>::value,
+                      "resize_and_overwrite requires a trivial element type");
+        if (n > capacity_) reserve(std::max(Growth::next_capacity(capacity_, sizeof(value_type)), n));
+        size_ = static_cast<size_type>(std::move(op)(data_, n));
+    }
+
     size_type size() const { return size_; }
     size_type capacity() const { return capacity_; }
     bool empty() const { return size_ == 0 ? true : false; }
@@ -181,11 +283,84 @@ private:
     template<typename... Args>
     void construct_at_back(Args&&... args)
     {
-        if (size_ == capacity_) grow();
+        if (size_ == capacity_) {
+            // args 可能引用本容器中的元素 (v.push_back(v[0]))，扩容会搬走它，先构造出临时对象
+            value_type tmp(std::forward<Args>(args)...);
+            grow();
+            std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_, std::move(tmp));
+            ++size_;
+            return;
+        }
         std::allocator_traits<allocator_type>::construct(allocator_, data_ + size_++, std::forward<Args>(args)...);
     }
 
-    void grow() { reserve(capacity_ == 0 ? 1 : capacity_ * 2); }
+    void grow() { reserve(Growth::next_capacity(capacity_, sizeof(value_type))); }
+
+    // 把 [pos, size_) 整体后移 m 个位置，要求容量足够，不改变 size_
+    void open_gap(size_type pos, size_type m)
+    {
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            mystl::relocate_overlapping_n(data_ + pos, size_ - pos, data_ + pos + m);
+        } else {
+            for (size_type i = size_; i > pos; --i) {
+                std::allocator_traits<allocator_type>::construct(allocator_, data_ + i - 1 + m, std::move_if_noexcept(data_[i - 1]));
+                std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i - 1);
+            }
+        }
+    }
+
+    // open_gap 的逆操作，插入失败时把尾部搬回原位
+    void close_gap(size_type pos, size_type m)
+    {
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            mystl::relocate_overlapping_n(data_ + pos + m, size_ - pos, data_ + pos);
+        } else {
+            for (size_type i = pos; i < size_; ++i) {
+                std::allocator_traits<allocator_type>::construct(allocator_, data_ + i, std::move_if_noexcept(data_[i + m]));
+                std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i + m);
+            }
+        }
+    }
+
+    // 在 pos 处插入 m 个元素，fill(dest) 在未初始化的 dest 上构造这 m 个元素（失败时自行析构已构造的部分）。
+    // 最终大小只算一次，最多扩容一次，尾部只搬动一次。
+    // 需要扩容时直接把新元素构造到新缓冲区，前后两段各搬一次；
+    // 分配器能 reallocate 时先原地扩容，再与不扩容的情况一样后移尾部
+    template <typename Fill>
+    void insert_n(size_type pos, size_type m, Fill fill)
+    {
+        if (m == 0) return;
+        if (size_ + m > capacity_) {
+            const size_type new_capacity =
+                detail::round_up_capacity<Alloc>(std::max(Growth::next_capacity(capacity_, sizeof(value_type)), size_ + m));
+            if constexpr (detail::has_reallocate<allocator_type>::value && is_trivially_relocatable<value_type>::value) {
+                reserve(new_capacity);
+            } else {
+                pointer new_data = allocator_.allocate(new_capacity);
+                try {
+                    fill(new_data + pos);
+                } catch (...) {
+                    allocator_.deallocate(new_data, new_capacity);
+                    throw;
+                }
+                mystl::uninitialized_relocate_n(allocator_, data_, pos, new_data);
+                mystl::uninitialized_relocate_n(allocator_, data_ + pos, size_ - pos, new_data + pos + m);
+                if (data_) allocator_.deallocate(data_, capacity_);
+                data_ = new_data;
+                capacity_ = new_capacity;
+                size_ += m;
+                return;
+            }
+        }
+        open_gap(pos, m);
+        try {
+            fill(data_ + pos);
+        } catch (...) {
+            close_gap(pos, m);
+            throw;
+        }
+        size_ += m;
+    }
 
 public:
     // 添加一个数据
@@ -197,10 +372,34 @@ public:
     template<typename... Args>
     void emplace_back(Args&&... args) { construct_at_back(std::forward<Args>(args)...); }
 
-    template<typename... Args>
+    // 在 pos 处用 args 构造一个元素
+    template<typename... Args, typename = std::enable_if_t<std::is_constructible<value_type, Args&&...>::value>>
     void insert(size_type pos, Args&&... args) 
     {
         if (pos > size_) return;
+
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            // 先在临时空间构造新元素（args 可能引用本容器中的元素，扩容前构造才安全），
+            // 再整体 memmove 后移、把新元素按字节搬进空位
+            alignas(value_type) unsigned char buf[sizeof(value_type)];
+            pointer tmp = reinterpret_cast<pointer>(buf);
+            std::allocator_traits<allocator_type>::construct(allocator_, tmp, std::forward<Args>(args)...);
+            if (size_ == capacity_) {
+                try {
+                    grow();
+                } catch (...) {
+                    std::allocator_traits<allocator_type>::destroy(allocator_, tmp);
+                    throw;
+                }
+            }
+            mystl::relocate_overlapping_n(data_ + pos, size_ - pos, data_ + pos + 1);
+            mystl::uninitialized_relocate_n(allocator_, tmp, 1, data_ + pos);
+            ++size_;
+            return;
+        }
+
+        // 同上，扩容和后移都可能改动 args 引用的元素，先构造出临时对象
+        value_type tmp(std::forward<Args>(args)...);
         if (size_ == capacity_) grow();
 
         for (size_type i = size_; i > pos; --i){
@@ -208,14 +407,51 @@ public:
             std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i - 1);
         }
 
-        std::allocator_traits<allocator_type>::construct(allocator_, data_ + pos, std::forward<Args>(args)...);
+        std::allocator_traits<allocator_type>::construct(allocator_, data_ + pos, std::move(tmp));
         ++size_;
     }
 
+    // 在 pos 处插入 [first, last)，要求同 assign
+    template <typename Iter, typename = std::enable_if_t<is_input_iterator<Iter>::value>>
+    void insert(size_type pos, Iter first, Iter last)
+    {
+        if (pos > size_) return;
+        if constexpr (is_forward_iterator<Iter>::value) {
+            const size_type m = static_cast<size_type>(mystl::distance(first, last));
+            insert_n(pos, m, [&](pointer dest) { mystl::uninitialized_copy_n(allocator_, first, m, dest); });
+        } else if (pos == size_) {
+            for (; first != last; ++first) emplace_back(*first);
+        } else {
+            // 不知道个数，先读到临时 vector 中再整体插入
+            vector tmp(first, last);
+            insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+        }
+    }
+
+    // 在 pos 处插入 n 个 value
+    void insert(size_type pos, size_type n, const value_type& value)
+    {
+        if (pos > size_) return;
+        value_type tmp(value);  // value 可能是本容器中的元素
+        insert_n(pos, n, [&](pointer dest) { mystl::uninitialized_fill_n(allocator_, dest, n, tmp); });
+    }
+
+    void insert(size_type pos, std::initializer_list<value_type> ilist) { insert(pos, ilist.begin(), ilist.end()); }
+
+    // 在末尾追加一个区间（能用 std::begin / std::end 遍历的对象）
+    template <typename Range>
+    void append_range(Range&& rg) { insert(size_, std::begin(rg), std::end(rg)); }
+
     // 删除一个数据
     void erase(size_type pos)
     {
         if (pos >= size_) return;
+        if constexpr (is_trivially_relocatable<value_type>::value) {
+            std::allocator_traits<allocator_type>::destroy(allocator_, data_ + pos);
+            mystl::relocate_overlapping_n(data_ + pos + 1, size_ - pos - 1, data_ + pos);
+            --size_;
+            return;
+        }
         if (pos + 1 < size_) {
             std::move(data_ + pos + 1, data_ + size_, data_ + pos);
         }
@@ -239,4 +475,14 @@ public:
 
 };
 
+// 只保存指向堆内存的指针
+template <typename Tp, typename Alloc, typename Growth>
+struct is_trivially_relocatable<vector<Tp, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
+namespace pmr
+{
+template <typename Tp>
+using vector = mystl::vector<Tp, polymorphic_allocator<Tp>>;
+} // namespace pmr
+
 } // namespace mystl
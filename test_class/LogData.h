@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// 字符串匹配各个 benchmark 共用的测试数据：模拟的服务日志和要查找的签名。
+// 种子固定，同样的参数每次生成的内容相同
+
+// 用 rng 生成一行日志追加到 log 末尾。Str 需要 append(const char*, n)，std::string 和 mystl::string 都可以
+template <typename Str>
+void append_log_line(Str& log, std::mt19937_64& rng)
+{
+    static const char* levels[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    static const char* paths[] = {"/api/v1/users", "/api/v1/orders", "/api/v2/search", "/static/app.js", "/healthz"};
+    char buf[256];
+    uint64_t r = rng();
+    int n = std::snprintf(buf, sizeof(buf),
+                          "2024-05-%02d %02d:%02d:%02d.%03d [%s] worker-%02d req=%016llx path=%s/%d status=%d latency=%dms\n",
+                          int(r % 28 + 1), int(r >> 8) % 24, int(r >> 16) % 60, int(r >> 24) % 60, int(r >> 32) % 1000,
+                          levels[(r >> 40) % 4], int(r >> 44) % 32, static_cast<unsigned long long>(rng()),
+                          paths[(r >> 50) % 5], int(r >> 20) % 10000, (r >> 54) % 8 ? 200 : 503, int(r >> 12) % 900);
+    log.append(buf, static_cast<size_t>(n));
+}
+
+// 不少于 bytes 字节的日志，以完整的一行结束
+template <typename Str = std::string>
+Str make_log(size_t bytes)
+{
+    std::mt19937_64 rng(7);
+    Str log;
+    log.reserve(bytes + 256);
+    while (log.size() < bytes) append_log_line(log, rng);
+    return log;
+}
+
+// lines 行日志，line_starts 依次记录每行的起点，最后再记录总长度
+inline std::string make_log_lines(size_t lines, std::vector<size_t>& line_starts)
+{
+    std::mt19937_64 rng(7);
+    std::string log;
+    for (size_t i = 0; i < lines; ++i) {
+        line_starts.push_back(log.size());
+        append_log_line(log, rng);
+    }
+    line_starts.push_back(log.size());
+    return log;
+}
+
+// 错误签名用的词，签名形如 "deadlock-12345678"
+inline const char* const k_error_words[] = {"timeout", "refused", "panic", "deadlock", "overflow", "oom-killer", "segfault",
+                                           "retrying", "circuit-open", "throttled", "corrupt", "checksum"};
+
+// count 个签名: 前 5 个在日志里经常出现，其余是很少出现的错误签名
+inline std::vector<std::string> make_signatures(size_t count)
+{
+    std::vector<std::string> sigs = {"status=503", "[ERROR]", "path=/healthz/", "worker-07 req=", "latency=8"};
+    std::mt19937_64 rng(11);
+    while (sigs.size() < count) {
+        uint64_t id = rng() % 100000000;  // 先取编号再取词，与各个笔记里记录的结果保持一致
+        sigs.push_back(std::string(k_error_words[rng() % 12]) + "-" + std::to_string(id));
+    }
+    return sigs;
+}
+
+// count 个签名: 前 38 个在日志里经常出现 (worker 编号、状态码、级别、路径)，
+// 其余是很少出现的错误签名，一半带 " code=NNN" 后缀
+inline std::vector<std::string> make_signatures(size_t count, uint64_t seed)
+{
+    std::vector<std::string> sigs;
+    char buf[64];
+    for (int w = 0; w < 32 && sigs.size() < count; ++w) {
+        std::snprintf(buf, sizeof(buf), "worker-%02d req=", w);
+        sigs.push_back(buf);
+    }
+    for (const char* s : {"status=503", "[ERROR]", "[WARN ]", "path=/healthz/", "path=/api/v2/search/", "latency=8"}) {
+        if (sigs.size() < count) sigs.push_back(s);
+    }
+    std::mt19937_64 rng(seed);
+    while (sigs.size() < count) {
+        std::string s = k_error_words[rng() % 12];
+        s += "-" + std::to_string(rng() % 100000000);
+        if (rng() % 2) s += " code=" + std::to_string(rng() % 1000);
+        sigs.push_back(s);
+    }
+    return sigs;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+
+// 简单的计时工具，供各个 benchmark 使用
+class Timer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    Timer() : start_(clock::now()) {}
+
+    void reset() { start_ = clock::now(); }
+
+    double elapsed_ms() const
+    {
+        return std::chrono::duration<double, std::milli>(clock::now() - start_).count();
+    }
+
+private:
+    clock::time_point start_;
+};
+
+// 重复运行 repeat 次，返回最快一次的耗时（毫秒）
+// prepare 在每次计时前调用，不计入耗时（例如重新拷贝一份待排序数据）
+template <typename Prepare, typename Func>
+double best_of_ms(int repeat, Prepare&& prepare, Func&& func)
+{
+    double best = 0;
+    for (int i = 0; i < repeat; ++i) {
+        prepare();
+        Timer t;
+        func();
+        double ms = t.elapsed_ms();
+        if (i == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+template <typename Func>
+double best_of_ms(int repeat, Func&& func)
+{
+    return best_of_ms(repeat, [] {}, func);
+}
+
+// 阻止编译器把结果优化掉
+template <typename Tp>
+inline void do_not_optimize(const Tp& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}